@@ -0,0 +1,86 @@
+// SPDX-License-Identifier: MIT
+// Copyright © 2022 Sebastian Larsson
+
+#include <load-gltf/load-gltf.hpp>
+
+#include "timing.hpp"
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace {
+	/**
+	 * Document with meshes of vertexCount positions each, all in one buffer, and a node for every mesh
+	 *
+	 * @param withBounds whether the POSITION accessors have min and max, so that the data need not be read
+	 */
+	std::string makeDocument(std::size_t meshCount, std::size_t vertexCount, bool withBounds)
+	{
+		std::size_t const meshBytes = vertexCount * 3 * sizeof(float);
+		std::string json = R"({"asset": {"version": "2.0"}, "buffers": [{"byteLength": )"
+			+ std::to_string(meshCount * meshBytes) + "}]";
+		std::string bufferViews = R"(, "bufferViews": [)";
+		std::string accessors = R"(, "accessors": [)";
+		std::string meshes = R"(, "meshes": [)";
+		std::string nodes = R"(, "nodes": [)";
+		for (std::size_t i = 0; i < meshCount; ++i)
+		{
+			std::string const separator = i == 0 ? "" : ",";
+			std::string const index = std::to_string(i);
+			bufferViews += separator + R"({"buffer": 0, "byteOffset": )" + std::to_string(i * meshBytes)
+				+ R"(, "byteLength": )" + std::to_string(meshBytes) + "}";
+			accessors += separator + R"({"bufferView": )" + index + R"(, "componentType": 5126, "type": "VEC3",)"
+				+ R"( "count": )" + std::to_string(vertexCount)
+				+ (withBounds ? R"(, "min": [-1, -1, -1], "max": [1, 1, 1]})" : "}");
+			meshes += separator + R"({"primitives": [{"attributes": {"POSITION": )" + index + "}}]}";
+			nodes += separator + R"({"mesh": )" + index + R"(, "translation": [)" + index + ", 0, 0]}";
+		}
+		return json + bufferViews + "]" + accessors + "]" + meshes + "]" + nodes + "]}";
+	}
+
+	void run(char const* name, lg::Gltf const& gltf, std::span<lg::BufferData const> buffers, bool parallel)
+	{
+		lg::BoundsOptions options;
+		options.parallel = parallel;
+		double const time = bestTime([&gltf, &buffers, &options]
+		{
+			lg::DocumentBounds const bounds = lg::computeBounds(gltf, buffers, options);
+		});
+		std::printf("%s, %s: %.2f ms\n", name, parallel ? "parallel" : "serial", time * 1e3);
+	}
+}
+
+/**
+ * Calculate the bounds of a document from position data, and from accessor bounds
+ *
+ * Usage: bench-bounds [mesh count, default 256] [vertices per mesh, default 65536]
+ */
+int main(int argc, char** argv)
+{
+	std::size_t const meshCount = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 256;
+	std::size_t const vertexCount = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 65536;
+
+	std::vector<float> positions(meshCount * vertexCount * 3);
+	for (std::size_t i = 0; i < positions.size(); ++i)
+	{
+		positions[i] = std::sin(static_cast<float>(i) * 0.37f);
+	}
+	std::array<lg::BufferData, 1> const buffers = {std::as_bytes(std::span(positions))};
+	std::printf("%zu meshes of %zu vertices, %.1f MB of positions\n", meshCount, vertexCount,
+		positions.size() * sizeof(float) / 1e6);
+
+	lg::Gltf const withoutBounds = lg::loadGltf(makeDocument(meshCount, vertexCount, false));
+	run("Position data", withoutBounds, buffers, false);
+	run("Position data", withoutBounds, buffers, true);
+
+	lg::Gltf const withBounds = lg::loadGltf(makeDocument(meshCount, vertexCount, true));
+	run("Accessor bounds", withBounds, buffers, false);
+	run("Accessor bounds", withBounds, buffers, true);
+}
@@ -0,0 +1,123 @@
+// SPDX-License-Identifier: MIT
+// Copyright © 2022 Sebastian Larsson
+
+#include <load-gltf/load-gltf.hpp>
+
+#include "timing.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+	/**
+	 * Document with nodeCount nodes scattered in a cube, all with the same mesh
+	 */
+	std::string makeDocument(std::size_t nodeCount)
+	{
+		std::mt19937 random(42);
+		std::uniform_real_distribution<double> coordinate(0.0, 1000.0);
+		std::string nodes;
+		for (std::size_t i = 0; i < nodeCount; ++i)
+		{
+			nodes += std::string(i == 0 ? "" : ",") + R"({"mesh": 0, "translation": [)"
+				+ std::to_string(coordinate(random)) + ", " + std::to_string(coordinate(random)) + ", "
+				+ std::to_string(coordinate(random)) + "]}";
+		}
+		return R"({"asset": {"version": "2.0"}, "meshes": [{"primitives": []}], "nodes": [)" + nodes + "]}";
+	}
+
+	void report(char const* name, double time, std::size_t count, char const* unit)
+	{
+		std::printf("%s: %.2f ms, %.0f %s/s\n", name, time * 1e3, count / time, unit);
+	}
+}
+
+/**
+ * Build, refit and query a hierarchy over scattered nodes
+ *
+ * Usage: bench-bvh [node count, default 100000] [query count, default 10000]
+ */
+int main(int argc, char** argv)
+{
+	std::size_t const nodeCount = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100000;
+	std::size_t const queryCount = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 10000;
+
+	lg::Gltf const gltf = lg::loadGltf(makeDocument(nodeCount));
+	std::vector<lg::Matrix4> worldTransforms = lg::computeWorldTransforms(gltf, lg::analyzeNodeHierarchy(gltf));
+	std::vector<lg::Bounds> meshBounds(1);
+	meshBounds[0].box.min = {-1, -1, -1};
+	meshBounds[0].box.max = {1, 1, 1};
+	meshBounds[0].sphere.radius = 1.8;
+	std::printf("%zu nodes, %zu queries\n", nodeCount, queryCount);
+
+	lg::SceneBvh bvh;
+	for (bool const parallel: {false, true})
+	{
+		lg::BvhOptions options;
+		options.parallel = parallel;
+		double const time = bestTime([&]
+		{
+			bvh = lg::buildSceneBvh(gltf, meshBounds, worldTransforms, options);
+		});
+		report(parallel ? "Build, parallel" : "Build, serial", time, nodeCount, "nodes");
+	}
+
+	for (lg::Matrix4& transform: worldTransforms)
+	{
+		transform[12] += 1.0;
+	}
+	report("Refit", bestTime([&]
+	{
+		lg::refitSceneBvh(bvh, gltf, meshBounds, worldTransforms);
+	}), nodeCount, "nodes");
+
+	std::mt19937 random(7);
+	std::uniform_real_distribution<double> coordinate(0.0, 1000.0);
+	std::uniform_real_distribution<double> unit(-1.0, 1.0);
+	std::vector<lg::Aabb> boxes(queryCount);
+	std::vector<lg::Ray> rays(queryCount);
+	for (std::size_t i = 0; i < queryCount; ++i)
+	{
+		for (std::size_t k = 0; k < 3; ++k)
+		{
+			boxes[i].min[k] = coordinate(random);
+			boxes[i].max[k] = boxes[i].min[k] + 20.0;
+			rays[i].origin[k] = coordinate(random);
+			rays[i].direction[k] = unit(random);
+		}
+	}
+
+	std::size_t found = 0;
+	report("Box queries", bestTime([&]
+	{
+		for (lg::Aabb const& box: boxes)
+		{
+			found += lg::findOverlapping(bvh, box).size();
+		}
+	}), queryCount, "queries");
+	report("Ray queries", bestTime([&]
+	{
+		for (lg::Ray const& ray: rays)
+		{
+			found += lg::intersectRay(bvh, ray).size();
+		}
+	}), queryCount, "queries");
+
+	// A frustum looking along z with a 90 degree field of view, from the middle of one side of the cube
+	lg::Frustum frustum;
+	frustum.planes = {{{1, 0, 1, -500}, {-1, 0, 1, 500}, {0, 1, 1, -500}, {0, -1, 1, 500}, {0, 0, 1, -1},
+		{0, 0, -1, 1000}}};
+	report("Frustum queries", bestTime([&]
+	{
+		for (std::size_t i = 0; i < 10; ++i)
+		{
+			found += lg::findInFrustum(bvh, frustum).size();
+		}
+	}), 10, "queries");
+	std::printf("%zu results\n", found);
+}
@@ -0,0 +1,86 @@
+// SPDX-License-Identifier: MIT
+// Copyright © 2022 Sebastian Larsson
+
+#include <load-gltf/load-gltf.hpp>
+
+#include "timing.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+
+namespace {
+	std::atomic<std::size_t> allocationCount = 0;
+
+	/**
+	 * Document with the given number of nodes, three quarters with translation, rotation and scale and the rest with a
+	 * matrix
+	 */
+	std::string makeDocument(std::size_t nodeCount)
+	{
+		std::string json = R"({"asset": {"version": "2.0"}, "nodes": [)";
+		for (std::size_t i = 0; i < nodeCount; ++i)
+		{
+			if (i != 0)
+			{
+				json += ',';
+			}
+			if (i % 4 == 3)
+			{
+				json += R"({"matrix": [1.5, 0, 0, 0, 0, 1.5, 0, 0, 0, 0, 1.5, 0, 12.25, -3.5, 7.125, 1]})";
+			}
+			else
+			{
+				json += R"({"translation": [12.25, -3.5, 7.125], "rotation": [0, 0.7071068, 0, 0.7071068],)"
+					R"( "scale": [1.5, 1.5, 1.5]})";
+			}
+		}
+		json += "]}";
+		return json;
+	}
+}
+
+void* operator new(std::size_t size)
+{
+	++allocationCount;
+	if (void* pointer = std::malloc(size == 0 ? 1 : size))
+	{
+		return pointer;
+	}
+	throw std::bad_alloc();
+}
+
+void operator delete(void* pointer) noexcept
+{
+	std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept
+{
+	std::free(pointer);
+}
+
+/**
+ * Load a document with many nodes, to measure fixed-size array parsing
+ *
+ * Usage: bench-load [node count, default 1000000]
+ */
+int main(int argc, char** argv)
+{
+	std::size_t const nodeCount = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+	std::string const json = makeDocument(nodeCount) + std::string(lg::paddingSize, ' ');
+	std::string_view const paddedJson(json.data(), json.size() - lg::paddingSize);
+
+	std::size_t allocations = 0;
+	double const time = bestTime([&paddedJson, &allocations]
+	{
+		std::size_t const before = allocationCount;
+		lg::Gltf const gltf = lg::loadGltfPrePadded(paddedJson);
+		allocations = allocationCount - before;
+	});
+	std::printf("%zu nodes, %.1f MB of JSON\n", nodeCount, paddedJson.size() / 1e6);
+	std::printf("loadGltf: %.1f ms, %zu heap allocations\n", time * 1e3, allocations);
+}
@@ -0,0 +1,224 @@
+// SPDX-License-Identifier: MIT
+// Copyright © 2022 Sebastian Larsson
+
+#include <load-gltf/load-gltf.hpp>
+
+#include "timing.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <span>
+#include <vector>
+
+namespace {
+	constexpr std::size_t byteGroupSize = 16;
+
+	std::uint8_t zigzag8(std::uint8_t value)
+	{
+		return static_cast<std::uint8_t>(((value & 0x80) ? 0xff : 0) ^ (value << 1));
+	}
+
+	/**
+	 * Number of bytes a group of 16 values takes with the given number of bits each, sentinels included
+	 */
+	std::size_t byteGroupEncodedSize(std::uint8_t const* values, int bits)
+	{
+		if (bits == 0)
+		{
+			return std::all_of(values, values + byteGroupSize, [](std::uint8_t value) { return value == 0; })
+				? 0 : SIZE_MAX;
+		}
+		if (bits == 8)
+		{
+			return byteGroupSize;
+		}
+		std::size_t const sentinel = (1u << bits) - 1;
+		auto const isExtra = [sentinel](std::uint8_t value) { return value >= sentinel; };
+		return bits * byteGroupSize / 8 + std::count_if(values, values + byteGroupSize, isExtra);
+	}
+
+	void encodeByteGroup(std::vector<std::uint8_t>& out, std::uint8_t const* values, int bits)
+	{
+		if (bits == 0)
+		{
+			return;
+		}
+		if (bits == 8)
+		{
+			out.insert(out.end(), values, values + byteGroupSize);
+			return;
+		}
+		std::size_t const packed = out.size();
+		out.resize(out.size() + bits * byteGroupSize / 8);
+		std::uint8_t const sentinel = static_cast<std::uint8_t>((1u << bits) - 1);
+		for (std::size_t i = 0; i < byteGroupSize; ++i)
+		{
+			std::size_t const bit = i * bits;
+			std::uint8_t const value = std::min(values[i], sentinel);
+			out[packed + bit / 8] |= static_cast<std::uint8_t>(value << (8 - bits - bit % 8));
+		}
+		for (std::size_t i = 0; i < byteGroupSize; ++i)
+		{
+			if (values[i] >= sentinel)
+			{
+				out.push_back(values[i]);
+			}
+		}
+	}
+
+	/**
+	 * Compress vertices in ATTRIBUTES mode, picking the smallest of the four bit widths for every byte group
+	 */
+	std::vector<std::uint8_t> encodeAttributes(std::span<std::uint8_t const> vertices, std::size_t stride)
+	{
+		std::size_t const count = vertices.size() / stride;
+		std::size_t const blockSize = std::min<std::size_t>(8192 / stride & ~(byteGroupSize - 1), 256);
+		std::vector<std::uint8_t> out = {0xa0};
+		std::vector<std::uint8_t> lastVertex(vertices.begin(), vertices.begin() + stride);
+		std::vector<std::uint8_t> deltas;
+		for (std::size_t offset = 0; offset < count; offset += blockSize)
+		{
+			std::size_t const blockCount = std::min(blockSize, count - offset);
+			std::size_t const groupCount = (blockCount + byteGroupSize - 1) / byteGroupSize;
+			for (std::size_t k = 0; k < stride; ++k)
+			{
+				deltas.assign(groupCount * byteGroupSize, 0);
+				std::uint8_t previous = lastVertex[k];
+				for (std::size_t i = 0; i < blockCount; ++i)
+				{
+					std::uint8_t const value = vertices[(offset + i) * stride + k];
+					deltas[i] = zigzag8(static_cast<std::uint8_t>(value - previous));
+					previous = value;
+				}
+
+				std::size_t const header = out.size();
+				out.resize(out.size() + (groupCount + 3) / 4);
+				for (std::size_t group = 0; group < groupCount; ++group)
+				{
+					std::uint8_t const* values = deltas.data() + group * byteGroupSize;
+					int bitsLog2 = 0;
+					for (int candidate = 1; candidate < 4; ++candidate)
+					{
+						if (byteGroupEncodedSize(values, 1 << candidate)
+							< byteGroupEncodedSize(values, bitsLog2 == 0 ? 0 : 1 << bitsLog2))
+						{
+							bitsLog2 = candidate;
+						}
+					}
+					out[header + group / 4] |= static_cast<std::uint8_t>(bitsLog2 << (group % 4 * 2));
+					encodeByteGroup(out, values, bitsLog2 == 0 ? 0 : 1 << bitsLog2);
+				}
+			}
+			std::memcpy(lastVertex.data(), vertices.data() + (offset + blockCount - 1) * stride, stride);
+		}
+
+		// The tail ends with the vertex the first block is delta encoded against
+		out.resize(out.size() + std::max<std::size_t>(stride, 32) - stride);
+		out.insert(out.end(), vertices.begin(), vertices.begin() + stride);
+		return out;
+	}
+
+	/**
+	 * Compress an index sequence in INDICES mode, as deltas to the previous index
+	 */
+	std::vector<std::uint8_t> encodeSequence(std::span<std::uint32_t const> indices)
+	{
+		std::vector<std::uint8_t> out = {0xd1};
+		std::uint32_t last = 0;
+		for (std::uint32_t const index: indices)
+		{
+			std::uint32_t const delta = index - last;
+			std::uint32_t value = ((delta << 1) ^ (0u - (delta >> 31))) << 1;
+			last = index;
+			do
+			{
+				out.push_back(static_cast<std::uint8_t>((value & 127) | (value > 127 ? 128 : 0)));
+				value >>= 7;
+			} while (value != 0);
+		}
+		out.resize(out.size() + 4);
+		return out;
+	}
+
+	/**
+	 * Vertices of a wavy grid, with 16 bit positions, 8 bit normals and 16 bit texture coordinates
+	 */
+	std::vector<std::uint8_t> makeVertices(std::size_t count, std::size_t stride)
+	{
+		std::vector<std::uint8_t> vertices(count * stride);
+		std::size_t const width = 1024;
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			float const x = static_cast<float>(i % width);
+			float const y = static_cast<float>(i / width);
+			std::uint16_t const values[] = {static_cast<std::uint16_t>(x * 64),
+				static_cast<std::uint16_t>(32768 + 4096 * std::sin(x * 0.05f) * std::cos(y * 0.05f)),
+				static_cast<std::uint16_t>(y * 64), 0};
+			std::int8_t const normal[] = {static_cast<std::int8_t>(127 * std::cos(x * 0.05f)),
+				static_cast<std::int8_t>(127 * std::sin(y * 0.05f)), 90, 0};
+			std::uint16_t const texCoords[] = {static_cast<std::uint16_t>(x * 63), static_cast<std::uint16_t>(y * 63)};
+			std::uint8_t* vertex = vertices.data() + i * stride;
+			std::memcpy(vertex, values, sizeof(values));
+			std::memcpy(vertex + 8, normal, sizeof(normal));
+			std::memcpy(vertex + 12, texCoords, sizeof(texCoords));
+		}
+		return vertices;
+	}
+
+	void report(char const* mode, std::size_t encodedSize, std::size_t decodedSize, double time)
+	{
+		std::printf("%s: %.1f MB to %.1f MB, %.2f ms, %.0f MB/s decoded\n", mode, encodedSize / 1e6, decodedSize / 1e6,
+			time * 1e3, decodedSize / time / 1e6);
+	}
+}
+
+/**
+ * Decode vertex attributes and an index sequence compressed with EXT_meshopt_compression
+ *
+ * Usage: bench-meshopt [vertex count, default 1048576]
+ */
+int main(int argc, char** argv)
+{
+	std::size_t const count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1048576;
+	constexpr std::size_t stride = 16;
+
+	std::vector<std::uint8_t> const vertices = makeVertices(count, stride);
+	std::vector<std::uint8_t> const encodedVertices = encodeAttributes(vertices, stride);
+	std::vector<std::uint8_t> decodedVertices(vertices.size());
+	double const attributeTime = bestTime([&]
+	{
+		lg::decodeMeshopt(std::as_writable_bytes(std::span(decodedVertices)), static_cast<std::uint32_t>(count),
+			stride, "ATTRIBUTES", "NONE", std::as_bytes(std::span(encodedVertices)));
+	});
+	if (decodedVertices != vertices)
+	{
+		std::fprintf(stderr, "Attribute round trip failed\n");
+		return EXIT_FAILURE;
+	}
+	report("ATTRIBUTES", encodedVertices.size(), vertices.size(), attributeTime);
+
+	// Indices alternating between two consecutive runs, as in a strip between two rows of a grid
+	std::vector<std::uint32_t> indices(count * 2);
+	for (std::size_t i = 0; i < indices.size(); ++i)
+	{
+		indices[i] = static_cast<std::uint32_t>(i / 2 + (i % 2) * 1024);
+	}
+	std::vector<std::uint8_t> const encodedIndices = encodeSequence(indices);
+	std::vector<std::uint32_t> decodedIndices(indices.size());
+	double const indexTime = bestTime([&]
+	{
+		lg::decodeMeshopt(std::as_writable_bytes(std::span(decodedIndices)),
+			static_cast<std::uint32_t>(indices.size()), 4, "INDICES", "NONE", std::as_bytes(std::span(encodedIndices)));
+	});
+	if (decodedIndices != indices)
+	{
+		std::fprintf(stderr, "Index round trip failed\n");
+		return EXIT_FAILURE;
+	}
+	report("INDICES", encodedIndices.size(), indices.size() * sizeof(std::uint32_t), indexTime);
+}
@@ -0,0 +1,69 @@
+// SPDX-License-Identifier: MIT
+// Copyright © 2022 Sebastian Larsson
+
+#include <load-gltf/load-gltf.hpp>
+
+#include "timing.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace {
+	/**
+	 * Triangle list of a square grid of quads, with its triangles shuffled so that the input has no locality
+	 */
+	std::vector<std::uint32_t> makeGrid(std::uint32_t size)
+	{
+		std::vector<std::uint32_t> indices;
+		indices.reserve(std::size_t{size} * size * 6);
+		for (std::uint32_t y = 0; y < size; ++y)
+		{
+			for (std::uint32_t x = 0; x < size; ++x)
+			{
+				std::uint32_t const corner = y * (size + 1) + x;
+				indices.insert(indices.end(), {corner, corner + 1, corner + size + 1,
+					corner + 1, corner + size + 2, corner + size + 1});
+			}
+		}
+
+		std::mt19937 random(42);
+		std::size_t const triangleCount = indices.size() / 3;
+		for (std::size_t i = triangleCount - 1; i > 0; --i)
+		{
+			std::size_t const j = std::uniform_int_distribution<std::size_t>(0, i)(random);
+			for (std::size_t k = 0; k < 3; ++k)
+			{
+				std::swap(indices[3 * i + k], indices[3 * j + k]);
+			}
+		}
+		return indices;
+	}
+}
+
+/**
+ * Optimize a shuffled grid for the vertex cache, reporting the cache miss ratios and the throughput
+ *
+ * Usage: bench-optimize [grid size in quads, default 1000]
+ */
+int main(int argc, char** argv)
+{
+	std::uint32_t const size = argc > 1 ? static_cast<std::uint32_t>(std::strtoul(argv[1], nullptr, 10)) : 1000;
+	std::uint32_t const vertexCount = (size + 1) * (size + 1);
+	std::vector<std::uint32_t> const indices = makeGrid(size);
+	std::size_t const triangleCount = indices.size() / 3;
+
+	std::vector<std::uint32_t> optimized;
+	double const time = bestTime([&indices, &optimized, vertexCount]
+	{
+		optimized = lg::optimizeVertexCache(indices, vertexCount, 16);
+	});
+	std::printf("%zu triangles, %u vertices\n", triangleCount, vertexCount);
+	std::printf("ACMR: %.3f before, %.3f after\n", lg::computeAcmr(indices, vertexCount, 16),
+		lg::computeAcmr(optimized, vertexCount, 16));
+	std::printf("optimizeVertexCache: %.1f ms, %.1f M triangles/s\n", time * 1e3, triangleCount / time / 1e6);
+}
@@ -0,0 +1,91 @@
+// SPDX-License-Identifier: MIT
+// Copyright © 2022 Sebastian Larsson
+
+#include <load-gltf/load-gltf.hpp>
+
+#include "timing.hpp"
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace {
+	void run(std::vector<float> const& positions, std::vector<float> const& normals,
+		std::vector<std::uint32_t> const& joints, std::vector<float> const& weights,
+		std::vector<lg::Matrix4> const& jointMatrices, bool parallel)
+	{
+		lg::DeformOptions options;
+		options.parallel = parallel;
+		double const time = bestTime([&]
+		{
+			lg::SkinnedVertices const skinned = lg::skinVertices(positions, normals, joints, weights, jointMatrices,
+				options);
+		});
+		double const vertexCount = static_cast<double>(positions.size() / 3);
+		std::printf("%s, %s: %.2f ms, %.1f M vertices/s\n", normals.empty() ? "Positions" : "Positions and normals",
+			parallel ? "parallel" : "serial", time * 1e3, vertexCount / time / 1e6);
+	}
+}
+
+/**
+ * Skin random vertices influenced by four random joints each
+ *
+ * Usage: bench-skin [vertex count, default 1000000] [joint count, default 64]
+ */
+int main(int argc, char** argv)
+{
+	std::size_t const vertexCount = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+	std::size_t const jointCount = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 64;
+
+	std::mt19937 random(42);
+	std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+	std::uniform_int_distribution<std::uint32_t> joint(0, static_cast<std::uint32_t>(jointCount - 1));
+
+	std::vector<lg::Matrix4> jointMatrices(jointCount);
+	for (lg::Matrix4& matrix: jointMatrices)
+	{
+		// Random non-uniform scale and shear, with a translation
+		for (std::size_t column = 0; column < 4; ++column)
+		{
+			for (std::size_t row = 0; row < 3; ++row)
+			{
+				matrix[column * 4 + row] = (column == row ? 1.0 : 0.0) + 0.5 * unit(random);
+			}
+		}
+		matrix[15] = 1.0;
+	}
+
+	std::vector<float> positions(vertexCount * 3);
+	std::vector<float> normals(vertexCount * 3);
+	for (std::size_t i = 0; i < positions.size(); ++i)
+	{
+		positions[i] = unit(random);
+		normals[i] = unit(random);
+	}
+	std::vector<std::uint32_t> joints(vertexCount * 4);
+	std::vector<float> weights(vertexCount * 4);
+	for (std::size_t i = 0; i < vertexCount; ++i)
+	{
+		float total = 0.0f;
+		for (std::size_t k = 0; k < 4; ++k)
+		{
+			joints[i * 4 + k] = joint(random);
+			weights[i * 4 + k] = std::abs(unit(random));
+			total += weights[i * 4 + k];
+		}
+		for (std::size_t k = 0; k < 4; ++k)
+		{
+			weights[i * 4 + k] /= total;
+		}
+	}
+	std::printf("%zu vertices, %zu joints\n", vertexCount, jointCount);
+
+	run(positions, {}, joints, weights, jointMatrices, false);
+	run(positions, {}, joints, weights, jointMatrices, true);
+	run(positions, normals, joints, weights, jointMatrices, false);
+	run(positions, normals, joints, weights, jointMatrices, true);
+}
@@ -0,0 +1,32 @@
+// SPDX-License-Identifier: MIT
+// Copyright © 2022 Sebastian Larsson
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+
+/**
+ * Number of times every benchmark is run, of which the fastest run is reported
+ */
+constexpr int benchmarkRuns = 5;
+
+/**
+ * Run a function benchmarkRuns times
+ *
+ * @return the shortest run time, in seconds
+ */
+template<typename Function>
+double bestTime(Function&& function)
+{
+	double best = std::numeric_limits<double>::infinity();
+	for (int run = 0; run < benchmarkRuns; ++run)
+	{
+		auto const start = std::chrono::steady_clock::now();
+		function();
+		std::chrono::duration<double> const time = std::chrono::steady_clock::now() - start;
+		best = std::min(best, time.count());
+	}
+	return best;
+}
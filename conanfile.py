@@ -23,7 +23,7 @@ class LoadGltfConan(ConanFile):
 
     exports_sources = "CMakeLists.txt", "src/*", "include/*"
 
-    requires = "spdlog/1.10.0", "simdjson/2.2.3"
+    requires = "spdlog/1.10.0", "simdjson/3.10.1"
 
     def validate(self):
         check_min_cppstd(self, 20)
@@ -47,7 +47,7 @@ class LoadGltfConan(ConanFile):
 
     def build(self):
         cmake = CMake(self)
-        cmake.configure()
+        cmake.configure(variables={"LOAD_GLTF_BUILD_TESTS": "OFF"})
         cmake.build()
 
     def package(self):
@@ -0,0 +1,87 @@
+// SPDX-License-Identifier: MIT
+// Copyright © 2022 Sebastian Larsson
+
+#pragma once
+
+#include <load-gltf/defs.hpp>
+#include <load-gltf/structs.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace lg {
+	/**
+	 * Binary contents of a buffer
+	 *
+	 * Functions reading accessors take the contents of every buffer of the document, in the same order as
+	 * Gltf::buffers. Loading them, e.g. from files or data URIs, is left to the caller.
+	 */
+	using BufferData = std::span<std::byte const>;
+
+	/**
+	 * @return the size in bytes of a component type, or 0 if unknown
+	 */
+	LG_EXPORT std::uint32_t componentSize(std::uint32_t componentType) noexcept;
+
+	/**
+	 * @return the number of components of an accessor type, e.g. 3 for "VEC3", or 0 if unknown
+	 */
+	LG_EXPORT std::uint32_t componentCount(std::string_view type) noexcept;
+
+	/**
+	 * @return the size in bytes of an accessor element, including padding between matrix columns, or 0 if unknown
+	 */
+	LG_EXPORT std::uint32_t elementSize(std::string_view type, std::uint32_t componentType) noexcept;
+
+	/**
+	 * Read the elements of an accessor, tightly packed in their stored format
+	 *
+	 * Sparse values are applied, and accessors without a buffer view are zero-initialized, as per the specification.
+	 *
+	 * @throws std::out_of_range if the accessor, or any data it references, is out of range
+	 * @throws std::invalid_argument if the accessor type or component type is unknown
+	 */
+	LG_EXPORT std::vector<std::byte> readAccessorData(Gltf const& gltf, std::span<BufferData const> buffers,
+		std::uint32_t accessor);
+
+	LG_EXPORT std::vector<std::byte> readAccessorData(BorrowedGltf const& gltf, std::span<BufferData const> buffers,
+		std::uint32_t accessor);
+
+	LG_EXPORT std::vector<std::byte> readAccessorData(FloatGltf const& gltf, std::span<BufferData const> buffers,
+		std::uint32_t accessor);
+
+	/**
+	 * Read the components of an accessor converted to float
+	 *
+	 * Normalized integers are mapped to [0, 1] or [-1, 1]. Matrix column padding is removed, so every element is
+	 * componentCount(type) floats.
+	 *
+	 * @throws the same as readAccessorData
+	 */
+	LG_EXPORT std::vector<float> readAccessorFloats(Gltf const& gltf, std::span<BufferData const> buffers,
+		std::uint32_t accessor);
+
+	LG_EXPORT std::vector<float> readAccessorFloats(BorrowedGltf const& gltf, std::span<BufferData const> buffers,
+		std::uint32_t accessor);
+
+	LG_EXPORT std::vector<float> readAccessorFloats(FloatGltf const& gltf, std::span<BufferData const> buffers,
+		std::uint32_t accessor);
+
+	/**
+	 * Read the components of an unsigned integer accessor, such as indices or joints, widened to 32 bits
+	 *
+	 * @throws std::invalid_argument if the component type is not an unsigned integer type
+	 * @throws the same as readAccessorData
+	 */
+	LG_EXPORT std::vector<std::uint32_t> readAccessorUints(Gltf const& gltf, std::span<BufferData const> buffers,
+		std::uint32_t accessor);
+
+	LG_EXPORT std::vector<std::uint32_t> readAccessorUints(BorrowedGltf const& gltf,
+		std::span<BufferData const> buffers, std::uint32_t accessor);
+
+	LG_EXPORT std::vector<std::uint32_t> readAccessorUints(FloatGltf const& gltf,
+		std::span<BufferData const> buffers, std::uint32_t accessor);
+}
@@ -0,0 +1,99 @@
+// SPDX-License-Identifier: MIT
+// Copyright © 2022 Sebastian Larsson
+
+#pragma once
+
+#include <load-gltf/defs.hpp>
+#include <load-gltf/hierarchy.hpp>
+#include <load-gltf/structs.hpp>
+#include <load-gltf/transform.hpp>
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace lg {
+	/**
+	 * Single precision 4x4 matrix in column-major order, ready to be uploaded as per-instance data
+	 */
+	using InstanceTransform = std::array<float, 16>;
+
+	/**
+	 * A primitive drawn once for every instance of its mesh
+	 */
+	struct LG_EXPORT DrawBatch
+	{
+		/// Material of the primitive, noIndex for the default material
+		std::uint32_t material = noIndex;
+		std::uint32_t mesh = {};
+		/// Index of the primitive in the mesh
+		std::uint32_t primitive = {};
+		/// First of the instances of the mesh in DrawBatches::instanceNodes and DrawBatches::instanceTransforms
+		std::uint32_t firstInstance = {};
+		std::uint32_t instanceCount = {};
+	};
+
+	/**
+	 * Draw list of a scene, with the instances of every mesh stored contiguously
+	 *
+	 * The batches of the primitives of a mesh share the instance range of the mesh.
+	 */
+	struct LG_EXPORT DrawBatches
+	{
+		/// Batches sorted by material, then mesh and primitive, to minimise state changes
+		std::vector<DrawBatch> batches;
+		/// Node of every instance, grouped by mesh in ascending mesh order, and in node order within a mesh
+		std::vector<std::uint32_t> instanceNodes;
+		/// World transform of every instance
+		std::vector<InstanceTransform> instanceTransforms;
+		/// Instance of every document node, noIndex for nodes that are not drawn in the scene
+		std::vector<std::uint32_t> nodeInstances;
+	};
+
+	struct LG_EXPORT DrawBatchOptions
+	{
+		/// Gather the instance transforms concurrently
+		bool parallel = true;
+	};
+
+	/**
+	 * Group the nodes with a mesh in a scene into draw batches
+	 *
+	 * Instances are grouped with a counting sort over the mesh indices, so building is linear in the number of nodes.
+	 * Nodes in or below a cycle, and nodes with out of range mesh indices, are left out.
+	 *
+	 * @param worldTransforms the world transform of every node, e.g. from computeWorldTransforms
+	 * @throws std::out_of_range if the scene index is out of range
+	 * @throws std::invalid_argument if there is not a world transform for every node
+	 */
+	LG_EXPORT DrawBatches buildDrawBatches(Gltf const& gltf, NodeHierarchy const& hierarchy,
+		std::span<Matrix4 const> worldTransforms, std::uint32_t scene, DrawBatchOptions const& options = {});
+
+	LG_EXPORT DrawBatches buildDrawBatches(BorrowedGltf const& gltf, NodeHierarchy const& hierarchy,
+		std::span<Matrix4 const> worldTransforms, std::uint32_t scene, DrawBatchOptions const& options = {});
+
+	LG_EXPORT DrawBatches buildDrawBatches(FloatGltf const& gltf, NodeHierarchy const& hierarchy,
+		std::span<Matrix4 const> worldTransforms, std::uint32_t scene, DrawBatchOptions const& options = {});
+
+	/**
+	 * Gather the instance transforms again after node transforms changed, keeping the batches
+	 *
+	 * The document must have the same nodes and meshes as when the batches were built.
+	 *
+	 * @throws std::invalid_argument if there is not a world transform for every node
+	 */
+	LG_EXPORT void updateDrawBatches(DrawBatches& batches, std::span<Matrix4 const> worldTransforms,
+		DrawBatchOptions const& options = {});
+
+	/**
+	 * Gather the instance transforms of only some nodes again, e.g. those moved in an editor and their descendants
+	 *
+	 * Nodes that are not drawn in the scene are ignored.
+	 *
+	 * @throws std::invalid_argument if there is not a world transform for every node
+	 * @throws std::out_of_range if a changed node index is out of range, in which case the batches are left unchanged
+	 */
+	LG_EXPORT void updateDrawBatches(DrawBatches& batches, std::span<Matrix4 const> worldTransforms,
+		std::span<std::uint32_t const> changedNodes);
+}
@@ -0,0 +1,85 @@
+// SPDX-License-Identifier: MIT
+// Copyright © 2022 Sebastian Larsson
+
+#pragma once
+
+#include <load-gltf/accessor.hpp>
+#include <load-gltf/defs.hpp>
+#include <load-gltf/structs.hpp>
+#include <load-gltf/transform.hpp>
+
+#include <array>
+#include <limits>
+#include <span>
+#include <vector>
+
+namespace lg {
+	struct LG_EXPORT Aabb
+	{
+		std::array<double, 3> min = {std::numeric_limits<double>::infinity(),
+			std::numeric_limits<double>::infinity(), std::numeric_limits<double>::infinity()};
+		std::array<double, 3> max = {-std::numeric_limits<double>::infinity(),
+			-std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity()};
+
+		bool isEmpty() const noexcept
+		{
+			return min[0] > max[0];
+		}
+	};
+
+	struct LG_EXPORT BoundingSphere
+	{
+		std::array<double, 3> center = {0.0, 0.0, 0.0};
+		/// Negative if the sphere is empty
+		double radius = -1.0;
+	};
+
+	struct LG_EXPORT Bounds
+	{
+		Aabb box;
+		BoundingSphere sphere;
+	};
+
+	struct LG_EXPORT BoundsOptions
+	{
+		/// Calculate the bounds of the meshes concurrently, if the position data of any of them has to be read
+		bool parallel = true;
+	};
+
+	struct LG_EXPORT DocumentBounds
+	{
+		/// Bounds of every mesh, in the space of the mesh
+		std::vector<Bounds> meshes;
+		/// World space bounds of every node, enclosing its mesh and the meshes of all its descendants
+		std::vector<Bounds> nodes;
+		/// World space bounds of every scene
+		std::vector<Bounds> scenes;
+	};
+
+	/**
+	 * @return bounds enclosing both bounds
+	 */
+	LG_EXPORT Bounds mergeBounds(Bounds const& a, Bounds const& b) noexcept;
+
+	/**
+	 * @return bounds enclosing the transformed bounds, exact for the box
+	 */
+	LG_EXPORT Bounds transformBounds(Bounds const& bounds, Matrix4 const& matrix) noexcept;
+
+	/**
+	 * Calculate the bounding boxes and spheres of every mesh, node and scene
+	 *
+	 * The bounds of a primitive come from the min and max of its POSITION accessor when present, and otherwise from the
+	 * position data. Mesh spheres are centered on the mesh box. Skinning and morph targets are not taken into account.
+	 *
+	 * @throws the same as readAccessorFloats, if position data has to be read
+	 */
+	LG_EXPORT DocumentBounds computeBounds(Gltf const& gltf, std::span<BufferData const> buffers,
+		BoundsOptions const& options = {});
+
+	LG_EXPORT DocumentBounds computeBounds(BorrowedGltf const& gltf, std::span<BufferData const> buffers,
+		BoundsOptions const& options = {});
+
+	LG_EXPORT DocumentBounds computeBounds(FloatGltf const& gltf, std::span<BufferData const> buffers,
+		BoundsOptions const& options = {});
+}
@@ -0,0 +1,138 @@
+// SPDX-License-Identifier: MIT
+// Copyright © 2022 Sebastian Larsson
+
+#pragma once
+
+#include <load-gltf/bounds.hpp>
+#include <load-gltf/defs.hpp>
+#include <load-gltf/structs.hpp>
+#include <load-gltf/transform.hpp>
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+namespace lg {
+	/**
+	 * Single precision box, rounded outwards so that it encloses the double precision box it was made from
+	 */
+	struct LG_EXPORT BvhBox
+	{
+		std::array<float, 3> min = {std::numeric_limits<float>::infinity(), std::numeric_limits<float>::infinity(),
+			std::numeric_limits<float>::infinity()};
+		std::array<float, 3> max = {-std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity(),
+			-std::numeric_limits<float>::infinity()};
+
+		bool isEmpty() const noexcept
+		{
+			return min[0] > max[0];
+		}
+	};
+
+	struct LG_EXPORT BvhNode
+	{
+		BvhBox box;
+		/// Index of the first of two adjacent children for inner nodes, or of the first item for leaves
+		std::uint32_t index = {};
+		/// Number of items of leaves, 0 for inner nodes
+		std::uint32_t count = {};
+	};
+
+	/**
+	 * Bounding volume hierarchy over the world space bounds of every node with a mesh
+	 *
+	 * The root is the first node, and children always come after their parent.
+	 */
+	struct LG_EXPORT SceneBvh
+	{
+		std::vector<BvhNode> nodes;
+		/// Document node of every item, grouped by leaf
+		std::vector<std::uint32_t> items;
+		/// World space box of every item
+		std::vector<BvhBox> itemBoxes;
+	};
+
+	struct LG_EXPORT BvhOptions
+	{
+		/// Most items in a leaf, unless they can not be split
+		std::uint32_t maxLeafSize = 4;
+		/// Number of candidate split positions per axis, at most 64
+		std::uint32_t binCount = 16;
+		/// Build large subtrees concurrently
+		bool parallel = true;
+	};
+
+	struct LG_EXPORT Frustum
+	{
+		/// Planes as a, b, c, d, with the inside where a * x + b * y + c * z + d >= 0
+		std::array<std::array<double, 4>, 6> planes = {};
+	};
+
+	struct LG_EXPORT Ray
+	{
+		std::array<double, 3> origin = {};
+		std::array<double, 3> direction = {};
+		/// Distances are in units of the direction length
+		double maxDistance = std::numeric_limits<double>::infinity();
+	};
+
+	struct LG_EXPORT RayHit
+	{
+		std::uint32_t node = {};
+		/// Distance along the ray to where it enters the box of the node, 0 if it starts inside
+		double distance = {};
+	};
+
+	/**
+	 * Build a hierarchy over every node with a mesh, using the surface area heuristic evaluated at evenly spaced bins
+	 *
+	 * Nodes whose mesh has empty bounds are left out.
+	 *
+	 * @param meshBounds the bounds of every mesh, e.g. DocumentBounds::meshes
+	 * @param worldTransforms the world transform of every node, e.g. from computeWorldTransforms
+	 * @throws std::out_of_range if a mesh index is out of range of meshBounds
+	 * @throws std::invalid_argument if there is not a world transform for every node
+	 */
+	LG_EXPORT SceneBvh buildSceneBvh(Gltf const& gltf, std::span<Bounds const> meshBounds,
+		std::span<Matrix4 const> worldTransforms, BvhOptions const& options = {});
+
+	LG_EXPORT SceneBvh buildSceneBvh(BorrowedGltf const& gltf, std::span<Bounds const> meshBounds,
+		std::span<Matrix4 const> worldTransforms, BvhOptions const& options = {});
+
+	LG_EXPORT SceneBvh buildSceneBvh(FloatGltf const& gltf, std::span<Bounds const> meshBounds,
+		std::span<Matrix4 const> worldTransforms, BvhOptions const& options = {});
+
+	/**
+	 * Update the boxes of a hierarchy in place for new world transforms, keeping its structure
+	 *
+	 * Refitting is much faster than building, but the hierarchy degrades if nodes move far. The document must have
+	 * the same nodes and meshes as when the hierarchy was built.
+	 *
+	 * @throws the same as buildSceneBvh
+	 */
+	LG_EXPORT void refitSceneBvh(SceneBvh& bvh, Gltf const& gltf, std::span<Bounds const> meshBounds,
+		std::span<Matrix4 const> worldTransforms);
+
+	LG_EXPORT void refitSceneBvh(SceneBvh& bvh, BorrowedGltf const& gltf, std::span<Bounds const> meshBounds,
+		std::span<Matrix4 const> worldTransforms);
+
+	LG_EXPORT void refitSceneBvh(SceneBvh& bvh, FloatGltf const& gltf, std::span<Bounds const> meshBounds,
+		std::span<Matrix4 const> worldTransforms);
+
+	/**
+	 * @return the document nodes whose boxes are at least partially inside the frustum
+	 */
+	LG_EXPORT std::vector<std::uint32_t> findInFrustum(SceneBvh const& bvh, Frustum const& frustum);
+
+	/**
+	 * @return the document nodes whose boxes overlap the box
+	 */
+	LG_EXPORT std::vector<std::uint32_t> findOverlapping(SceneBvh const& bvh, Aabb const& box);
+
+	/**
+	 * @return the document nodes whose boxes the ray hits, nearest first
+	 */
+	LG_EXPORT std::vector<RayHit> intersectRay(SceneBvh const& bvh, Ray const& ray);
+}
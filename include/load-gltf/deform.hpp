@@ -0,0 +1,107 @@
+// SPDX-License-Identifier: MIT
+// Copyright © 2022 Sebastian Larsson
+
+#pragma once
+
+#include <load-gltf/accessor.hpp>
+#include <load-gltf/defs.hpp>
+#include <load-gltf/structs.hpp>
+#include <load-gltf/transform.hpp>
+
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace lg {
+	struct LG_EXPORT DeformOptions
+	{
+		/// Process the vertices of large primitives concurrently
+		bool parallel = true;
+	};
+
+	struct LG_EXPORT SkinnedVertices
+	{
+		/// Three components per vertex
+		std::vector<float> positions;
+		/// Three components per vertex, normalized, or empty if there are no input normals
+		std::vector<float> normals;
+	};
+
+	/**
+	 * Calculate the joint matrices of a skin, i.e. the world transform of every joint multiplied by its inverse bind
+	 * matrix
+	 *
+	 * Vertices skinned with these matrices are in world space, so the transform of the skinned node must not be
+	 * applied to them.
+	 *
+	 * @param worldTransforms the world transform of every node, e.g. from computeWorldTransforms
+	 * @throws std::out_of_range if the skin, or a joint, is out of range
+	 * @throws std::invalid_argument if the inverse bind matrices are not one MAT4 per joint
+	 * @throws the same as readAccessorFloats, for the inverse bind matrices
+	 */
+	LG_EXPORT std::vector<Matrix4> computeJointMatrices(Gltf const& gltf, std::span<BufferData const> buffers,
+		std::uint32_t skin, std::span<Matrix4 const> worldTransforms);
+
+	LG_EXPORT std::vector<Matrix4> computeJointMatrices(BorrowedGltf const& gltf, std::span<BufferData const> buffers,
+		std::uint32_t skin, std::span<Matrix4 const> worldTransforms);
+
+	LG_EXPORT std::vector<Matrix4> computeJointMatrices(FloatGltf const& gltf, std::span<BufferData const> buffers,
+		std::uint32_t skin, std::span<Matrix4 const> worldTransforms);
+
+	/**
+	 * Read an attribute of a primitive with the weighted displacements of its morph targets added
+	 *
+	 * Targets with a zero weight, or without the attribute, are skipped, and so are targets without a weight.
+	 *
+	 * @param weights the morph weights, e.g. from the node, the mesh, or an animation
+	 * @throws std::out_of_range if the primitive does not have the attribute
+	 * @throws std::invalid_argument if a target does not have the same number of components as the attribute
+	 * @throws the same as readAccessorFloats
+	 */
+	LG_EXPORT std::vector<float> applyMorphTargets(Gltf const& gltf, std::span<BufferData const> buffers,
+		MeshPrimitive const& primitive, std::string_view attribute, std::span<float const> weights,
+		DeformOptions const& options = {});
+
+	LG_EXPORT std::vector<float> applyMorphTargets(BorrowedGltf const& gltf, std::span<BufferData const> buffers,
+		BasicMeshPrimitive<BorrowingStorage> const& primitive, std::string_view attribute,
+		std::span<float const> weights, DeformOptions const& options = {});
+
+	LG_EXPORT std::vector<float> applyMorphTargets(FloatGltf const& gltf, std::span<BufferData const> buffers,
+		BasicMeshPrimitive<FloatStorage> const& primitive, std::string_view attribute, std::span<float const> weights,
+		DeformOptions const& options = {});
+
+	/**
+	 * Skin positions, and optionally normals, with linear blend skinning of four influences per vertex
+	 *
+	 * Normals are transformed by the inverse transpose of the blended joint matrix, so they are correct under
+	 * non-uniform scale, and mirroring joint matrices keep them pointing outwards.
+	 *
+	 * @param positions three components per vertex
+	 * @param normals three components per vertex, or empty
+	 * @param joints four joint indices per vertex
+	 * @param weights four weights per vertex
+	 * @throws std::invalid_argument if the inputs do not have the same number of vertices
+	 * @throws std::out_of_range if a joint index is out of range of jointMatrices
+	 */
+	LG_EXPORT SkinnedVertices skinVertices(std::span<float const> positions, std::span<float const> normals,
+		std::span<std::uint32_t const> joints, std::span<float const> weights, std::span<Matrix4 const> jointMatrices,
+		DeformOptions const& options = {});
+
+	/**
+	 * Skin the POSITION and NORMAL attributes of a primitive, using its JOINTS_0 and WEIGHTS_0 attributes
+	 *
+	 * @throws std::out_of_range if the primitive does not have POSITION, JOINTS_0 or WEIGHTS_0
+	 * @throws the same as readAccessorFloats, readAccessorUints and the skinVertices overload above
+	 */
+	LG_EXPORT SkinnedVertices skinVertices(Gltf const& gltf, std::span<BufferData const> buffers,
+		MeshPrimitive const& primitive, std::span<Matrix4 const> jointMatrices, DeformOptions const& options = {});
+
+	LG_EXPORT SkinnedVertices skinVertices(BorrowedGltf const& gltf, std::span<BufferData const> buffers,
+		BasicMeshPrimitive<BorrowingStorage> const& primitive, std::span<Matrix4 const> jointMatrices,
+		DeformOptions const& options = {});
+
+	LG_EXPORT SkinnedVertices skinVertices(FloatGltf const& gltf, std::span<BufferData const> buffers,
+		BasicMeshPrimitive<FloatStorage> const& primitive, std::span<Matrix4 const> jointMatrices,
+		DeformOptions const& options = {});
+}
@@ -6,5 +6,5 @@
 #ifdef _WIN32
 #define LG_EXPORT __declspec(dllexport)
 #else
-#define load-gltf_EXPORT
+#define LG_EXPORT
 #endif
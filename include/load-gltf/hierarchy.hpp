@@ -0,0 +1,61 @@
+// SPDX-License-Identifier: MIT
+// Copyright © 2022 Sebastian Larsson
+
+#pragma once
+
+#include <load-gltf/defs.hpp>
+#include <load-gltf/structs.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace lg {
+	/**
+	 * A reference from a node to one of its children
+	 */
+	struct LG_EXPORT NodeEdge
+	{
+		std::uint32_t parent = {};
+		/// Position of the child in the children of the parent
+		std::uint32_t position = {};
+		std::uint32_t child = {};
+	};
+
+	/**
+	 * The parent-child structure of the nodes of a document
+	 *
+	 * Out of range child and scene node indices are ignored.
+	 */
+	struct LG_EXPORT NodeHierarchy
+	{
+		/// Parent of every node, noIndex for nodes without a parent
+		std::vector<std::uint32_t> parents;
+		/// Every node without a parent, in index order
+		std::vector<std::uint32_t> roots;
+		/// Every node reachable from a root, ordered so that parents come before their children
+		std::vector<std::uint32_t> order;
+		/// Root nodes of every scene, without duplicates or non-root nodes
+		std::vector<std::vector<std::uint32_t>> sceneRoots;
+		/// References to nodes that already have a parent, which are not recorded in parents
+		std::vector<NodeEdge> sharedChildren;
+		/// One node of every cycle. Nodes in, or below, a cycle are not part of order.
+		std::vector<std::uint32_t> cycles;
+
+		bool isForest() const noexcept
+		{
+			return sharedChildren.empty() && cycles.empty();
+		}
+	};
+
+	/**
+	 * Analyse the node hierarchy of a document
+	 *
+	 * Runs in time linear in the number of nodes and child references, without recursion, so arbitrarily deep
+	 * hierarchies are supported.
+	 */
+	LG_EXPORT NodeHierarchy analyzeNodeHierarchy(Gltf const& gltf);
+
+	LG_EXPORT NodeHierarchy analyzeNodeHierarchy(BorrowedGltf const& gltf);
+
+	LG_EXPORT NodeHierarchy analyzeNodeHierarchy(FloatGltf const& gltf);
+}
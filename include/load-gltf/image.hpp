@@ -0,0 +1,83 @@
+// SPDX-License-Identifier: MIT
+// Copyright © 2022 Sebastian Larsson
+
+#pragma once
+
+#include <load-gltf/accessor.hpp>
+#include <load-gltf/defs.hpp>
+#include <load-gltf/structs.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace lg {
+	/**
+	 * Reads up to size bytes at an offset of the resource a URI refers to, fewer at the end of the resource, and none
+	 * if it can not be read
+	 */
+	using UriReader = std::function<std::vector<std::byte>(std::string_view uri, std::uint64_t offset,
+		std::size_t size)>;
+
+	struct LG_EXPORT ImageResources
+	{
+		/// Contents of every buffer, for images stored in buffer views
+		std::span<BufferData const> buffers;
+		/// Reader of images with URIs other than data URIs. Such images are not probed if it is empty.
+		UriReader readUri;
+	};
+
+	struct LG_EXPORT ImageProbeOptions
+	{
+		/// Probe the images concurrently
+		bool parallel = true;
+	};
+
+	struct LG_EXPORT ImageInfo
+	{
+		/// Format detected from the data: "image/png", "image/jpeg", "image/ktx2" or "image/webp", or empty if the
+		/// image could not be read or recognized
+		std::string mimeType;
+		std::uint32_t width = {};
+		std::uint32_t height = {};
+		/// Number of color and alpha channels, 0 if unknown
+		std::uint32_t channels = {};
+		/// Bits per channel, 0 if unknown, e.g. for block compressed formats
+		std::uint32_t bitDepth = {};
+		/// Number of mip levels stored in the image
+		std::uint32_t levels = 1;
+		/// VkFormat of KTX2 images, 0 for other images and for supercompressed Basis Universal images
+		std::uint32_t vkFormat = {};
+		/// Number of bytes read to probe the image
+		std::size_t bytesRead = {};
+	};
+
+	/**
+	 * Read the dimensions and format of every image from its header, without decoding the pixels
+	 *
+	 * Only the first few KB of an image are read, plus a few bytes per segment preceding the frame header of JPEG
+	 * images. Data URIs are decoded only as far as needed.
+	 *
+	 * @throws std::out_of_range if the buffer view of an image, or its data, is out of range
+	 */
+	LG_EXPORT std::vector<ImageInfo> probeImages(Gltf const& gltf, ImageResources const& resources,
+		ImageProbeOptions const& options = {});
+
+	LG_EXPORT std::vector<ImageInfo> probeImages(BorrowedGltf const& gltf, ImageResources const& resources,
+		ImageProbeOptions const& options = {});
+
+	LG_EXPORT std::vector<ImageInfo> probeImages(FloatGltf const& gltf, ImageResources const& resources,
+		ImageProbeOptions const& options = {});
+
+	/**
+	 * @return a reader of files with URIs relative to a directory, e.g. that of the document, with percent-encoded
+	 * characters decoded. Absolute paths and paths with .. components are not read, so that a document can not
+	 * refer to files outside of the directory, other than through links within it.
+	 */
+	LG_EXPORT UriReader fileUriReader(std::filesystem::path directory);
+}
@@ -0,0 +1,39 @@
+// SPDX-License-Identifier: MIT
+// Copyright © 2022 Sebastian Larsson
+
+#pragma once
+
+#include <load-gltf/defs.hpp>
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace lg {
+	/**
+	 * Parsed JSON value, for the raw JSON of extras and extensions
+	 */
+	struct LG_EXPORT JsonValue
+	{
+		using Array = std::vector<JsonValue>;
+		/// Members in document order
+		using Object = std::vector<std::pair<std::string, JsonValue>>;
+
+		std::variant<std::nullptr_t, bool, double, std::string, Array, Object> value;
+
+		/**
+		 * @return the last member with the given name, or nullptr if there is none or this is not an object
+		 */
+		JsonValue const* find(std::string_view name) const noexcept;
+	};
+
+	/**
+	 * Parse JSON text, such as Extras::json
+	 *
+	 * @throws std::runtime_error if the text is not valid JSON
+	 */
+	LG_EXPORT JsonValue parseJson(std::string_view json);
+}
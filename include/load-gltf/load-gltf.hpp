@@ -3,9 +3,28 @@
 
 #pragma once
 
+#include <load-gltf/accessor.hpp>
+#include <load-gltf/batch.hpp>
+#include <load-gltf/bounds.hpp>
+#include <load-gltf/bvh.hpp>
+#include <load-gltf/deform.hpp>
+#include <load-gltf/hierarchy.hpp>
+#include <load-gltf/image.hpp>
+#include <load-gltf/json.hpp>
+#include <load-gltf/meshopt.hpp>
+#include <load-gltf/optimize.hpp>
+#include <load-gltf/reload.hpp>
+#include <load-gltf/soa.hpp>
 #include <load-gltf/structs.hpp>
+#include <load-gltf/transform.hpp>
+#include <load-gltf/validate.hpp>
 
+#include <cstddef>
+#include <functional>
+#include <span>
+#include <string>
 #include <string_view>
+#include <vector>
 
 namespace lg {
 	// TODO: Docs
@@ -17,4 +36,117 @@ namespace lg {
 	constexpr std::size_t paddingSize = 64;
 
 	LG_EXPORT Gltf loadGltfPrePadded(std::string_view paddedInputJson);
+
+	/**
+	 * Load a document with its numbers parsed directly into single precision
+	 */
+	LG_EXPORT FloatGltf loadGltfFloat(std::string_view inputJson);
+
+	LG_EXPORT FloatGltf loadGltfFloatPrePadded(std::string_view paddedInputJson);
+
+	/**
+	 * Load a document whose strings reference the input instead of owning copies of them
+	 *
+	 * The input must be padded with paddingSize bytes, and must outlive the returned document.
+	 */
+	LG_EXPORT BorrowedGltf loadGltfBorrowed(std::string_view paddedInputJson);
+
+	/**
+	 * Load a document with its nodes and accessors parsed directly into structure-of-arrays form
+	 *
+	 * The input must be padded with paddingSize bytes.
+	 */
+	LG_EXPORT SoAScene loadSoAScene(std::string_view paddedInputJson);
+
+	/**
+	 * Load a document in structure-of-arrays form, with its numbers parsed directly into single precision
+	 *
+	 * The input must be padded with paddingSize bytes.
+	 */
+	LG_EXPORT FloatSoAScene loadSoASceneFloat(std::string_view paddedInputJson);
+
+	/**
+	 * Hash the JSON text of the top-level elements of a document, for reloading the document loaded from it
+	 */
+	LG_EXPORT DocumentHashes hashGltf(std::string_view inputJson);
+
+	LG_EXPORT DocumentHashes hashGltfPrePadded(std::string_view paddedInputJson);
+
+	/**
+	 * Update a document in place from a new version of its JSON, parsing only the top-level elements whose text changed
+	 *
+	 * Finding the changed elements costs a small fraction of a full load. Elements are compared by their text, so
+	 * reformatting an element also counts as a change. Borrowed documents can not be reloaded, as their unchanged
+	 * elements would still reference the previous input.
+	 *
+	 * @param hashes the hashes of the JSON the document was loaded from, e.g. from hashGltf, replaced by those of the
+	 * new JSON
+	 * @throws the same as loadGltf, in which case the document and hashes are left unchanged
+	 */
+	LG_EXPORT ChangeSet reload(Gltf& gltf, DocumentHashes& hashes, std::string_view inputJson);
+
+	LG_EXPORT ChangeSet reload(FloatGltf& gltf, DocumentHashes& hashes, std::string_view inputJson);
+
+	LG_EXPORT ChangeSet reloadPrePadded(Gltf& gltf, DocumentHashes& hashes, std::string_view paddedInputJson);
+
+	LG_EXPORT ChangeSet reloadPrePadded(FloatGltf& gltf, DocumentHashes& hashes, std::string_view paddedInputJson);
+
+	/**
+	 * Receives written output in chunks, e.g. to stream it to a file
+	 */
+	using OutputSink = std::function<void(std::span<std::byte const> data)>;
+
+	/**
+	 * Write a document as glTF JSON
+	 *
+	 * The fields are written in the same way as they are loaded, and fields at the default value of the specification
+	 * are left out. Numbers are written in the shortest form that is read back as the same value, and extras and
+	 * extensions are written as their raw JSON.
+	 *
+	 * @throws std::invalid_argument if a number is not finite
+	 */
+	LG_EXPORT std::string writeGltf(Gltf const& gltf);
+
+	LG_EXPORT std::string writeGltf(BorrowedGltf const& gltf);
+
+	LG_EXPORT std::string writeGltf(FloatGltf const& gltf);
+
+	/**
+	 * Write a document as glTF JSON, handing the output to a sink in chunks of a few tens of KB
+	 *
+	 * @throws the same as writeGltf
+	 */
+	LG_EXPORT void writeGltf(Gltf const& gltf, OutputSink const& sink);
+
+	LG_EXPORT void writeGltf(BorrowedGltf const& gltf, OutputSink const& sink);
+
+	LG_EXPORT void writeGltf(FloatGltf const& gltf, OutputSink const& sink);
+
+	/**
+	 * Write a document as GLB, with the JSON and binary chunks padded to four byte boundaries
+	 *
+	 * @param binChunk the contents of the first buffer, or empty to leave out the binary chunk
+	 * @throws std::invalid_argument if binChunk is not empty and the first buffer has a URI or a different byte
+	 * length, if binChunk is empty and the first buffer has neither a URI nor a zero byte length, if the output is
+	 * too large for GLB, or if a number is not finite
+	 */
+	LG_EXPORT std::vector<std::byte> writeGlb(Gltf const& gltf, BufferData binChunk);
+
+	LG_EXPORT std::vector<std::byte> writeGlb(BorrowedGltf const& gltf, BufferData binChunk);
+
+	LG_EXPORT std::vector<std::byte> writeGlb(FloatGltf const& gltf, BufferData binChunk);
+
+	/**
+	 * Write a document as GLB, handing the output to a sink
+	 *
+	 * The JSON chunk is written in one piece once it is complete, as the header needs its length, while the binary
+	 * chunk is handed to the sink without copying it.
+	 *
+	 * @throws the same as writeGlb
+	 */
+	LG_EXPORT void writeGlb(Gltf const& gltf, BufferData binChunk, OutputSink const& sink);
+
+	LG_EXPORT void writeGlb(BorrowedGltf const& gltf, BufferData binChunk, OutputSink const& sink);
+
+	LG_EXPORT void writeGlb(FloatGltf const& gltf, BufferData binChunk, OutputSink const& sink);
 }
@@ -0,0 +1,66 @@
+// SPDX-License-Identifier: MIT
+// Copyright © 2022 Sebastian Larsson
+
+#pragma once
+
+#include <load-gltf/accessor.hpp>
+#include <load-gltf/defs.hpp>
+#include <load-gltf/structs.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace lg {
+	/**
+	 * Decode data compressed with the codecs of EXT_meshopt_compression
+	 *
+	 * Attribute data is decoded first, and the filter is then applied in place. Only version 0 of the attribute codec
+	 * is supported, as required by the extension.
+	 *
+	 * @param destination memory for the decoded data, at least count * byteStride bytes
+	 * @param mode "ATTRIBUTES", "TRIANGLES" or "INDICES"
+	 * @param filter "NONE", "OCTAHEDRAL", "QUATERNION" or "EXPONENTIAL"
+	 * @param source the compressed data
+	 * @throws std::out_of_range if destination is too small
+	 * @throws std::invalid_argument if the mode, filter or byte stride is not supported, or the data is malformed
+	 */
+	LG_EXPORT void decodeMeshopt(std::span<std::byte> destination, std::uint32_t count, std::uint32_t byteStride,
+		std::string_view mode, std::string_view filter, BufferData source);
+
+	/**
+	 * Decode a buffer view compressed with EXT_meshopt_compression into caller-provided memory
+	 *
+	 * The destination is typically the range of the buffer view within its own, fallback, buffer, after which the
+	 * buffer view can be read like any other, e.g. by readAccessorData.
+	 *
+	 * @param destination memory for the decoded data, at least count * byteStride bytes of the compression
+	 * @throws std::invalid_argument if the buffer view is not compressed
+	 * @throws std::out_of_range if the buffer view, or the compressed data it references, is out of range
+	 * @throws the same as decodeMeshopt
+	 */
+	LG_EXPORT void decodeMeshoptBufferView(Gltf const& gltf, std::span<BufferData const> buffers,
+		std::uint32_t bufferView, std::span<std::byte> destination);
+
+	LG_EXPORT void decodeMeshoptBufferView(BorrowedGltf const& gltf, std::span<BufferData const> buffers,
+		std::uint32_t bufferView, std::span<std::byte> destination);
+
+	LG_EXPORT void decodeMeshoptBufferView(FloatGltf const& gltf, std::span<BufferData const> buffers,
+		std::uint32_t bufferView, std::span<std::byte> destination);
+
+	/**
+	 * Decode a buffer view compressed with EXT_meshopt_compression into new memory
+	 *
+	 * @throws the same as decodeMeshoptBufferView
+	 */
+	LG_EXPORT std::vector<std::byte> decodeMeshoptBufferView(Gltf const& gltf, std::span<BufferData const> buffers,
+		std::uint32_t bufferView);
+
+	LG_EXPORT std::vector<std::byte> decodeMeshoptBufferView(BorrowedGltf const& gltf,
+		std::span<BufferData const> buffers, std::uint32_t bufferView);
+
+	LG_EXPORT std::vector<std::byte> decodeMeshoptBufferView(FloatGltf const& gltf,
+		std::span<BufferData const> buffers, std::uint32_t bufferView);
+}
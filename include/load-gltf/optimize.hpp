@@ -0,0 +1,92 @@
+// SPDX-License-Identifier: MIT
+// Copyright © 2022 Sebastian Larsson
+
+#pragma once
+
+#include <load-gltf/accessor.hpp>
+#include <load-gltf/defs.hpp>
+#include <load-gltf/structs.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace lg {
+	struct LG_EXPORT MeshOptimizationOptions
+	{
+		/// Number of entries of the post-transform vertex cache to optimize for
+		std::uint32_t cacheSize = 16;
+	};
+
+	struct LG_EXPORT OptimizedAttribute
+	{
+		std::string name;
+		/// Accessor the data was read from, describing the format of the elements
+		std::uint32_t accessor = {};
+		/// Tightly packed elements, in the order of the optimized vertices
+		std::vector<std::byte> data;
+	};
+
+	struct LG_EXPORT OptimizedPrimitive
+	{
+		/// Triangle list, indexing the optimized vertices
+		std::vector<std::uint32_t> indices;
+		/// Vertex attributes, sorted by name
+		std::vector<OptimizedAttribute> attributes;
+		/// Attributes of every morph target of the primitive, each sorted by name and in the same vertex order
+		std::vector<std::vector<OptimizedAttribute>> targets;
+		/// Number of optimized vertices, not counting vertices unused by any triangle
+		std::uint32_t vertexCount = 0;
+		/// Average cache miss ratio, vertex cache misses per triangle, before optimization
+		double acmrBefore = 0.0;
+		/// Average cache miss ratio after optimization
+		double acmrAfter = 0.0;
+	};
+
+	/**
+	 * Calculate the average cache miss ratio of a triangle list for a FIFO vertex cache
+	 */
+	LG_EXPORT double computeAcmr(std::span<std::uint32_t const> indices, std::uint32_t vertexCount,
+		std::uint32_t cacheSize);
+
+	/**
+	 * Reorder the triangles of a triangle list for vertex cache efficiency, using Tipsify
+	 *
+	 * Runs in time linear in the number of triangles.
+	 *
+	 * @throws std::out_of_range if an index is not less than vertexCount
+	 */
+	LG_EXPORT std::vector<std::uint32_t> optimizeVertexCache(std::span<std::uint32_t const> indices,
+		std::uint32_t vertexCount, std::uint32_t cacheSize);
+
+	/**
+	 * Renumber the vertices of a triangle list in order of first use, for vertex fetch locality
+	 *
+	 * @return the new index of every old vertex, noIndex for vertices not used by any triangle
+	 * @throws std::out_of_range if an index is not less than vertexCount
+	 */
+	LG_EXPORT std::vector<std::uint32_t> optimizeVertexFetch(std::span<std::uint32_t> indices,
+		std::uint32_t vertexCount);
+
+	/**
+	 * Optimize a triangle list primitive for vertex cache and vertex fetch efficiency
+	 *
+	 * Reads the index and attribute data of the primitive, reorders the triangles and then the vertices, and writes
+	 * the result to new, compact buffers. Morph target attributes are reordered along with the vertices. Primitives
+	 * without indices are treated as having sequential indices.
+	 *
+	 * @throws std::invalid_argument if the primitive is not a triangle list, or its attributes, including those of its
+	 * morph targets, differ in count
+	 * @throws the same as readAccessorData
+	 */
+	LG_EXPORT OptimizedPrimitive optimizePrimitive(Gltf const& gltf, std::span<BufferData const> buffers,
+		MeshPrimitive const& primitive, MeshOptimizationOptions const& options = {});
+
+	LG_EXPORT OptimizedPrimitive optimizePrimitive(BorrowedGltf const& gltf, std::span<BufferData const> buffers,
+		BasicMeshPrimitive<BorrowingStorage> const& primitive, MeshOptimizationOptions const& options = {});
+
+	LG_EXPORT OptimizedPrimitive optimizePrimitive(FloatGltf const& gltf, std::span<BufferData const> buffers,
+		BasicMeshPrimitive<FloatStorage> const& primitive, MeshOptimizationOptions const& options = {});
+}
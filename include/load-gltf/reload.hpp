@@ -0,0 +1,44 @@
+// SPDX-License-Identifier: MIT
+// Copyright © 2022 Sebastian Larsson
+
+#pragma once
+
+#include <load-gltf/defs.hpp>
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace lg {
+	/**
+	 * Hashes of the JSON text a document was loaded from, used to find what changed when it is reloaded
+	 *
+	 * Top-level arrays of objects have a hash per element, other top-level properties a single hash. Hashes are
+	 * only meant to be compared within the same process.
+	 */
+	struct LG_EXPORT DocumentHashes
+	{
+		/// Hashes by top-level property name
+		std::unordered_map<std::string, std::vector<std::uint64_t>> properties;
+	};
+
+	/**
+	 * Changes made to a document by reloading it
+	 *
+	 * Elements added to the end of an array are listed as changed. Elements removed from the end are not listed, but
+	 * are reflected by the size of the array.
+	 */
+	struct LG_EXPORT ChangeSet
+	{
+		/// Indices of the nodes that changed, in ascending order
+		std::vector<std::uint32_t> nodes;
+		/// Indices of the meshes that changed, in ascending order
+		std::vector<std::uint32_t> meshes;
+		/// Indices of the materials that changed, in ascending order
+		std::vector<std::uint32_t> materials;
+		/// Names of the top-level properties that were changed, added or removed, including arrays with changed
+		/// elements
+		std::vector<std::string> properties;
+	};
+}
@@ -0,0 +1,101 @@
+// SPDX-License-Identifier: MIT
+// Copyright © 2022 Sebastian Larsson
+
+#pragma once
+
+#include <load-gltf/defs.hpp>
+#include <load-gltf/structs.hpp>
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace lg {
+	/**
+	 * All nodes of a document, stored as one column per property
+	 *
+	 * Variable length properties are stored in compressed sparse row form: the values of node i are found in the range
+	 * [offsets[i], offsets[i + 1]). Extensions and extras are rare, so they are only stored for the nodes listed in
+	 * extendedNodes.
+	 */
+	template<typename Storage>
+	struct LG_EXPORT BasicSoANodes
+	{
+		static constexpr std::uint8_t hasMatrix = 1 << 0;
+		static constexpr std::uint8_t hasMesh = 1 << 1;
+		static constexpr std::uint8_t hasSkin = 1 << 2;
+		static constexpr std::uint8_t hasCamera = 1 << 3;
+
+		std::vector<std::uint8_t> flags;
+		std::vector<std::array<typename Storage::Scalar, 3>> translations;
+		std::vector<std::array<typename Storage::Scalar, 4>> rotations;
+		std::vector<std::array<typename Storage::Scalar, 3>> scales;
+		std::vector<std::array<typename Storage::Scalar, 16>> matrices;
+		std::vector<std::uint32_t> meshes;
+		std::vector<std::uint32_t> skins;
+		std::vector<std::uint32_t> cameras;
+		std::vector<std::uint32_t> childOffsets = {0};
+		std::vector<std::uint32_t> children;
+		std::vector<std::uint32_t> weightOffsets = {0};
+		std::vector<typename Storage::Scalar> weights;
+		std::vector<std::optional<typename Storage::String>> names;
+		std::vector<std::uint32_t> extendedNodes;
+		std::vector<std::unordered_map<typename Storage::String, BasicExtension<Storage>>> extensions;
+		std::vector<std::optional<BasicExtras<Storage>>> extras;
+	};
+
+	/**
+	 * All accessors of a document, stored as one column per property
+	 *
+	 * Bounds are stored in compressed sparse row form, like the variable length node properties. Sparse storage is
+	 * rare, so it is only stored for the accessors listed in sparseAccessors, and likewise extensions and extras for the
+	 * accessors listed in extendedAccessors.
+	 */
+	template<typename Storage>
+	struct LG_EXPORT BasicSoAAccessors
+	{
+		static constexpr std::uint8_t hasBufferView = 1 << 0;
+		static constexpr std::uint8_t isNormalized = 1 << 1;
+		static constexpr std::uint8_t isSparse = 1 << 2;
+
+		std::vector<std::uint8_t> flags;
+		std::vector<std::uint32_t> bufferViews;
+		std::vector<std::uint32_t> byteOffsets;
+		std::vector<std::uint32_t> componentTypes;
+		std::vector<std::uint32_t> counts;
+		std::vector<typename Storage::String> types;
+		std::vector<std::uint32_t> maxOffsets = {0};
+		std::vector<typename Storage::Scalar> max;
+		std::vector<std::uint32_t> minOffsets = {0};
+		std::vector<typename Storage::Scalar> min;
+		std::vector<std::uint32_t> sparseAccessors;
+		std::vector<BasicAccessorSparse<Storage>> sparse;
+		std::vector<std::optional<typename Storage::String>> names;
+		std::vector<std::uint32_t> extendedAccessors;
+		std::vector<std::unordered_map<typename Storage::String, BasicExtension<Storage>>> extensions;
+		std::vector<std::optional<BasicExtras<Storage>>> extras;
+	};
+
+	/**
+	 * A document with its nodes and accessors in structure-of-arrays form
+	 *
+	 * The nodes and accessors of document are left empty.
+	 */
+	template<typename Storage>
+	struct LG_EXPORT BasicSoAScene
+	{
+		BasicSoANodes<Storage> nodes;
+		BasicSoAAccessors<Storage> accessors;
+		BasicGltf<Storage> document;
+	};
+
+	using SoANodes = BasicSoANodes<OwningStorage>;
+	using SoAAccessors = BasicSoAAccessors<OwningStorage>;
+	using SoAScene = BasicSoAScene<OwningStorage>;
+
+	using FloatSoANodes = BasicSoANodes<FloatStorage>;
+	using FloatSoAAccessors = BasicSoAAccessors<FloatStorage>;
+	using FloatSoAScene = BasicSoAScene<FloatStorage>;
+}
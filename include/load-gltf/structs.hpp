@@ -7,96 +7,169 @@
 
 #include <array>
 #include <cstdint>
+#include <forward_list>
+#include <limits>
+#include <memory>
 #include <unordered_map>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace lg {
-	struct LG_EXPORT Extension
+	/**
+	 * Index value used where a reference to another element is absent
+	 */
+	constexpr std::uint32_t noIndex = std::numeric_limits<std::uint32_t>::max();
+
+	/**
+	 * Storage policy for documents that own copies of all their strings
+	 */
+	struct LG_EXPORT OwningStorage
 	{
-		// TODO: JSON structure or extension specific structs?
+		using String = std::string;
+		using Scalar = double;
+
+		struct StringArena
+		{
+		};
+	};
+
+	/**
+	 * Storage policy for documents whose strings reference the input buffer
+	 *
+	 * Strings containing escape sequences can not be referenced directly, so they are unescaped into the string arena
+	 * of the document instead. The arena makes such documents move-only, as copies would reference the arena of the
+	 * original.
+	 */
+	struct LG_EXPORT BorrowingStorage
+	{
+		using String = std::string_view;
+		using Scalar = double;
+		using StringArena = std::forward_list<std::unique_ptr<char[]>>;
+	};
+
+	/**
+	 * Storage policy for documents that own copies of all their strings, and store numbers in single precision
+	 *
+	 * Numbers are rounded to the nearest float when parsed, which halves the size of node transforms, material
+	 * factors and accessor bounds.
+	 */
+	struct LG_EXPORT FloatStorage
+	{
+		using String = std::string;
+		using Scalar = float;
+
+		struct StringArena
+		{
+		};
+	};
+
+	/**
+	 * Extension not modeled by the library, captured as raw JSON without parsing it
+	 *
+	 * The JSON can be parsed on demand with parseJson. Extensions modeled by typed members, such as
+	 * BufferView::meshoptCompression, have empty JSON.
+	 */
+	template<typename Storage>
+	struct LG_EXPORT BasicExtension
+	{
+		typename Storage::String json;
 	};
 
-	struct LG_EXPORT Extras
+	/**
+	 * Application specific data, captured as raw JSON without parsing it
+	 *
+	 * The JSON can be parsed on demand with parseJson.
+	 */
+	template<typename Storage>
+	struct LG_EXPORT BasicExtras
 	{
-		// TODO: JSON value
+		typename Storage::String json;
 	};
 
-	struct LG_EXPORT AccessorSparseIndices
+	template<typename Storage>
+	struct LG_EXPORT BasicAccessorSparseIndices
 	{
 		std::uint32_t bufferView = {};
 		std::uint32_t byteOffset = 0;
 		std::uint32_t componentType = {};
-		std::unordered_map<std::string, Extension> extensions;
-		std::optional<Extras> extras;
+		std::unordered_map<typename Storage::String, BasicExtension<Storage>> extensions;
+		std::optional<BasicExtras<Storage>> extras;
 	};
 
-	struct LG_EXPORT AccessorSparseValues
+	template<typename Storage>
+	struct LG_EXPORT BasicAccessorSparseValues
 	{
 		std::uint32_t bufferView = {};
 		std::uint32_t byteOffset = 0;
-		std::unordered_map<std::string, Extension> extensions;
-		std::optional<Extras> extras;
+		std::unordered_map<typename Storage::String, BasicExtension<Storage>> extensions;
+		std::optional<BasicExtras<Storage>> extras;
 	};
 
-	struct LG_EXPORT AccessorSparse
+	template<typename Storage>
+	struct LG_EXPORT BasicAccessorSparse
 	{
 		std::uint32_t count = {};
-		AccessorSparseIndices indices;
-		AccessorSparseValues values;
-		std::unordered_map<std::string, Extension> extensions;
-		std::optional<Extras> extras;
+		BasicAccessorSparseIndices<Storage> indices;
+		BasicAccessorSparseValues<Storage> values;
+		std::unordered_map<typename Storage::String, BasicExtension<Storage>> extensions;
+		std::optional<BasicExtras<Storage>> extras;
 	};
 
-	struct LG_EXPORT Accessor
+	template<typename Storage>
+	struct LG_EXPORT BasicAccessor
 	{
 		std::optional<std::uint32_t> bufferView;
 		std::uint32_t byteOffset = 0;
 		std::uint32_t componentType = {};
 		bool normalized = false;
 		std::uint32_t count = {};
-		std::string type;
-		std::vector<double> max;
-		std::vector<double> min;
-		std::optional<AccessorSparse> sparse;
-		std::optional<std::string> name;
-		std::unordered_map<std::string, Extension> extensions;
-		std::optional<Extras> extras;
+		typename Storage::String type;
+		std::vector<typename Storage::Scalar> max;
+		std::vector<typename Storage::Scalar> min;
+		std::optional<BasicAccessorSparse<Storage>> sparse;
+		std::optional<typename Storage::String> name;
+		std::unordered_map<typename Storage::String, BasicExtension<Storage>> extensions;
+		std::optional<BasicExtras<Storage>> extras;
 	};
 
-	struct LG_EXPORT AnimationChannelTarget
+	template<typename Storage>
+	struct LG_EXPORT BasicAnimationChannelTarget
 	{
 		std::optional<std::uint32_t> node;
-		std::string path;
-		std::unordered_map<std::string, Extension> extensions;
-		std::optional<Extras> extras;
+		typename Storage::String path;
+		std::unordered_map<typename Storage::String, BasicExtension<Storage>> extensions;
+		std::optional<BasicExtras<Storage>> extras;
 	};
 
-	struct LG_EXPORT AnimationChannel
+	template<typename Storage>
+	struct LG_EXPORT BasicAnimationChannel
 	{
 		std::uint32_t sampler = {};
-		AnimationChannelTarget target;
-		std::unordered_map<std::string, Extension> extensions;
-		std::optional<Extras> extras;
+		BasicAnimationChannelTarget<Storage> target;
+		std::unordered_map<typename Storage::String, BasicExtension<Storage>> extensions;
+		std::optional<BasicExtras<Storage>> extras;
 	};
 
-	struct LG_EXPORT AnimationSampler
+	template<typename Storage>
+	struct LG_EXPORT BasicAnimationSampler
 	{
 		std::uint32_t input = {};
-		std::string interpolation = "LINEAR";
+		typename Storage::String interpolation = "LINEAR";
 		std::uint32_t output = {};
-		std::unordered_map<std::string, Extension> extensions;
-		std::optional<Extras> extras;
+		std::unordered_map<typename Storage::String, BasicExtension<Storage>> extensions;
+		std::optional<BasicExtras<Storage>> extras;
 	};
 
-	struct LG_EXPORT Animation
+	template<typename Storage>
+	struct LG_EXPORT BasicAnimation
 	{
-		std::vector<AnimationChannel> channels;
-		std::vector<AnimationSampler> samplers;
-		std::optional<std::string> name;
-		std::unordered_map<std::string, Extension> extensions;
-		std::optional<Extras> extras;
+		std::vector<BasicAnimationChannel<Storage>> channels;
+		std::vector<BasicAnimationSampler<Storage>> samplers;
+		std::optional<typename Storage::String> name;
+		std::unordered_map<typename Storage::String, BasicExtension<Storage>> extensions;
+		std::optional<BasicExtras<Storage>> extras;
 	};
 
 	struct LG_EXPORT Version
@@ -105,227 +178,306 @@ namespace lg {
 		std::uint32_t minor = {};
 	};
 
-	struct LG_EXPORT Asset
+	template<typename Storage>
+	struct LG_EXPORT BasicAsset
 	{
-		std::optional<std::string> copyright;
-		std::optional<std::string> generator;
+		std::optional<typename Storage::String> copyright;
+		std::optional<typename Storage::String> generator;
 		Version version;
 		std::optional<Version> minVersion;
-		std::unordered_map<std::string, Extension> extensions;
-		std::optional<Extras> extras;
+		std::unordered_map<typename Storage::String, BasicExtension<Storage>> extensions;
+		std::optional<BasicExtras<Storage>> extras;
+	};
+
+	template<typename Storage>
+	struct LG_EXPORT BasicBuffer
+	{
+		std::optional<typename Storage::String> uri;
+		std::uint32_t byteLength = {};
+		std::optional<typename Storage::String> name;
+		std::unordered_map<typename Storage::String, BasicExtension<Storage>> extensions;
+		std::optional<BasicExtras<Storage>> extras;
 	};
 
-	struct LG_EXPORT Buffer
+	/**
+	 * Compressed buffer view data, from the EXT_meshopt_compression extension
+	 *
+	 * The compressed data is stored in its own buffer range, and decodes to count elements of byteStride bytes.
+	 */
+	template<typename Storage>
+	struct LG_EXPORT BasicMeshoptCompression
 	{
-		std::optional<std::string> uri;
+		std::uint32_t buffer = {};
+		std::uint32_t byteOffset = 0;
 		std::uint32_t byteLength = {};
-		std::optional<std::string> name;
-		std::unordered_map<std::string, Extension> extensions;
-		std::optional<Extras> extras;
+		std::uint32_t byteStride = {};
+		std::uint32_t count = {};
+		/// "ATTRIBUTES", "TRIANGLES" or "INDICES"
+		typename Storage::String mode;
+		/// "NONE", "OCTAHEDRAL", "QUATERNION" or "EXPONENTIAL"
+		typename Storage::String filter = "NONE";
 	};
 
-	struct LG_EXPORT BufferView
+	template<typename Storage>
+	struct LG_EXPORT BasicBufferView
 	{
 		std::uint32_t buffer = {};
 		std::uint32_t byteOffset = 0;
 		std::uint32_t byteLength = {};
 		std::optional<std::uint32_t> byteStride;
 		std::optional<std::uint32_t> target;
-		std::optional<std::string> name;
-		std::unordered_map<std::string, Extension> extensions;
-		std::optional<Extras> extras;
+		std::optional<typename Storage::String> name;
+		/// Parsed from the EXT_meshopt_compression entry of extensions
+		std::optional<BasicMeshoptCompression<Storage>> meshoptCompression;
+		std::unordered_map<typename Storage::String, BasicExtension<Storage>> extensions;
+		std::optional<BasicExtras<Storage>> extras;
 	};
 
-	struct LG_EXPORT CameraOrthographic
+	template<typename Storage>
+	struct LG_EXPORT BasicCameraOrthographic
 	{
-		double xmag = {};
-		double ymag = {};
-		double zfar = {};
-		double znear = {};
-		std::unordered_map<std::string, Extension> extensions;
-		std::optional<Extras> extras;
+		typename Storage::Scalar xmag = {};
+		typename Storage::Scalar ymag = {};
+		typename Storage::Scalar zfar = {};
+		typename Storage::Scalar znear = {};
+		std::unordered_map<typename Storage::String, BasicExtension<Storage>> extensions;
+		std::optional<BasicExtras<Storage>> extras;
 	};
 
-	struct LG_EXPORT CameraPerspective
+	template<typename Storage>
+	struct LG_EXPORT BasicCameraPerspective
 	{
-		std::optional<double> aspectRatio;
-		double yfov = {};
-		std::optional<double> zfar;
-		double znear = {};
-		std::unordered_map<std::string, Extension> extensions;
-		std::optional<Extras> extras;
+		std::optional<typename Storage::Scalar> aspectRatio;
+		typename Storage::Scalar yfov = {};
+		std::optional<typename Storage::Scalar> zfar;
+		typename Storage::Scalar znear = {};
+		std::unordered_map<typename Storage::String, BasicExtension<Storage>> extensions;
+		std::optional<BasicExtras<Storage>> extras;
 	};
 
-	struct LG_EXPORT Camera
+	template<typename Storage>
+	struct LG_EXPORT BasicCamera
 	{
-		std::optional<CameraOrthographic> orthographic;
-		std::optional<CameraPerspective> perspective;
-		std::string type;
-		std::optional<std::string> name;
-		std::unordered_map<std::string, Extension> extensions;
-		std::optional<Extras> extras;
+		std::optional<BasicCameraOrthographic<Storage>> orthographic;
+		std::optional<BasicCameraPerspective<Storage>> perspective;
+		typename Storage::String type;
+		std::optional<typename Storage::String> name;
+		std::unordered_map<typename Storage::String, BasicExtension<Storage>> extensions;
+		std::optional<BasicExtras<Storage>> extras;
 	};
 
-	struct LG_EXPORT Image
+	template<typename Storage>
+	struct LG_EXPORT BasicImage
 	{
-		std::optional<std::string> uri;
-		std::optional<std::string> mimeType;
+		std::optional<typename Storage::String> uri;
+		std::optional<typename Storage::String> mimeType;
 		std::optional<std::uint32_t> bufferView;
-		std::optional<std::string> name;
-		std::unordered_map<std::string, Extension> extensions;
-		std::optional<Extras> extras;
+		std::optional<typename Storage::String> name;
+		std::unordered_map<typename Storage::String, BasicExtension<Storage>> extensions;
+		std::optional<BasicExtras<Storage>> extras;
 	};
 
-	struct LG_EXPORT TextureInfo
+	template<typename Storage>
+	struct LG_EXPORT BasicTextureInfo
 	{
 		std::uint32_t index = {};
 		std::uint32_t texCoord = 0;
-		std::unordered_map<std::string, Extension> extensions;
-		std::optional<Extras> extras;
+		std::unordered_map<typename Storage::String, BasicExtension<Storage>> extensions;
+		std::optional<BasicExtras<Storage>> extras;
 	};
 
-	struct LG_EXPORT MaterialNormalTexture
+	template<typename Storage>
+	struct LG_EXPORT BasicMaterialNormalTexture
 	{
 		std::uint32_t index = {};
 		std::uint32_t texCoord = 0;
-		double scale = 1.0;
-		std::unordered_map<std::string, Extension> extensions;
-		std::optional<Extras> extras;
+		typename Storage::Scalar scale = 1.0;
+		std::unordered_map<typename Storage::String, BasicExtension<Storage>> extensions;
+		std::optional<BasicExtras<Storage>> extras;
 	};
 
-	struct LG_EXPORT MaterialOcclusionTexture
+	template<typename Storage>
+	struct LG_EXPORT BasicMaterialOcclusionTexture
 	{
 		std::uint32_t index = {};
 		std::uint32_t texCoord = 0;
-		double strength = 1.0;
-		std::unordered_map<std::string, Extension> extensions;
-		std::optional<Extras> extras;
-	};
-
-	struct LG_EXPORT MaterialPbrMetallicRoughness
-	{
-		std::array<double, 4> baseColorFactor = {1.0, 1.0, 1.0, 1.0};
-		std::optional<TextureInfo> baseColorTexture;
-		double metallicFactor = 1.0;
-		double roughnessFactor = 1.0;
-		std::optional<TextureInfo> metallicRoughnessTexture;
-		std::unordered_map<std::string, Extension> extensions;
-		std::optional<Extras> extras;
-	};
-
-	struct LG_EXPORT Material
-	{
-		std::optional<std::string> name;
-		std::unordered_map<std::string, Extension> extensions;
-		std::optional<Extras> extras;
-		std::optional<MaterialPbrMetallicRoughness> pbrMetallicRoughness;
-		std::optional<MaterialNormalTexture> normalTexture;
-		std::optional<MaterialOcclusionTexture> occlusionTexture;
-		std::optional<TextureInfo> emissiveTexture;
-		std::array<double, 3> emissiveFactor = {0.0, 0.0, 0.0};
-		std::string alphaMode = "OPAQUE";
-		double alphaCutoff = 0.5;
+		typename Storage::Scalar strength = 1.0;
+		std::unordered_map<typename Storage::String, BasicExtension<Storage>> extensions;
+		std::optional<BasicExtras<Storage>> extras;
+	};
+
+	template<typename Storage>
+	struct LG_EXPORT BasicMaterialPbrMetallicRoughness
+	{
+		std::array<typename Storage::Scalar, 4> baseColorFactor = {1.0, 1.0, 1.0, 1.0};
+		std::optional<BasicTextureInfo<Storage>> baseColorTexture;
+		typename Storage::Scalar metallicFactor = 1.0;
+		typename Storage::Scalar roughnessFactor = 1.0;
+		std::optional<BasicTextureInfo<Storage>> metallicRoughnessTexture;
+		std::unordered_map<typename Storage::String, BasicExtension<Storage>> extensions;
+		std::optional<BasicExtras<Storage>> extras;
+	};
+
+	template<typename Storage>
+	struct LG_EXPORT BasicMaterial
+	{
+		std::optional<typename Storage::String> name;
+		std::unordered_map<typename Storage::String, BasicExtension<Storage>> extensions;
+		std::optional<BasicExtras<Storage>> extras;
+		std::optional<BasicMaterialPbrMetallicRoughness<Storage>> pbrMetallicRoughness;
+		std::optional<BasicMaterialNormalTexture<Storage>> normalTexture;
+		std::optional<BasicMaterialOcclusionTexture<Storage>> occlusionTexture;
+		std::optional<BasicTextureInfo<Storage>> emissiveTexture;
+		std::array<typename Storage::Scalar, 3> emissiveFactor = {0.0, 0.0, 0.0};
+		typename Storage::String alphaMode = "OPAQUE";
+		typename Storage::Scalar alphaCutoff = 0.5;
 		bool doubleSided = false;
 	};
 
-	struct LG_EXPORT MeshPrimitive
+	template<typename Storage>
+	struct LG_EXPORT BasicMeshPrimitive
 	{
-		std::unordered_map<std::string, std::uint32_t> attributes;
+		std::unordered_map<typename Storage::String, std::uint32_t> attributes;
 		std::optional<std::uint32_t> indices;
 		std::optional<std::uint32_t> material;
 		std::uint32_t mode = 4;
-		std::vector<std::uint32_t> targets;
-		std::unordered_map<std::string, Extension> extensions;
-		std::optional<Extras> extras;
+		/// Morph targets, each mapping attribute names to accessors with the displacements
+		std::vector<std::unordered_map<typename Storage::String, std::uint32_t>> targets;
+		std::unordered_map<typename Storage::String, BasicExtension<Storage>> extensions;
+		std::optional<BasicExtras<Storage>> extras;
 	};
 
-	struct LG_EXPORT Mesh
+	template<typename Storage>
+	struct LG_EXPORT BasicMesh
 	{
-		std::vector<MeshPrimitive> primitives;
-		std::vector<double> weights;
-		std::optional<std::string> name;
-		std::unordered_map<std::string, Extension> extensions;
-		std::optional<Extras> extras;
+		std::vector<BasicMeshPrimitive<Storage>> primitives;
+		std::vector<typename Storage::Scalar> weights;
+		std::optional<typename Storage::String> name;
+		std::unordered_map<typename Storage::String, BasicExtension<Storage>> extensions;
+		std::optional<BasicExtras<Storage>> extras;
 	};
 
-	struct LG_EXPORT Node
+	template<typename Storage>
+	struct LG_EXPORT BasicNode
 	{
 		std::optional<std::uint32_t> camera;
 		std::vector<std::uint32_t> children;
 		std::optional<std::uint32_t> skin;
-		std::array<double, 16> matrix = {
+		std::array<typename Storage::Scalar, 16> matrix = {
 			1.0, 0.0, 0.0, 0.0,
 			0.0, 1.0, 0.0, 0.0,
 			0.0, 0.0, 1.0, 0.0,
 			0.0, 0.0, 0.0, 1.0};
 		std::optional<std::uint32_t> mesh;
-		std::array<double, 4> rotation = {0.0, 0.0, 0.0, 1.0};
-		std::array<double, 3> scale = {1.0, 1.0, 1.0};
-		std::array<double, 3> translation = {0.0, 0.0, 0.0};
-		std::vector<double> weights;
-		std::optional<std::string> name;
-		std::unordered_map<std::string, Extension> extensions;
-		std::optional<Extras> extras;
+		std::array<typename Storage::Scalar, 4> rotation = {0.0, 0.0, 0.0, 1.0};
+		std::array<typename Storage::Scalar, 3> scale = {1.0, 1.0, 1.0};
+		std::array<typename Storage::Scalar, 3> translation = {0.0, 0.0, 0.0};
+		std::vector<typename Storage::Scalar> weights;
+		std::optional<typename Storage::String> name;
+		std::unordered_map<typename Storage::String, BasicExtension<Storage>> extensions;
+		std::optional<BasicExtras<Storage>> extras;
 	};
 
-	struct LG_EXPORT Sampler
+	template<typename Storage>
+	struct LG_EXPORT BasicSampler
 	{
 		std::optional<std::uint32_t> magFilter;
 		std::optional<std::uint32_t> minFilter;
 		std::uint32_t wrapS = 10497;
 		std::uint32_t wrapT = 10497;
-		std::optional<std::string> name;
-		std::unordered_map<std::string, Extension> extensions;
-		std::optional<Extras> extras;
+		std::optional<typename Storage::String> name;
+		std::unordered_map<typename Storage::String, BasicExtension<Storage>> extensions;
+		std::optional<BasicExtras<Storage>> extras;
 	};
 
-	struct LG_EXPORT Scene
+	template<typename Storage>
+	struct LG_EXPORT BasicScene
 	{
 		std::vector<std::uint32_t> nodes;
-		std::optional<std::string> name;
-		std::unordered_map<std::string, Extension> extensions;
-		std::optional<Extras> extras;
+		std::optional<typename Storage::String> name;
+		std::unordered_map<typename Storage::String, BasicExtension<Storage>> extensions;
+		std::optional<BasicExtras<Storage>> extras;
 	};
 
-	struct LG_EXPORT Skin
+	template<typename Storage>
+	struct LG_EXPORT BasicSkin
 	{
 		std::optional<std::uint32_t> inverseBindMatrices;
 		std::optional<std::uint32_t> skeleton;
 		std::vector<std::uint32_t> joints;
-		std::optional<std::string> name;
-		std::unordered_map<std::string, Extension> extensions;
-		std::optional<Extras> extras;
+		std::optional<typename Storage::String> name;
+		std::unordered_map<typename Storage::String, BasicExtension<Storage>> extensions;
+		std::optional<BasicExtras<Storage>> extras;
 	};
 
-	struct LG_EXPORT Texture
+	template<typename Storage>
+	struct LG_EXPORT BasicTexture
 	{
 		std::optional<std::uint32_t> sampler;
 		std::optional<std::uint32_t> source;
-		std::optional<std::string> name;
-		std::unordered_map<std::string, Extension> extensions;
-		std::optional<Extras> extras;
-	};
-
-	struct LG_EXPORT Gltf
-	{
-		std::vector<std::string> extensionsUsed;
-		std::vector<std::string> extensionsRequired;
-		std::vector<Accessor> accessors;
-		std::vector<Animation> animations;
-		Asset asset;
-		std::vector<Buffer> buffers;
-		std::vector<BufferView> bufferViews;
-		std::vector<Camera> cameras;
-		std::vector<Image> images;
-		std::vector<Material> materials;
-		std::vector<Mesh> meshes;
-		std::vector<Node> nodes;
-		std::vector<Sampler> samplers;
+		std::optional<typename Storage::String> name;
+		std::unordered_map<typename Storage::String, BasicExtension<Storage>> extensions;
+		std::optional<BasicExtras<Storage>> extras;
+	};
+
+	template<typename Storage>
+	struct LG_EXPORT BasicGltf
+	{
+		std::vector<typename Storage::String> extensionsUsed;
+		std::vector<typename Storage::String> extensionsRequired;
+		std::vector<BasicAccessor<Storage>> accessors;
+		std::vector<BasicAnimation<Storage>> animations;
+		BasicAsset<Storage> asset;
+		std::vector<BasicBuffer<Storage>> buffers;
+		std::vector<BasicBufferView<Storage>> bufferViews;
+		std::vector<BasicCamera<Storage>> cameras;
+		std::vector<BasicImage<Storage>> images;
+		std::vector<BasicMaterial<Storage>> materials;
+		std::vector<BasicMesh<Storage>> meshes;
+		std::vector<BasicNode<Storage>> nodes;
+		std::vector<BasicSampler<Storage>> samplers;
 		std::optional<std::uint32_t> scene;
-		std::vector<Scene> scenes;
-		std::vector<Skin> skins;
-		std::vector<Texture> textures;
-		std::unordered_map<std::string, Extension> extensions;
-		std::optional<Extras> extras;
+		std::vector<BasicScene<Storage>> scenes;
+		std::vector<BasicSkin<Storage>> skins;
+		std::vector<BasicTexture<Storage>> textures;
+		std::unordered_map<typename Storage::String, BasicExtension<Storage>> extensions;
+		std::optional<BasicExtras<Storage>> extras;
+		[[no_unique_address]] typename Storage::StringArena stringArena;
 	};
+
+	using Extension = BasicExtension<OwningStorage>;
+	using Extras = BasicExtras<OwningStorage>;
+	using AccessorSparseIndices = BasicAccessorSparseIndices<OwningStorage>;
+	using AccessorSparseValues = BasicAccessorSparseValues<OwningStorage>;
+	using AccessorSparse = BasicAccessorSparse<OwningStorage>;
+	using Accessor = BasicAccessor<OwningStorage>;
+	using AnimationChannelTarget = BasicAnimationChannelTarget<OwningStorage>;
+	using AnimationChannel = BasicAnimationChannel<OwningStorage>;
+	using AnimationSampler = BasicAnimationSampler<OwningStorage>;
+	using Animation = BasicAnimation<OwningStorage>;
+	using Asset = BasicAsset<OwningStorage>;
+	using Buffer = BasicBuffer<OwningStorage>;
+	using MeshoptCompression = BasicMeshoptCompression<OwningStorage>;
+	using BufferView = BasicBufferView<OwningStorage>;
+	using CameraOrthographic = BasicCameraOrthographic<OwningStorage>;
+	using CameraPerspective = BasicCameraPerspective<OwningStorage>;
+	using Camera = BasicCamera<OwningStorage>;
+	using Image = BasicImage<OwningStorage>;
+	using TextureInfo = BasicTextureInfo<OwningStorage>;
+	using MaterialNormalTexture = BasicMaterialNormalTexture<OwningStorage>;
+	using MaterialOcclusionTexture = BasicMaterialOcclusionTexture<OwningStorage>;
+	using MaterialPbrMetallicRoughness = BasicMaterialPbrMetallicRoughness<OwningStorage>;
+	using Material = BasicMaterial<OwningStorage>;
+	using MeshPrimitive = BasicMeshPrimitive<OwningStorage>;
+	using Mesh = BasicMesh<OwningStorage>;
+	using Node = BasicNode<OwningStorage>;
+	using Sampler = BasicSampler<OwningStorage>;
+	using Scene = BasicScene<OwningStorage>;
+	using Skin = BasicSkin<OwningStorage>;
+	using Texture = BasicTexture<OwningStorage>;
+	using Gltf = BasicGltf<OwningStorage>;
+
+	using BorrowedGltf = BasicGltf<BorrowingStorage>;
+
+	using FloatGltf = BasicGltf<FloatStorage>;
 }
@@ -0,0 +1,47 @@
+// SPDX-License-Identifier: MIT
+// Copyright © 2022 Sebastian Larsson
+
+#pragma once
+
+#include <load-gltf/defs.hpp>
+#include <load-gltf/hierarchy.hpp>
+#include <load-gltf/structs.hpp>
+
+#include <array>
+#include <vector>
+
+namespace lg {
+	/**
+	 * 4x4 matrix in column-major order, as in glTF
+	 */
+	using Matrix4 = std::array<double, 16>;
+
+	constexpr Matrix4 identityMatrix = {
+		1.0, 0.0, 0.0, 0.0,
+		0.0, 1.0, 0.0, 0.0,
+		0.0, 0.0, 1.0, 0.0,
+		0.0, 0.0, 0.0, 1.0};
+
+	LG_EXPORT Matrix4 multiply(Matrix4 const& a, Matrix4 const& b) noexcept;
+
+	/**
+	 * @return the transform of a node relative to its parent, from either its matrix or its translation, rotation and
+	 * scale
+	 */
+	LG_EXPORT Matrix4 localTransform(Node const& node) noexcept;
+
+	LG_EXPORT Matrix4 localTransform(BasicNode<BorrowingStorage> const& node) noexcept;
+
+	LG_EXPORT Matrix4 localTransform(BasicNode<FloatStorage> const& node) noexcept;
+
+	/**
+	 * Calculate the transform of every node relative to the scene
+	 *
+	 * Nodes that are not part of the hierarchy order, i.e. nodes in or below a cycle, get their local transform.
+	 */
+	LG_EXPORT std::vector<Matrix4> computeWorldTransforms(Gltf const& gltf, NodeHierarchy const& hierarchy);
+
+	LG_EXPORT std::vector<Matrix4> computeWorldTransforms(BorrowedGltf const& gltf, NodeHierarchy const& hierarchy);
+
+	LG_EXPORT std::vector<Matrix4> computeWorldTransforms(FloatGltf const& gltf, NodeHierarchy const& hierarchy);
+}
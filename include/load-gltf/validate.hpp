@@ -0,0 +1,45 @@
+// SPDX-License-Identifier: MIT
+// Copyright © 2022 Sebastian Larsson
+
+#pragma once
+
+#include <load-gltf/defs.hpp>
+#include <load-gltf/structs.hpp>
+
+#include <string>
+#include <vector>
+
+namespace lg {
+	struct LG_EXPORT ValidationOptions
+	{
+		/// Check that every index refers to an existing element
+		bool checkReferences = true;
+		/// Check that buffer views and accessors fit within the data they reference
+		bool checkRanges = true;
+		/// Check that the nodes form disjoint trees, and that scenes only reference root nodes
+		bool checkNodeHierarchy = true;
+		/// Validate the sections of the document concurrently, when the document is large enough to benefit
+		bool parallel = true;
+	};
+
+	struct LG_EXPORT ValidationError
+	{
+		/// JSON pointer to the offending property, e.g. "/nodes/3/children/1"
+		std::string path;
+		std::string message;
+	};
+
+	/**
+	 * Validate the consistency of a loaded document
+	 *
+	 * All errors are collected instead of stopping at the first one. They are ordered by section, and by position
+	 * within each section.
+	 *
+	 * @return all errors found, empty if the document is valid
+	 */
+	LG_EXPORT std::vector<ValidationError> validate(Gltf const& gltf, ValidationOptions const& options = {});
+
+	LG_EXPORT std::vector<ValidationError> validate(BorrowedGltf const& gltf, ValidationOptions const& options = {});
+
+	LG_EXPORT std::vector<ValidationError> validate(FloatGltf const& gltf, ValidationOptions const& options = {});
+}
@@ -0,0 +1,339 @@
+// SPDX-License-Identifier: MIT
+// Copyright © 2022 Sebastian Larsson
+
+#include <load-gltf/accessor.hpp>
+
+#include <load-gltf/structs.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+namespace {
+	template<typename Type>
+	Type load(std::byte const* data) noexcept
+	{
+		Type value;
+		std::memcpy(&value, data, sizeof(Type));
+		return value;
+	}
+
+	/**
+	 * Position of the components within an element
+	 */
+	struct ElementLayout
+	{
+		std::uint32_t columns = {};
+		std::uint32_t rows = {};
+		std::uint32_t columnSize = {};
+	};
+
+	ElementLayout elementLayout(std::string_view type, std::uint32_t componentType)
+	{
+		std::uint32_t const size = lg::componentSize(componentType);
+		std::uint32_t const count = lg::componentCount(type);
+		if (count == 0)
+		{
+			return {};
+		}
+		if (type.starts_with("MAT"))
+		{
+			std::uint32_t const rows = count == 4 ? 2 : count == 9 ? 3 : 4;
+			return {rows, rows, (rows * size + 3) / 4 * 4};
+		}
+		return {1, count, count * size};
+	}
+
+	template<typename Storage>
+	lg::BufferData bufferViewData(lg::BasicGltf<Storage> const& gltf, std::span<lg::BufferData const> buffers,
+		std::uint32_t bufferViewIndex)
+	{
+		if (bufferViewIndex >= gltf.bufferViews.size())
+		{
+			throw std::out_of_range("Buffer view index out of range");
+		}
+		auto const& bufferView = gltf.bufferViews[bufferViewIndex];
+		if (bufferView.buffer >= buffers.size())
+		{
+			throw std::out_of_range("Buffer index out of range");
+		}
+		lg::BufferData const buffer = buffers[bufferView.buffer];
+		if (std::uint64_t{bufferView.byteOffset} + bufferView.byteLength > buffer.size())
+		{
+			throw std::out_of_range("Buffer view exceeds its buffer");
+		}
+		return buffer.subspan(bufferView.byteOffset, bufferView.byteLength);
+	}
+
+	std::uint32_t loadUint(std::byte const* data, std::uint32_t componentType)
+	{
+		switch (componentType)
+		{
+			case 5121:
+				return load<std::uint8_t>(data);
+			case 5123:
+				return load<std::uint16_t>(data);
+			case 5125:
+				return load<std::uint32_t>(data);
+			default:
+				throw std::invalid_argument("Not an unsigned integer component type");
+		}
+	}
+
+	float loadFloat(std::byte const* data, std::uint32_t componentType, bool normalized)
+	{
+		switch (componentType)
+		{
+			case 5120:
+			{
+				float const value = load<std::int8_t>(data);
+				return normalized ? std::max(value / 127.0f, -1.0f) : value;
+			}
+			case 5121:
+			{
+				float const value = load<std::uint8_t>(data);
+				return normalized ? value / 255.0f : value;
+			}
+			case 5122:
+			{
+				float const value = load<std::int16_t>(data);
+				return normalized ? std::max(value / 32767.0f, -1.0f) : value;
+			}
+			case 5123:
+			{
+				float const value = load<std::uint16_t>(data);
+				return normalized ? value / 65535.0f : value;
+			}
+			case 5125:
+				return static_cast<float>(load<std::uint32_t>(data));
+			case 5126:
+				return load<float>(data);
+			default:
+				throw std::invalid_argument("Unknown component type");
+		}
+	}
+
+	template<typename Storage>
+	std::vector<std::byte> readData(lg::BasicGltf<Storage> const& gltf, std::span<lg::BufferData const> buffers,
+		std::uint32_t accessorIndex)
+	{
+		if (accessorIndex >= gltf.accessors.size())
+		{
+			throw std::out_of_range("Accessor index out of range");
+		}
+		auto const& accessor = gltf.accessors[accessorIndex];
+		std::uint32_t const size = lg::elementSize(accessor.type, accessor.componentType);
+		if (size == 0)
+		{
+			throw std::invalid_argument("Unknown accessor layout");
+		}
+
+		std::vector<std::byte> result(std::size_t{size} * accessor.count);
+		if (accessor.bufferView && accessor.count > 0)
+		{
+			lg::BufferData const data = bufferViewData(gltf, buffers, *accessor.bufferView);
+			std::uint64_t const stride = gltf.bufferViews[*accessor.bufferView].byteStride.value_or(size);
+			if (accessor.byteOffset + stride * (accessor.count - 1) + size > data.size())
+			{
+				throw std::out_of_range("Accessor exceeds its buffer view");
+			}
+
+			std::byte const* source = data.data() + accessor.byteOffset;
+			if (stride == size)
+			{
+				std::memcpy(result.data(), source, result.size());
+			}
+			else
+			{
+				for (std::size_t i = 0; i < accessor.count; ++i)
+				{
+					std::memcpy(result.data() + i * size, source + i * stride, size);
+				}
+			}
+		}
+
+		if (accessor.sparse)
+		{
+			auto const& sparse = *accessor.sparse;
+			std::uint32_t const indexSize = lg::componentSize(sparse.indices.componentType);
+			lg::BufferData const indexData = bufferViewData(gltf, buffers, sparse.indices.bufferView);
+			lg::BufferData const valueData = bufferViewData(gltf, buffers, sparse.values.bufferView);
+			if (sparse.indices.byteOffset + std::uint64_t{indexSize} * sparse.count > indexData.size()
+				|| sparse.values.byteOffset + std::uint64_t{size} * sparse.count > valueData.size())
+			{
+				throw std::out_of_range("Sparse accessor exceeds its buffer views");
+			}
+
+			for (std::size_t i = 0; i < sparse.count; ++i)
+			{
+				std::uint32_t const target = loadUint(
+					indexData.data() + sparse.indices.byteOffset + i * indexSize, sparse.indices.componentType);
+				if (target >= accessor.count)
+				{
+					throw std::out_of_range("Sparse accessor index out of range");
+				}
+				std::memcpy(result.data() + std::size_t{target} * size,
+					valueData.data() + sparse.values.byteOffset + i * size, size);
+			}
+		}
+
+		return result;
+	}
+
+	/**
+	 * Read every component of an accessor, in element, column, row order, skipping matrix column padding
+	 */
+	template<typename Component, typename Storage, typename LoadComponent>
+	std::vector<Component> readComponents(lg::BasicGltf<Storage> const& gltf, std::span<lg::BufferData const> buffers,
+		std::uint32_t accessorIndex, LoadComponent const& loadComponent)
+	{
+		std::vector<std::byte> const data = readData(gltf, buffers, accessorIndex);
+		auto const& accessor = gltf.accessors[accessorIndex];
+		ElementLayout const layout = elementLayout(accessor.type, accessor.componentType);
+		std::uint32_t const size = lg::componentSize(accessor.componentType);
+		std::uint32_t const stride = layout.columns * layout.columnSize;
+
+		std::vector<Component> result;
+		result.reserve(std::size_t{accessor.count} * layout.columns * layout.rows);
+		for (std::size_t element = 0; element < accessor.count; ++element)
+		{
+			for (std::uint32_t column = 0; column < layout.columns; ++column)
+			{
+				std::byte const* columnData = data.data() + element * stride + column * layout.columnSize;
+				for (std::uint32_t row = 0; row < layout.rows; ++row)
+				{
+					result.push_back(loadComponent(columnData + row * size));
+				}
+			}
+		}
+		return result;
+	}
+
+	template<typename Storage>
+	std::vector<float> readFloats(lg::BasicGltf<Storage> const& gltf, std::span<lg::BufferData const> buffers,
+		std::uint32_t accessorIndex)
+	{
+		if (accessorIndex >= gltf.accessors.size())
+		{
+			throw std::out_of_range("Accessor index out of range");
+		}
+		auto const& accessor = gltf.accessors[accessorIndex];
+		return readComponents<float>(gltf, buffers, accessorIndex,
+			[componentType = accessor.componentType, normalized = accessor.normalized](std::byte const* data)
+			{
+				return loadFloat(data, componentType, normalized);
+			});
+	}
+
+	template<typename Storage>
+	std::vector<std::uint32_t> readUints(lg::BasicGltf<Storage> const& gltf, std::span<lg::BufferData const> buffers,
+		std::uint32_t accessorIndex)
+	{
+		if (accessorIndex >= gltf.accessors.size())
+		{
+			throw std::out_of_range("Accessor index out of range");
+		}
+		std::uint32_t const componentType = gltf.accessors[accessorIndex].componentType;
+		if (componentType != 5121 && componentType != 5123 && componentType != 5125)
+		{
+			throw std::invalid_argument("Not an unsigned integer component type");
+		}
+		return readComponents<std::uint32_t>(gltf, buffers, accessorIndex,
+			[componentType](std::byte const* data)
+			{
+				return loadUint(data, componentType);
+			});
+	}
+}
+
+std::uint32_t lg::componentSize(std::uint32_t componentType) noexcept
+{
+	switch (componentType)
+	{
+		case 5120: // BYTE
+		case 5121: // UNSIGNED_BYTE
+			return 1;
+		case 5122: // SHORT
+		case 5123: // UNSIGNED_SHORT
+			return 2;
+		case 5125: // UNSIGNED_INT
+		case 5126: // FLOAT
+			return 4;
+		default:
+			return 0;
+	}
+}
+
+std::uint32_t lg::componentCount(std::string_view type) noexcept
+{
+	if (type == "SCALAR") return 1;
+	if (type == "VEC2") return 2;
+	if (type == "VEC3") return 3;
+	if (type == "VEC4") return 4;
+	if (type == "MAT2") return 4;
+	if (type == "MAT3") return 9;
+	if (type == "MAT4") return 16;
+	return 0;
+}
+
+std::uint32_t lg::elementSize(std::string_view type, std::uint32_t componentType) noexcept
+{
+	ElementLayout const layout = elementLayout(type, componentType);
+	return layout.columns * layout.columnSize;
+}
+
+std::vector<std::byte> lg::readAccessorData(lg::Gltf const& gltf, std::span<lg::BufferData const> buffers,
+	std::uint32_t accessor)
+{
+	return readData(gltf, buffers, accessor);
+}
+
+std::vector<std::byte> lg::readAccessorData(lg::BorrowedGltf const& gltf, std::span<lg::BufferData const> buffers,
+	std::uint32_t accessor)
+{
+	return readData(gltf, buffers, accessor);
+}
+
+std::vector<std::byte> lg::readAccessorData(lg::FloatGltf const& gltf, std::span<lg::BufferData const> buffers,
+	std::uint32_t accessor)
+{
+	return readData(gltf, buffers, accessor);
+}
+
+std::vector<float> lg::readAccessorFloats(lg::Gltf const& gltf, std::span<lg::BufferData const> buffers,
+	std::uint32_t accessor)
+{
+	return readFloats(gltf, buffers, accessor);
+}
+
+std::vector<float> lg::readAccessorFloats(lg::BorrowedGltf const& gltf, std::span<lg::BufferData const> buffers,
+	std::uint32_t accessor)
+{
+	return readFloats(gltf, buffers, accessor);
+}
+
+std::vector<float> lg::readAccessorFloats(lg::FloatGltf const& gltf, std::span<lg::BufferData const> buffers,
+	std::uint32_t accessor)
+{
+	return readFloats(gltf, buffers, accessor);
+}
+
+std::vector<std::uint32_t> lg::readAccessorUints(lg::Gltf const& gltf, std::span<lg::BufferData const> buffers,
+	std::uint32_t accessor)
+{
+	return readUints(gltf, buffers, accessor);
+}
+
+std::vector<std::uint32_t> lg::readAccessorUints(lg::BorrowedGltf const& gltf,
+	std::span<lg::BufferData const> buffers, std::uint32_t accessor)
+{
+	return readUints(gltf, buffers, accessor);
+}
+
+std::vector<std::uint32_t> lg::readAccessorUints(lg::FloatGltf const& gltf,
+	std::span<lg::BufferData const> buffers, std::uint32_t accessor)
+{
+	return readUints(gltf, buffers, accessor);
+}
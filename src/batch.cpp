@@ -0,0 +1,187 @@
+// SPDX-License-Identifier: MIT
+// Copyright © 2022 Sebastian Larsson
+
+#include <load-gltf/batch.hpp>
+
+#include <load-gltf/hierarchy.hpp>
+#include <load-gltf/structs.hpp>
+#include <load-gltf/transform.hpp>
+
+#include "parallel.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+
+namespace {
+	/// Fewest instances worth gathering on a separate thread
+	constexpr std::size_t minimumTaskSize = std::size_t{1} << 14;
+
+	lg::InstanceTransform toInstanceTransform(lg::Matrix4 const& matrix) noexcept
+	{
+		lg::InstanceTransform result;
+		for (std::size_t i = 0; i < matrix.size(); ++i)
+		{
+			result[i] = static_cast<float>(matrix[i]);
+		}
+		return result;
+	}
+
+	void checkWorldTransforms(lg::DrawBatches const& batches, std::span<lg::Matrix4 const> worldTransforms)
+	{
+		if (worldTransforms.size() != batches.nodeInstances.size())
+		{
+			throw std::invalid_argument("There must be a world transform for every node");
+		}
+	}
+
+	/**
+	 * Store the transform of every instance, in node order so that the world transforms are read sequentially
+	 */
+	void gatherTransforms(lg::DrawBatches& batches, std::span<lg::Matrix4 const> worldTransforms, bool parallel)
+	{
+		batches.instanceTransforms.resize(batches.instanceNodes.size());
+		lg::detail::forEachRange(batches.nodeInstances.size(), minimumTaskSize, parallel,
+			[&batches, worldTransforms](std::size_t begin, std::size_t end)
+		{
+			for (std::size_t node = begin; node < end; ++node)
+			{
+				std::uint32_t const instance = batches.nodeInstances[node];
+				if (instance != lg::noIndex)
+				{
+					batches.instanceTransforms[instance] = toInstanceTransform(worldTransforms[node]);
+				}
+			}
+		});
+	}
+
+	template<typename Storage>
+	lg::DrawBatches drawBatches(lg::BasicGltf<Storage> const& gltf, lg::NodeHierarchy const& hierarchy,
+		std::span<lg::Matrix4 const> worldTransforms, std::uint32_t scene, lg::DrawBatchOptions const& options)
+	{
+		if (scene >= gltf.scenes.size() || scene >= hierarchy.sceneRoots.size())
+		{
+			throw std::out_of_range("Scene index out of range");
+		}
+		if (worldTransforms.size() != gltf.nodes.size())
+		{
+			throw std::invalid_argument("There must be a world transform for every node");
+		}
+		if (hierarchy.parents.size() != gltf.nodes.size())
+		{
+			throw std::invalid_argument("The hierarchy must be of the same document");
+		}
+
+		// Mark the nodes of the scene by passing the marks of its roots down the hierarchy, in which parents come
+		// before their children
+		std::vector<std::uint8_t> inScene(gltf.nodes.size(), 0);
+		for (std::uint32_t root: hierarchy.sceneRoots[scene])
+		{
+			inScene[root] = 1;
+		}
+		for (std::uint32_t node: hierarchy.order)
+		{
+			std::uint32_t const parent = hierarchy.parents[node];
+			if (parent != lg::noIndex)
+			{
+				inScene[node] = inScene[parent];
+			}
+		}
+
+		// Group the instances by mesh with a counting sort, reading the nodes once in order
+		std::vector<std::uint32_t> nodeMeshes(gltf.nodes.size(), lg::noIndex);
+		std::vector<std::uint32_t> meshOffsets(gltf.meshes.size() + 1, 0);
+		for (std::uint32_t node = 0; node < gltf.nodes.size(); ++node)
+		{
+			auto const& mesh = gltf.nodes[node].mesh;
+			if (inScene[node] && mesh && *mesh < gltf.meshes.size())
+			{
+				nodeMeshes[node] = *mesh;
+				++meshOffsets[*mesh + 1];
+			}
+		}
+		std::partial_sum(meshOffsets.begin(), meshOffsets.end(), meshOffsets.begin());
+
+		lg::DrawBatches result;
+		std::vector<std::uint32_t> nextInstances(meshOffsets.begin(), meshOffsets.end() - 1);
+		result.instanceNodes.resize(meshOffsets.back());
+		result.nodeInstances.assign(gltf.nodes.size(), lg::noIndex);
+		for (std::uint32_t node = 0; node < gltf.nodes.size(); ++node)
+		{
+			if (nodeMeshes[node] != lg::noIndex)
+			{
+				std::uint32_t const instance = nextInstances[nodeMeshes[node]]++;
+				result.instanceNodes[instance] = node;
+				result.nodeInstances[node] = instance;
+			}
+		}
+
+		for (std::uint32_t mesh = 0; mesh < gltf.meshes.size(); ++mesh)
+		{
+			std::uint32_t const instanceCount = meshOffsets[mesh + 1] - meshOffsets[mesh];
+			auto const& primitives = gltf.meshes[mesh].primitives;
+			for (std::uint32_t primitive = 0; instanceCount != 0 && primitive < primitives.size(); ++primitive)
+			{
+				result.batches.push_back({primitives[primitive].material.value_or(lg::noIndex), mesh, primitive,
+					meshOffsets[mesh], instanceCount});
+			}
+		}
+		std::sort(result.batches.begin(), result.batches.end(), [](lg::DrawBatch const& lhs, lg::DrawBatch const& rhs)
+		{
+			return std::tie(lhs.material, lhs.mesh, lhs.primitive) < std::tie(rhs.material, rhs.mesh, rhs.primitive);
+		});
+
+		gatherTransforms(result, worldTransforms, options.parallel);
+		return result;
+	}
+}
+
+lg::DrawBatches lg::buildDrawBatches(lg::Gltf const& gltf, lg::NodeHierarchy const& hierarchy,
+	std::span<lg::Matrix4 const> worldTransforms, std::uint32_t scene, lg::DrawBatchOptions const& options)
+{
+	return drawBatches(gltf, hierarchy, worldTransforms, scene, options);
+}
+
+lg::DrawBatches lg::buildDrawBatches(lg::BorrowedGltf const& gltf, lg::NodeHierarchy const& hierarchy,
+	std::span<lg::Matrix4 const> worldTransforms, std::uint32_t scene, lg::DrawBatchOptions const& options)
+{
+	return drawBatches(gltf, hierarchy, worldTransforms, scene, options);
+}
+
+lg::DrawBatches lg::buildDrawBatches(lg::FloatGltf const& gltf, lg::NodeHierarchy const& hierarchy,
+	std::span<lg::Matrix4 const> worldTransforms, std::uint32_t scene, lg::DrawBatchOptions const& options)
+{
+	return drawBatches(gltf, hierarchy, worldTransforms, scene, options);
+}
+
+void lg::updateDrawBatches(lg::DrawBatches& batches, std::span<lg::Matrix4 const> worldTransforms,
+	lg::DrawBatchOptions const& options)
+{
+	checkWorldTransforms(batches, worldTransforms);
+	gatherTransforms(batches, worldTransforms, options.parallel);
+}
+
+void lg::updateDrawBatches(lg::DrawBatches& batches, std::span<lg::Matrix4 const> worldTransforms,
+	std::span<std::uint32_t const> changedNodes)
+{
+	checkWorldTransforms(batches, worldTransforms);
+	// Check every node before writing, so that the batches are left unchanged if one is out of range
+	if (std::any_of(changedNodes.begin(), changedNodes.end(), [&batches](std::uint32_t node)
+	{
+		return node >= batches.nodeInstances.size();
+	}))
+	{
+		throw std::out_of_range("Node index out of range");
+	}
+	for (std::uint32_t node: changedNodes)
+	{
+		std::uint32_t const instance = batches.nodeInstances[node];
+		if (instance != lg::noIndex)
+		{
+			batches.instanceTransforms[instance] = toInstanceTransform(worldTransforms[node]);
+		}
+	}
+}
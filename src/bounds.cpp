@@ -0,0 +1,359 @@
+// SPDX-License-Identifier: MIT
+// Copyright © 2022 Sebastian Larsson
+
+#include <load-gltf/bounds.hpp>
+
+#include <load-gltf/accessor.hpp>
+#include <load-gltf/hierarchy.hpp>
+#include <load-gltf/structs.hpp>
+#include <load-gltf/transform.hpp>
+
+#include "parallel.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#define LG_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace {
+	using Vector3 = std::array<double, 3>;
+
+	double distanceSquared(Vector3 const& a, Vector3 const& b) noexcept
+	{
+		double const x = a[0] - b[0];
+		double const y = a[1] - b[1];
+		double const z = a[2] - b[2];
+		return x * x + y * y + z * z;
+	}
+
+	void extend(lg::Aabb& box, lg::Aabb const& other) noexcept
+	{
+		for (std::size_t k = 0; k < 3; ++k)
+		{
+			box.min[k] = std::min(box.min[k], other.min[k]);
+			box.max[k] = std::max(box.max[k], other.max[k]);
+		}
+	}
+
+	/**
+	 * Map accessor min or max values to the floats the components are read as
+	 */
+	double normalize(double value, std::uint32_t componentType) noexcept
+	{
+		switch (componentType)
+		{
+			case 5120:
+				return std::max(value / 127.0, -1.0);
+			case 5121:
+				return value / 255.0;
+			case 5122:
+				return std::max(value / 32767.0, -1.0);
+			case 5123:
+				return value / 65535.0;
+			default:
+				return value;
+		}
+	}
+
+	/**
+	 * Extend a box by tightly packed three component positions
+	 */
+	void extend(lg::Aabb& box, std::span<float const> positions) noexcept
+	{
+		constexpr float infinity = std::numeric_limits<float>::infinity();
+		std::array<float, 3> minimum = {infinity, infinity, infinity};
+		std::array<float, 3> maximum = {-infinity, -infinity, -infinity};
+		std::size_t i = 0;
+#ifdef LG_SSE2
+		if (positions.size() >= 12)
+		{
+			// Four positions fill three registers, each with the components in a fixed order: xyzx, yzxy and zxyz
+			__m128 minima[3] = {_mm_set1_ps(infinity), _mm_set1_ps(infinity), _mm_set1_ps(infinity)};
+			__m128 maxima[3] = {_mm_set1_ps(-infinity), _mm_set1_ps(-infinity), _mm_set1_ps(-infinity)};
+			for (; i + 12 <= positions.size(); i += 12)
+			{
+				for (std::size_t r = 0; r < 3; ++r)
+				{
+					__m128 const values = _mm_loadu_ps(positions.data() + i + r * 4);
+					minima[r] = _mm_min_ps(minima[r], values);
+					maxima[r] = _mm_max_ps(maxima[r], values);
+				}
+			}
+
+			alignas(16) std::array<float, 12> lanes;
+			for (std::size_t r = 0; r < 3; ++r)
+			{
+				_mm_store_ps(lanes.data() + r * 4, minima[r]);
+			}
+			for (std::size_t lane = 0; lane < 12; ++lane)
+			{
+				minimum[lane % 3] = std::min(minimum[lane % 3], lanes[lane]);
+			}
+			for (std::size_t r = 0; r < 3; ++r)
+			{
+				_mm_store_ps(lanes.data() + r * 4, maxima[r]);
+			}
+			for (std::size_t lane = 0; lane < 12; ++lane)
+			{
+				maximum[lane % 3] = std::max(maximum[lane % 3], lanes[lane]);
+			}
+		}
+#endif
+		for (; i + 3 <= positions.size(); i += 3)
+		{
+			for (std::size_t k = 0; k < 3; ++k)
+			{
+				minimum[k] = std::min(minimum[k], positions[i + k]);
+				maximum[k] = std::max(maximum[k], positions[i + k]);
+			}
+		}
+
+		for (std::size_t k = 0; k < 3; ++k)
+		{
+			box.min[k] = std::min(box.min[k], double{minimum[k]});
+			box.max[k] = std::max(box.max[k], double{maximum[k]});
+		}
+	}
+
+	template<typename Storage>
+	bool hasBounds(lg::BasicAccessor<Storage> const& accessor) noexcept
+	{
+		return accessor.min.size() == 3 && accessor.max.size() == 3;
+	}
+
+	/**
+	 * @return whether the bounds of a mesh have to be calculated from position data, rather than accessor bounds
+	 */
+	template<typename Storage>
+	bool readsPositions(lg::BasicGltf<Storage> const& gltf, lg::BasicMesh<Storage> const& mesh) noexcept
+	{
+		return std::any_of(mesh.primitives.begin(), mesh.primitives.end(), [&gltf](auto const& primitive)
+		{
+			auto const position = primitive.attributes.find("POSITION");
+			return position != primitive.attributes.end() && position->second < gltf.accessors.size()
+				&& !hasBounds(gltf.accessors[position->second]);
+		});
+	}
+
+	template<typename Storage>
+	lg::Bounds meshBounds(lg::BasicGltf<Storage> const& gltf, std::span<lg::BufferData const> buffers,
+		lg::BasicMesh<Storage> const& mesh)
+	{
+		lg::Bounds result;
+		std::vector<lg::Aabb> primitiveBoxes;
+		std::vector<std::vector<float>> primitivePositions;
+		for (auto const& primitive: mesh.primitives)
+		{
+			auto const position = primitive.attributes.find("POSITION");
+			if (position == primitive.attributes.end())
+			{
+				continue;
+			}
+			if (position->second >= gltf.accessors.size())
+			{
+				throw std::out_of_range("Accessor index out of range");
+			}
+			auto const& accessor = gltf.accessors[position->second];
+			if (accessor.type != "VEC3")
+			{
+				throw std::invalid_argument("POSITION accessor is not VEC3");
+			}
+
+			if (hasBounds(accessor))
+			{
+				lg::Aabb& box = primitiveBoxes.emplace_back();
+				for (std::size_t k = 0; k < 3; ++k)
+				{
+					box.min[k] = accessor.normalized ? normalize(accessor.min[k], accessor.componentType)
+						: accessor.min[k];
+					box.max[k] = accessor.normalized ? normalize(accessor.max[k], accessor.componentType)
+						: accessor.max[k];
+				}
+				extend(result.box, box);
+			}
+			else
+			{
+				std::vector<float> const& positions = primitivePositions.emplace_back(
+					lg::readAccessorFloats(gltf, buffers, position->second));
+				extend(result.box, positions);
+			}
+		}
+		if (result.box.isEmpty())
+		{
+			return result;
+		}
+
+		// The farthest point from the center of the box, either a corner of a primitive box, or a position
+		Vector3& center = result.sphere.center;
+		for (std::size_t k = 0; k < 3; ++k)
+		{
+			center[k] = (result.box.min[k] + result.box.max[k]) * 0.5;
+		}
+		double radiusSquared = 0.0;
+		for (lg::Aabb const& box: primitiveBoxes)
+		{
+			Vector3 corner;
+			for (std::size_t k = 0; k < 3; ++k)
+			{
+				corner[k] = center[k] - box.min[k] > box.max[k] - center[k] ? box.min[k] : box.max[k];
+			}
+			radiusSquared = std::max(radiusSquared, distanceSquared(corner, center));
+		}
+		for (std::vector<float> const& positions: primitivePositions)
+		{
+			for (std::size_t i = 0; i + 3 <= positions.size(); i += 3)
+			{
+				radiusSquared = std::max(radiusSquared,
+					distanceSquared({positions[i], positions[i + 1], positions[i + 2]}, center));
+			}
+		}
+		result.sphere.radius = std::sqrt(radiusSquared);
+		return result;
+	}
+
+	template<typename Storage>
+	lg::DocumentBounds documentBounds(lg::BasicGltf<Storage> const& gltf, std::span<lg::BufferData const> buffers,
+		lg::BoundsOptions const& options)
+	{
+		lg::DocumentBounds result;
+
+		// Bounds taken from accessors are not worth a thread, so only go parallel when position data has to be read.
+		// Meshes then differ a lot in size, so every task takes the next mesh when done with one.
+		bool const parallel = options.parallel && std::any_of(gltf.meshes.begin(), gltf.meshes.end(),
+			[&gltf](auto const& mesh) { return readsPositions(gltf, mesh); });
+		result.meshes.resize(gltf.meshes.size());
+		lg::detail::forEachIndex(gltf.meshes.size(), parallel, [&gltf, &buffers, &result](std::size_t i)
+		{
+			result.meshes[i] = meshBounds(gltf, buffers, gltf.meshes[i]);
+		});
+
+		lg::NodeHierarchy const hierarchy = lg::analyzeNodeHierarchy(gltf);
+		std::vector<lg::Matrix4> const worldTransforms = lg::computeWorldTransforms(gltf, hierarchy);
+		result.nodes.resize(gltf.nodes.size());
+		for (std::size_t i = 0; i < gltf.nodes.size(); ++i)
+		{
+			auto const& mesh = gltf.nodes[i].mesh;
+			if (!mesh)
+			{
+				continue;
+			}
+			if (*mesh >= result.meshes.size())
+			{
+				throw std::out_of_range("Mesh index out of range");
+			}
+			result.nodes[i] = lg::transformBounds(result.meshes[*mesh], worldTransforms[i]);
+		}
+		// Children come after their parents, so every node is complete before it is merged into its parent
+		for (auto node = hierarchy.order.rbegin(); node != hierarchy.order.rend(); ++node)
+		{
+			std::uint32_t const parent = hierarchy.parents[*node];
+			if (parent != lg::noIndex)
+			{
+				result.nodes[parent] = lg::mergeBounds(result.nodes[parent], result.nodes[*node]);
+			}
+		}
+
+		result.scenes.resize(gltf.scenes.size());
+		for (std::size_t i = 0; i < gltf.scenes.size(); ++i)
+		{
+			for (std::uint32_t const root: hierarchy.sceneRoots[i])
+			{
+				result.scenes[i] = lg::mergeBounds(result.scenes[i], result.nodes[root]);
+			}
+		}
+		return result;
+	}
+}
+
+lg::Bounds lg::mergeBounds(lg::Bounds const& a, lg::Bounds const& b) noexcept
+{
+	lg::Bounds result = a;
+	extend(result.box, b.box);
+
+	lg::BoundingSphere const& sa = a.sphere;
+	lg::BoundingSphere const& sb = b.sphere;
+	if (sb.radius < 0.0)
+	{
+		return result;
+	}
+	double const distance = std::sqrt(distanceSquared(sa.center, sb.center));
+	if (sa.radius < 0.0 || distance + sa.radius <= sb.radius)
+	{
+		result.sphere = sb;
+	}
+	else if (distance + sb.radius > sa.radius)
+	{
+		// The smallest sphere touching the far sides of both
+		double const radius = (distance + sa.radius + sb.radius) * 0.5;
+		double const t = (radius - sa.radius) / distance;
+		for (std::size_t k = 0; k < 3; ++k)
+		{
+			result.sphere.center[k] = sa.center[k] + (sb.center[k] - sa.center[k]) * t;
+		}
+		result.sphere.radius = radius;
+	}
+	return result;
+}
+
+lg::Bounds lg::transformBounds(lg::Bounds const& bounds, lg::Matrix4 const& matrix) noexcept
+{
+	lg::Bounds result;
+	if (!bounds.box.isEmpty())
+	{
+		// Every transformed axis contributes its smaller and larger end to the new box, as described by Arvo,
+		// "Transforming Axis-Aligned Bounding Boxes"
+		for (std::size_t row = 0; row < 3; ++row)
+		{
+			result.box.min[row] = matrix[12 + row];
+			result.box.max[row] = matrix[12 + row];
+			for (std::size_t column = 0; column < 3; ++column)
+			{
+				double const a = matrix[column * 4 + row] * bounds.box.min[column];
+				double const b = matrix[column * 4 + row] * bounds.box.max[column];
+				result.box.min[row] += std::min(a, b);
+				result.box.max[row] += std::max(a, b);
+			}
+		}
+	}
+
+	if (bounds.sphere.radius >= 0.0)
+	{
+		double maxScaleSquared = 0.0;
+		for (std::size_t column = 0; column < 3; ++column)
+		{
+			Vector3 const axis = {matrix[column * 4], matrix[column * 4 + 1], matrix[column * 4 + 2]};
+			maxScaleSquared = std::max(maxScaleSquared, distanceSquared(axis, {0.0, 0.0, 0.0}));
+		}
+		for (std::size_t row = 0; row < 3; ++row)
+		{
+			result.sphere.center[row] = matrix[12 + row] + matrix[row] * bounds.sphere.center[0]
+				+ matrix[4 + row] * bounds.sphere.center[1] + matrix[8 + row] * bounds.sphere.center[2];
+		}
+		result.sphere.radius = bounds.sphere.radius * std::sqrt(maxScaleSquared);
+	}
+	return result;
+}
+
+lg::DocumentBounds lg::computeBounds(lg::Gltf const& gltf, std::span<lg::BufferData const> buffers,
+	lg::BoundsOptions const& options)
+{
+	return documentBounds(gltf, buffers, options);
+}
+
+lg::DocumentBounds lg::computeBounds(lg::BorrowedGltf const& gltf, std::span<lg::BufferData const> buffers,
+	lg::BoundsOptions const& options)
+{
+	return documentBounds(gltf, buffers, options);
+}
+
+lg::DocumentBounds lg::computeBounds(lg::FloatGltf const& gltf, std::span<lg::BufferData const> buffers,
+	lg::BoundsOptions const& options)
+{
+	return documentBounds(gltf, buffers, options);
+}
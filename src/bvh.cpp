@@ -0,0 +1,572 @@
+// SPDX-License-Identifier: MIT
+// Copyright © 2022 Sebastian Larsson
+
+#include <load-gltf/bvh.hpp>
+
+#include <load-gltf/bounds.hpp>
+#include <load-gltf/structs.hpp>
+#include <load-gltf/transform.hpp>
+
+#include "parallel.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace {
+	constexpr float infinity = std::numeric_limits<float>::infinity();
+
+	/**
+	 * Smallest subtree, in items, worth a task of its own
+	 */
+	constexpr std::size_t minimumTaskSize = 4096;
+
+	constexpr std::uint32_t maxBinCount = 64;
+
+	float roundDown(double value) noexcept
+	{
+		float const result = static_cast<float>(value);
+		return result > value ? std::nextafter(result, -infinity) : result;
+	}
+
+	float roundUp(double value) noexcept
+	{
+		float const result = static_cast<float>(value);
+		return result < value ? std::nextafter(result, infinity) : result;
+	}
+
+	void extend(lg::BvhBox& box, lg::BvhBox const& other) noexcept
+	{
+		for (std::size_t k = 0; k < 3; ++k)
+		{
+			box.min[k] = std::min(box.min[k], other.min[k]);
+			box.max[k] = std::max(box.max[k], other.max[k]);
+		}
+	}
+
+	/**
+	 * @return half the surface area of a box, or 0 if it is empty
+	 */
+	float halfArea(lg::BvhBox const& box) noexcept
+	{
+		if (box.isEmpty())
+		{
+			return 0.0f;
+		}
+		float const x = box.max[0] - box.min[0];
+		float const y = box.max[1] - box.min[1];
+		float const z = box.max[2] - box.min[2];
+		return x * y + y * z + z * x;
+	}
+
+	bool overlaps(lg::BvhBox const& a, lg::BvhBox const& b) noexcept
+	{
+		return a.min[0] <= b.max[0] && b.min[0] <= a.max[0] && a.min[1] <= b.max[1] && b.min[1] <= a.max[1]
+			&& a.min[2] <= b.max[2] && b.min[2] <= a.max[2];
+	}
+
+	template<typename Storage>
+	void checkInputs(lg::BasicGltf<Storage> const& gltf, std::span<lg::Matrix4 const> worldTransforms)
+	{
+		if (worldTransforms.size() < gltf.nodes.size())
+		{
+			throw std::invalid_argument("Every node must have a world transform");
+		}
+	}
+
+	template<typename Storage>
+	lg::BvhBox worldBox(lg::BasicGltf<Storage> const& gltf, std::span<lg::Bounds const> meshBounds,
+		std::span<lg::Matrix4 const> worldTransforms, std::uint32_t node)
+	{
+		if (node >= gltf.nodes.size())
+		{
+			throw std::out_of_range("Node index out of range");
+		}
+		auto const& mesh = gltf.nodes[node].mesh;
+		if (!mesh)
+		{
+			throw std::invalid_argument("Node does not have a mesh");
+		}
+		if (*mesh >= meshBounds.size())
+		{
+			throw std::out_of_range("Mesh index out of range");
+		}
+
+		lg::Aabb const box = lg::transformBounds(meshBounds[*mesh], worldTransforms[node]).box;
+		lg::BvhBox result;
+		if (!box.isEmpty())
+		{
+			for (std::size_t k = 0; k < 3; ++k)
+			{
+				result.min[k] = roundDown(box.min[k]);
+				result.max[k] = roundUp(box.max[k]);
+			}
+		}
+		return result;
+	}
+
+	struct BuildTask
+	{
+		std::uint32_t node = {};
+		std::uint32_t begin = {};
+		std::uint32_t end = {};
+	};
+
+	/**
+	 * Item being sorted into the hierarchy, moved around rather than referenced so that every pass is sequential
+	 */
+	struct BuildItem
+	{
+		lg::BvhBox box;
+		std::array<float, 3> centroid = {};
+		std::uint32_t node = {};
+	};
+
+	/**
+	 * State shared by all tasks building a hierarchy
+	 *
+	 * Tasks work on disjoint ranges of items, and allocate nodes from nextNode, so they need no other synchronization.
+	 */
+	struct BuildContext
+	{
+		std::vector<BuildItem>& items;
+		std::vector<lg::BvhNode>& nodes;
+		std::atomic<std::uint32_t> nextNode = 1;
+		std::uint32_t maxLeafSize = {};
+		std::uint32_t binCount = {};
+	};
+
+	/**
+	 * Bins of a split, reused between nodes as they are too large to initialize for every node
+	 */
+	struct Bins
+	{
+		std::array<std::array<std::uint32_t, maxBinCount>, 3> counts;
+		std::array<std::array<lg::BvhBox, maxBinCount>, 3> boxes;
+		std::array<float, maxBinCount> rightCosts;
+	};
+
+	/**
+	 * Find the binned split of a range with the lowest surface area heuristic cost, and partition the range by it
+	 *
+	 * @return the end of the first half, or task.end if the range is better off as a leaf
+	 */
+	std::uint32_t split(BuildContext& context, Bins& bins, BuildTask const& task, lg::BvhBox const& box,
+		lg::BvhBox const& centroidBox)
+	{
+		std::uint32_t const count = task.end - task.begin;
+		if (count <= 1)
+		{
+			return task.end;
+		}
+
+		// All three axes are binned in a single pass over the items, with no more bins than items
+		std::uint32_t const binCount = std::min(count, context.binCount);
+		std::array<float, 3> scales;
+		for (std::size_t axis = 0; axis < 3; ++axis)
+		{
+			float const extent = centroidBox.max[axis] - centroidBox.min[axis];
+			scales[axis] = extent > 0.0f ? binCount / extent : 0.0f;
+		}
+		auto binOf = [binCount, &centroidBox, &scales](BuildItem const& item, std::size_t axis)
+		{
+			return std::min(binCount - 1,
+				static_cast<std::uint32_t>((item.centroid[axis] - centroidBox.min[axis]) * scales[axis]));
+		};
+		auto& binCounts = bins.counts;
+		auto& binBoxes = bins.boxes;
+		for (std::size_t axis = 0; axis < 3; ++axis)
+		{
+			std::fill_n(binCounts[axis].begin(), binCount, 0u);
+			std::fill_n(binBoxes[axis].begin(), binCount, lg::BvhBox{});
+		}
+		for (std::uint32_t i = task.begin; i < task.end; ++i)
+		{
+			BuildItem const& item = context.items[i];
+			for (std::size_t axis = 0; axis < 3; ++axis)
+			{
+				std::uint32_t const bin = binOf(item, axis);
+				++binCounts[axis][bin];
+				extend(binBoxes[axis][bin], item.box);
+			}
+		}
+
+		float bestCost = infinity;
+		std::size_t bestAxis = 3;
+		std::uint32_t bestBin = {};
+		auto& rightCosts = bins.rightCosts;
+		for (std::size_t axis = 0; axis < 3; ++axis)
+		{
+			if (scales[axis] == 0.0f)
+			{
+				continue;
+			}
+
+			// Cost of everything right of each split, then sweep from the left
+			lg::BvhBox right;
+			std::uint32_t rightCount = 0;
+			for (std::uint32_t bin = binCount - 1; bin > 0; --bin)
+			{
+				extend(right, binBoxes[axis][bin]);
+				rightCount += binCounts[axis][bin];
+				rightCosts[bin] = rightCount == 0 ? infinity : halfArea(right) * rightCount;
+			}
+			lg::BvhBox left;
+			std::uint32_t leftCount = 0;
+			for (std::uint32_t bin = 1; bin < binCount; ++bin)
+			{
+				extend(left, binBoxes[axis][bin - 1]);
+				leftCount += binCounts[axis][bin - 1];
+				float const cost = leftCount == 0 ? infinity : halfArea(left) * leftCount + rightCosts[bin];
+				if (cost < bestCost)
+				{
+					bestCost = cost;
+					bestAxis = axis;
+					bestBin = bin;
+				}
+			}
+		}
+
+		if (bestAxis == 3)
+		{
+			// All centroids coincide, so any split is as good as another
+			return count <= context.maxLeafSize ? task.end : task.begin + count / 2;
+		}
+		// Relative to intersecting an item, with traversing a node costing as much as one intersection
+		float const area = halfArea(box);
+		if (count <= context.maxLeafSize && (area <= 0.0f || 1.0f + bestCost / area >= count))
+		{
+			return task.end;
+		}
+
+		auto const middle = std::partition(context.items.begin() + task.begin, context.items.begin() + task.end,
+			[&binOf, bestAxis, bestBin](BuildItem const& item)
+			{
+				return binOf(item, bestAxis) < bestBin;
+			});
+		return static_cast<std::uint32_t>(middle - context.items.begin());
+	}
+
+	/**
+	 * Build the subtree of a task, deferring subtrees of at most deferSize items unless it is 0
+	 */
+	void buildNodes(BuildContext& context, BuildTask const& root, std::size_t deferSize,
+		std::vector<BuildTask>& deferred)
+	{
+		std::vector<BuildTask> stack = {root};
+		auto bins = std::make_unique<Bins>();
+		while (!stack.empty())
+		{
+			BuildTask const task = stack.back();
+			stack.pop_back();
+			if (task.end - task.begin <= deferSize)
+			{
+				deferred.push_back(task);
+				continue;
+			}
+
+			lg::BvhNode& node = context.nodes[task.node];
+			lg::BvhBox centroidBox;
+			node.box = {};
+			for (std::uint32_t i = task.begin; i < task.end; ++i)
+			{
+				BuildItem const& item = context.items[i];
+				extend(node.box, item.box);
+				for (std::size_t k = 0; k < 3; ++k)
+				{
+					centroidBox.min[k] = std::min(centroidBox.min[k], item.centroid[k]);
+					centroidBox.max[k] = std::max(centroidBox.max[k], item.centroid[k]);
+				}
+			}
+
+			std::uint32_t const middle = split(context, *bins, task, node.box, centroidBox);
+			if (middle == task.end)
+			{
+				node.index = task.begin;
+				node.count = task.end - task.begin;
+				continue;
+			}
+			std::uint32_t const children = context.nextNode.fetch_add(2);
+			node.index = children;
+			node.count = 0;
+			stack.push_back({children + 1, middle, task.end});
+			stack.push_back({children, task.begin, middle});
+		}
+	}
+
+	template<typename Storage>
+	lg::SceneBvh buildBvh(lg::BasicGltf<Storage> const& gltf, std::span<lg::Bounds const> meshBounds,
+		std::span<lg::Matrix4 const> worldTransforms, lg::BvhOptions const& options)
+	{
+		checkInputs(gltf, worldTransforms);
+		std::vector<BuildItem> items;
+		for (std::uint32_t i = 0; i < gltf.nodes.size(); ++i)
+		{
+			if (gltf.nodes[i].mesh)
+			{
+				BuildItem item = {worldBox(gltf, meshBounds, worldTransforms, i), {}, i};
+				if (!item.box.isEmpty())
+				{
+					for (std::size_t k = 0; k < 3; ++k)
+					{
+						item.centroid[k] = (item.box.min[k] + item.box.max[k]) * 0.5f;
+					}
+					items.push_back(item);
+				}
+			}
+		}
+
+		lg::SceneBvh result;
+		if (items.empty())
+		{
+			return result;
+		}
+
+		// A binary tree with at least one item per leaf has fewer than twice as many nodes as items
+		result.nodes.resize(items.size() * 2 - 1);
+		BuildContext context{items, result.nodes};
+		context.maxLeafSize = std::max(options.maxLeafSize, 1u);
+		context.binCount = std::clamp(options.binCount, 2u, maxBinCount);
+
+		// The top of the tree is built sequentially, until there are enough subtrees to build concurrently
+		BuildTask const root = {0, 0, static_cast<std::uint32_t>(items.size())};
+		std::size_t const threadCount = options.parallel ? std::max(std::thread::hardware_concurrency(), 1u) : 1;
+		std::size_t const deferSize = threadCount > 1 ? std::max(items.size() / (threadCount * 4), minimumTaskSize) : 0;
+		std::vector<BuildTask> deferred;
+		buildNodes(context, root, deferSize, deferred);
+		if (!deferred.empty())
+		{
+			lg::detail::forEachIndex(deferred.size(), options.parallel, [&context, &deferred](std::size_t i)
+			{
+				std::vector<BuildTask> none;
+				buildNodes(context, deferred[i], 0, none);
+			});
+		}
+		result.nodes.resize(context.nextNode);
+
+		result.items.resize(items.size());
+		result.itemBoxes.resize(items.size());
+		for (std::size_t i = 0; i < items.size(); ++i)
+		{
+			result.items[i] = items[i].node;
+			result.itemBoxes[i] = items[i].box;
+		}
+		return result;
+	}
+
+	template<typename Storage>
+	void refitBvh(lg::SceneBvh& bvh, lg::BasicGltf<Storage> const& gltf, std::span<lg::Bounds const> meshBounds,
+		std::span<lg::Matrix4 const> worldTransforms)
+	{
+		checkInputs(gltf, worldTransforms);
+		// Items are ordered by leaf, so their boxes are computed in node order first, to read the document sequentially
+		std::vector<lg::BvhBox> nodeBoxes(gltf.nodes.size());
+		for (std::uint32_t i = 0; i < gltf.nodes.size(); ++i)
+		{
+			if (gltf.nodes[i].mesh)
+			{
+				nodeBoxes[i] = worldBox(gltf, meshBounds, worldTransforms, i);
+			}
+		}
+		for (std::size_t i = 0; i < bvh.items.size(); ++i)
+		{
+			if (bvh.items[i] >= nodeBoxes.size() || !gltf.nodes[bvh.items[i]].mesh)
+			{
+				throw std::invalid_argument("Hierarchy does not match the document");
+			}
+			bvh.itemBoxes[i] = nodeBoxes[bvh.items[i]];
+		}
+		// Children come after their parents, so a reverse pass sees every child before its parent
+		for (std::size_t i = bvh.nodes.size(); i-- > 0;)
+		{
+			lg::BvhNode& node = bvh.nodes[i];
+			node.box = {};
+			if (node.count == 0)
+			{
+				extend(node.box, bvh.nodes[node.index].box);
+				extend(node.box, bvh.nodes[node.index + 1].box);
+			}
+			for (std::uint32_t item = node.index; item < node.index + node.count; ++item)
+			{
+				extend(node.box, bvh.itemBoxes[item]);
+			}
+		}
+	}
+
+	/**
+	 * Visit every node whose box passes a test, with children pushed on an explicit stack
+	 *
+	 * Empty boxes, left by refitting when mesh bounds become empty, are skipped without testing them, as some tests
+	 * would accept their infinite bounds.
+	 */
+	template<typename Test, typename Visit>
+	void traverse(lg::SceneBvh const& bvh, Test const& test, Visit const& visit)
+	{
+		if (bvh.nodes.empty())
+		{
+			return;
+		}
+		std::vector<std::uint32_t> stack = {0};
+		while (!stack.empty())
+		{
+			lg::BvhNode const& node = bvh.nodes[stack.back()];
+			stack.pop_back();
+			if (node.box.isEmpty() || !test(node.box))
+			{
+				continue;
+			}
+			if (node.count == 0)
+			{
+				stack.push_back(node.index + 1);
+				stack.push_back(node.index);
+				continue;
+			}
+			for (std::uint32_t item = node.index; item < node.index + node.count; ++item)
+			{
+				if (!bvh.itemBoxes[item].isEmpty() && test(bvh.itemBoxes[item]))
+				{
+					visit(item);
+				}
+			}
+		}
+	}
+}
+
+lg::SceneBvh lg::buildSceneBvh(lg::Gltf const& gltf, std::span<lg::Bounds const> meshBounds,
+	std::span<lg::Matrix4 const> worldTransforms, lg::BvhOptions const& options)
+{
+	return buildBvh(gltf, meshBounds, worldTransforms, options);
+}
+
+lg::SceneBvh lg::buildSceneBvh(lg::BorrowedGltf const& gltf, std::span<lg::Bounds const> meshBounds,
+	std::span<lg::Matrix4 const> worldTransforms, lg::BvhOptions const& options)
+{
+	return buildBvh(gltf, meshBounds, worldTransforms, options);
+}
+
+lg::SceneBvh lg::buildSceneBvh(lg::FloatGltf const& gltf, std::span<lg::Bounds const> meshBounds,
+	std::span<lg::Matrix4 const> worldTransforms, lg::BvhOptions const& options)
+{
+	return buildBvh(gltf, meshBounds, worldTransforms, options);
+}
+
+void lg::refitSceneBvh(lg::SceneBvh& bvh, lg::Gltf const& gltf, std::span<lg::Bounds const> meshBounds,
+	std::span<lg::Matrix4 const> worldTransforms)
+{
+	refitBvh(bvh, gltf, meshBounds, worldTransforms);
+}
+
+void lg::refitSceneBvh(lg::SceneBvh& bvh, lg::BorrowedGltf const& gltf, std::span<lg::Bounds const> meshBounds,
+	std::span<lg::Matrix4 const> worldTransforms)
+{
+	refitBvh(bvh, gltf, meshBounds, worldTransforms);
+}
+
+void lg::refitSceneBvh(lg::SceneBvh& bvh, lg::FloatGltf const& gltf, std::span<lg::Bounds const> meshBounds,
+	std::span<lg::Matrix4 const> worldTransforms)
+{
+	refitBvh(bvh, gltf, meshBounds, worldTransforms);
+}
+
+std::vector<std::uint32_t> lg::findInFrustum(lg::SceneBvh const& bvh, lg::Frustum const& frustum)
+{
+	// A box is outside if its corner farthest along the normal of any plane is outside that plane. The planes are
+	// evaluated in double precision, as rounding them to float could move them past boxes touching them.
+	std::vector<std::uint32_t> result;
+	traverse(bvh, [&frustum](lg::BvhBox const& box)
+	{
+		for (auto const& plane: frustum.planes)
+		{
+			double distance = plane[3];
+			for (std::size_t k = 0; k < 3; ++k)
+			{
+				distance += plane[k] * (plane[k] >= 0.0 ? box.max[k] : box.min[k]);
+			}
+			if (distance < 0.0)
+			{
+				return false;
+			}
+		}
+		return true;
+	}, [&bvh, &result](std::uint32_t item)
+	{
+		result.push_back(bvh.items[item]);
+	});
+	return result;
+}
+
+std::vector<std::uint32_t> lg::findOverlapping(lg::SceneBvh const& bvh, lg::Aabb const& box)
+{
+	std::vector<std::uint32_t> result;
+	if (box.isEmpty())
+	{
+		return result;
+	}
+	lg::BvhBox query;
+	for (std::size_t k = 0; k < 3; ++k)
+	{
+		query.min[k] = roundDown(box.min[k]);
+		query.max[k] = roundUp(box.max[k]);
+	}
+	traverse(bvh, [&query](lg::BvhBox const& nodeBox)
+	{
+		return overlaps(query, nodeBox);
+	}, [&bvh, &result](std::uint32_t item)
+	{
+		result.push_back(bvh.items[item]);
+	});
+	return result;
+}
+
+std::vector<lg::RayHit> lg::intersectRay(lg::SceneBvh const& bvh, lg::Ray const& ray)
+{
+	constexpr double noHit = std::numeric_limits<double>::infinity();
+	std::array<double, 3> inverseDirection;
+	for (std::size_t k = 0; k < 3; ++k)
+	{
+		inverseDirection[k] = 1.0 / ray.direction[k];
+	}
+
+	// Slab test, with rays parallel to a slab hitting it only if they start within it. It is done in double
+	// precision, so that rays far from the origin or grazing a box are not lost to rounding.
+	auto entryDistance = [&ray, &inverseDirection](lg::BvhBox const& box)
+	{
+		double entry = 0.0;
+		double exit = ray.maxDistance;
+		for (std::size_t k = 0; k < 3; ++k)
+		{
+			if (std::isinf(inverseDirection[k]))
+			{
+				if (ray.origin[k] < box.min[k] || ray.origin[k] > box.max[k])
+				{
+					return noHit;
+				}
+				continue;
+			}
+			double const a = (box.min[k] - ray.origin[k]) * inverseDirection[k];
+			double const b = (box.max[k] - ray.origin[k]) * inverseDirection[k];
+			entry = std::max(entry, std::min(a, b));
+			exit = std::min(exit, std::max(a, b));
+		}
+		return entry <= exit ? entry : noHit;
+	};
+
+	std::vector<lg::RayHit> result;
+	traverse(bvh, [&entryDistance](lg::BvhBox const& box)
+	{
+		return entryDistance(box) != noHit;
+	}, [&bvh, &result, &entryDistance](std::uint32_t item)
+	{
+		result.push_back({bvh.items[item], entryDistance(bvh.itemBoxes[item])});
+	});
+	std::sort(result.begin(), result.end(), [](lg::RayHit const& a, lg::RayHit const& b)
+	{
+		return a.distance < b.distance;
+	});
+	return result;
+}
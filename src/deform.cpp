@@ -0,0 +1,344 @@
+// SPDX-License-Identifier: MIT
+// Copyright © 2022 Sebastian Larsson
+
+#include <load-gltf/deform.hpp>
+
+#include <load-gltf/accessor.hpp>
+#include <load-gltf/structs.hpp>
+#include <load-gltf/transform.hpp>
+
+#include "parallel.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#define LG_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace {
+	/// Smallest number of elements worth a task of its own
+	constexpr std::size_t minimumTaskSize = 1 << 16;
+
+	template<typename Storage>
+	std::uint32_t findAttribute(lg::BasicMeshPrimitive<Storage> const& primitive, std::string_view attribute)
+	{
+		auto const found = primitive.attributes.find(typename Storage::String(attribute));
+		if (found == primitive.attributes.end())
+		{
+			throw std::out_of_range("Primitive does not have the attribute");
+		}
+		return found->second;
+	}
+
+	template<typename Storage>
+	std::vector<lg::Matrix4> jointMatrices(lg::BasicGltf<Storage> const& gltf, std::span<lg::BufferData const> buffers,
+		std::uint32_t skinIndex, std::span<lg::Matrix4 const> worldTransforms)
+	{
+		if (skinIndex >= gltf.skins.size())
+		{
+			throw std::out_of_range("Skin index out of range");
+		}
+		auto const& skin = gltf.skins[skinIndex];
+
+		std::vector<float> inverseBindMatrices;
+		if (skin.inverseBindMatrices)
+		{
+			if (*skin.inverseBindMatrices >= gltf.accessors.size())
+			{
+				throw std::out_of_range("Accessor index out of range");
+			}
+			auto const& accessor = gltf.accessors[*skin.inverseBindMatrices];
+			if (accessor.type != "MAT4" || accessor.count != skin.joints.size())
+			{
+				throw std::invalid_argument("Inverse bind matrices must be one MAT4 per joint");
+			}
+			inverseBindMatrices = lg::readAccessorFloats(gltf, buffers, *skin.inverseBindMatrices);
+		}
+
+		std::vector<lg::Matrix4> result(skin.joints.size());
+		for (std::size_t i = 0; i < skin.joints.size(); ++i)
+		{
+			if (skin.joints[i] >= worldTransforms.size())
+			{
+				throw std::out_of_range("Joint index out of range");
+			}
+			if (inverseBindMatrices.empty())
+			{
+				result[i] = worldTransforms[skin.joints[i]];
+			}
+			else
+			{
+				lg::Matrix4 inverseBindMatrix;
+				std::copy_n(inverseBindMatrices.begin() + i * 16, 16, inverseBindMatrix.begin());
+				result[i] = lg::multiply(worldTransforms[skin.joints[i]], inverseBindMatrix);
+			}
+		}
+		return result;
+	}
+
+	template<typename Storage>
+	std::vector<float> morph(lg::BasicGltf<Storage> const& gltf, std::span<lg::BufferData const> buffers,
+		lg::BasicMeshPrimitive<Storage> const& primitive, std::string_view attribute, std::span<float const> weights,
+		lg::DeformOptions const& options)
+	{
+		std::vector<float> result = lg::readAccessorFloats(gltf, buffers, findAttribute(primitive, attribute));
+
+		std::vector<std::vector<float>> displacements;
+		std::vector<float> displacementWeights;
+		for (std::size_t i = 0; i < std::min(weights.size(), primitive.targets.size()); ++i)
+		{
+			auto const target = primitive.targets[i].find(typename Storage::String(attribute));
+			if (weights[i] == 0.0f || target == primitive.targets[i].end())
+			{
+				continue;
+			}
+			displacements.push_back(lg::readAccessorFloats(gltf, buffers, target->second));
+			if (displacements.back().size() != result.size())
+			{
+				throw std::invalid_argument("Morph target does not match its attribute");
+			}
+			displacementWeights.push_back(weights[i]);
+		}
+
+		lg::detail::forEachRange(result.size(), minimumTaskSize, options.parallel,
+			[&](std::size_t begin, std::size_t end)
+		{
+			for (std::size_t target = 0; target < displacements.size(); ++target)
+			{
+				float const weight = displacementWeights[target];
+				float const* displacement = displacements[target].data();
+				for (std::size_t i = begin; i < end; ++i)
+				{
+					result[i] += weight * displacement[i];
+				}
+			}
+		});
+		return result;
+	}
+
+	using Matrix4f = std::array<float, 16>;
+
+#ifdef LG_SSE2
+	__m128 cross(__m128 a, __m128 b) noexcept
+	{
+		// a * b.yzx - a.yzx * b is the cross product in zxy order
+		__m128 const aYzx = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 2, 1));
+		__m128 const bYzx = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 2, 1));
+		__m128 const zxy = _mm_sub_ps(_mm_mul_ps(a, bYzx), _mm_mul_ps(aYzx, b));
+		return _mm_shuffle_ps(zxy, zxy, _MM_SHUFFLE(3, 0, 2, 1));
+	}
+#else
+	std::array<float, 3> cross(float const* a, float const* b) noexcept
+	{
+		return {a[1] * b[2] - a[2] * b[1], a[2] * b[0] - a[0] * b[2], a[0] * b[1] - a[1] * b[0]};
+	}
+#endif
+
+	/**
+	 * Skin the vertices in [begin, end), blending the joint matrices of every vertex before transforming it
+	 *
+	 * Normals are transformed by the inverse transpose of the blended 3x3 matrix, so that they stay perpendicular to
+	 * the surface under non-uniform scale. That is the cofactor matrix, whose columns are cross products of the
+	 * columns of the matrix, divided by the determinant, of which only the sign matters before normalizing.
+	 */
+	void skinRange(std::size_t begin, std::size_t end, std::span<float const> positions,
+		std::span<float const> normals, std::span<std::uint32_t const> joints, std::span<float const> weights,
+		std::vector<Matrix4f> const& matrices, lg::SkinnedVertices& result)
+	{
+		for (std::size_t vertex = begin; vertex < end; ++vertex)
+		{
+			std::array<float const*, 4> influences;
+			for (std::size_t k = 0; k < 4; ++k)
+			{
+				std::uint32_t const joint = joints[vertex * 4 + k];
+				if (joint >= matrices.size())
+				{
+					throw std::out_of_range("Joint index out of range");
+				}
+				influences[k] = matrices[joint].data();
+			}
+			float const* weight = weights.data() + vertex * 4;
+			float const* position = positions.data() + vertex * 3;
+			std::array<float, 4> skinnedPosition;
+			std::array<float, 4> skinnedNormal;
+			float determinant = 1.0f;
+#ifdef LG_SSE2
+			__m128 columns[4] = {_mm_setzero_ps(), _mm_setzero_ps(), _mm_setzero_ps(), _mm_setzero_ps()};
+			for (std::size_t k = 0; k < 4; ++k)
+			{
+				__m128 const w = _mm_set1_ps(weight[k]);
+				for (std::size_t column = 0; column < 4; ++column)
+				{
+					columns[column] = _mm_add_ps(columns[column],
+						_mm_mul_ps(w, _mm_loadu_ps(influences[k] + column * 4)));
+				}
+			}
+			__m128 const linear = _mm_add_ps(_mm_add_ps(
+				_mm_mul_ps(columns[0], _mm_set1_ps(position[0])), _mm_mul_ps(columns[1], _mm_set1_ps(position[1]))),
+				_mm_mul_ps(columns[2], _mm_set1_ps(position[2])));
+			_mm_storeu_ps(skinnedPosition.data(), _mm_add_ps(linear, columns[3]));
+			if (!normals.empty())
+			{
+				float const* normal = normals.data() + vertex * 3;
+				__m128 const cofactors[3] = {cross(columns[1], columns[2]), cross(columns[2], columns[0]),
+					cross(columns[0], columns[1])};
+				_mm_storeu_ps(skinnedNormal.data(), _mm_add_ps(_mm_add_ps(
+					_mm_mul_ps(cofactors[0], _mm_set1_ps(normal[0])), _mm_mul_ps(cofactors[1], _mm_set1_ps(normal[1]))),
+					_mm_mul_ps(cofactors[2], _mm_set1_ps(normal[2]))));
+				std::array<float, 4> products;
+				_mm_storeu_ps(products.data(), _mm_mul_ps(columns[0], cofactors[0]));
+				determinant = products[0] + products[1] + products[2];
+			}
+#else
+			Matrix4f blended = {};
+			for (std::size_t k = 0; k < 4; ++k)
+			{
+				for (std::size_t i = 0; i < 16; ++i)
+				{
+					blended[i] += weight[k] * influences[k][i];
+				}
+			}
+			for (std::size_t row = 0; row < 3; ++row)
+			{
+				skinnedPosition[row] = blended[row] * position[0] + blended[4 + row] * position[1]
+					+ blended[8 + row] * position[2] + blended[12 + row];
+			}
+			if (!normals.empty())
+			{
+				float const* normal = normals.data() + vertex * 3;
+				std::array<std::array<float, 3>, 3> const cofactors = {cross(blended.data() + 4, blended.data() + 8),
+					cross(blended.data() + 8, blended.data()), cross(blended.data(), blended.data() + 4)};
+				for (std::size_t row = 0; row < 3; ++row)
+				{
+					skinnedNormal[row] = cofactors[0][row] * normal[0] + cofactors[1][row] * normal[1]
+						+ cofactors[2][row] * normal[2];
+				}
+				determinant = blended[0] * cofactors[0][0] + blended[1] * cofactors[0][1]
+					+ blended[2] * cofactors[0][2];
+			}
+#endif
+			std::memcpy(result.positions.data() + vertex * 3, skinnedPosition.data(), 3 * sizeof(float));
+			if (!normals.empty())
+			{
+				float const length = std::sqrt(skinnedNormal[0] * skinnedNormal[0]
+					+ skinnedNormal[1] * skinnedNormal[1] + skinnedNormal[2] * skinnedNormal[2]);
+				float const scale = length > 0.0f ? std::copysign(1.0f / length, determinant) : 0.0f;
+				for (std::size_t row = 0; row < 3; ++row)
+				{
+					result.normals[vertex * 3 + row] = skinnedNormal[row] * scale;
+				}
+			}
+		}
+	}
+
+	template<typename Storage>
+	lg::SkinnedVertices skinPrimitive(lg::BasicGltf<Storage> const& gltf, std::span<lg::BufferData const> buffers,
+		lg::BasicMeshPrimitive<Storage> const& primitive, std::span<lg::Matrix4 const> jointMatrices,
+		lg::DeformOptions const& options)
+	{
+		std::vector<float> const positions = lg::readAccessorFloats(gltf, buffers,
+			findAttribute(primitive, "POSITION"));
+		std::vector<float> normals;
+		if (primitive.attributes.contains("NORMAL"))
+		{
+			normals = lg::readAccessorFloats(gltf, buffers, findAttribute(primitive, "NORMAL"));
+		}
+		std::vector<std::uint32_t> const joints = lg::readAccessorUints(gltf, buffers,
+			findAttribute(primitive, "JOINTS_0"));
+		std::vector<float> const weights = lg::readAccessorFloats(gltf, buffers, findAttribute(primitive, "WEIGHTS_0"));
+		return lg::skinVertices(positions, normals, joints, weights, jointMatrices, options);
+	}
+}
+
+std::vector<lg::Matrix4> lg::computeJointMatrices(lg::Gltf const& gltf, std::span<lg::BufferData const> buffers,
+	std::uint32_t skin, std::span<lg::Matrix4 const> worldTransforms)
+{
+	return jointMatrices(gltf, buffers, skin, worldTransforms);
+}
+
+std::vector<lg::Matrix4> lg::computeJointMatrices(lg::BorrowedGltf const& gltf,
+	std::span<lg::BufferData const> buffers, std::uint32_t skin, std::span<lg::Matrix4 const> worldTransforms)
+{
+	return jointMatrices(gltf, buffers, skin, worldTransforms);
+}
+
+std::vector<lg::Matrix4> lg::computeJointMatrices(lg::FloatGltf const& gltf, std::span<lg::BufferData const> buffers,
+	std::uint32_t skin, std::span<lg::Matrix4 const> worldTransforms)
+{
+	return jointMatrices(gltf, buffers, skin, worldTransforms);
+}
+
+std::vector<float> lg::applyMorphTargets(lg::Gltf const& gltf, std::span<lg::BufferData const> buffers,
+	lg::MeshPrimitive const& primitive, std::string_view attribute, std::span<float const> weights,
+	lg::DeformOptions const& options)
+{
+	return morph(gltf, buffers, primitive, attribute, weights, options);
+}
+
+std::vector<float> lg::applyMorphTargets(lg::BorrowedGltf const& gltf, std::span<lg::BufferData const> buffers,
+	lg::BasicMeshPrimitive<lg::BorrowingStorage> const& primitive, std::string_view attribute,
+	std::span<float const> weights, lg::DeformOptions const& options)
+{
+	return morph(gltf, buffers, primitive, attribute, weights, options);
+}
+
+std::vector<float> lg::applyMorphTargets(lg::FloatGltf const& gltf, std::span<lg::BufferData const> buffers,
+	lg::BasicMeshPrimitive<lg::FloatStorage> const& primitive, std::string_view attribute,
+	std::span<float const> weights, lg::DeformOptions const& options)
+{
+	return morph(gltf, buffers, primitive, attribute, weights, options);
+}
+
+lg::SkinnedVertices lg::skinVertices(std::span<float const> positions, std::span<float const> normals,
+	std::span<std::uint32_t const> joints, std::span<float const> weights, std::span<lg::Matrix4 const> jointMatrices,
+	lg::DeformOptions const& options)
+{
+	std::size_t const vertexCount = positions.size() / 3;
+	if (positions.size() % 3 != 0 || (!normals.empty() && normals.size() != positions.size())
+		|| joints.size() != vertexCount * 4 || weights.size() != vertexCount * 4)
+	{
+		throw std::invalid_argument("Skinning inputs do not have the same number of vertices");
+	}
+
+	// Single precision matrices are blended faster, and are precise enough once relative to the joints
+	std::vector<Matrix4f> matrices(jointMatrices.size());
+	for (std::size_t i = 0; i < jointMatrices.size(); ++i)
+	{
+		std::copy(jointMatrices[i].begin(), jointMatrices[i].end(), matrices[i].begin());
+	}
+
+	lg::SkinnedVertices result;
+	result.positions.resize(positions.size());
+	result.normals.resize(normals.size());
+	lg::detail::forEachRange(vertexCount, minimumTaskSize, options.parallel, [&](std::size_t begin, std::size_t end)
+	{
+		skinRange(begin, end, positions, normals, joints, weights, matrices, result);
+	});
+	return result;
+}
+
+lg::SkinnedVertices lg::skinVertices(lg::Gltf const& gltf, std::span<lg::BufferData const> buffers,
+	lg::MeshPrimitive const& primitive, std::span<lg::Matrix4 const> jointMatrices, lg::DeformOptions const& options)
+{
+	return skinPrimitive(gltf, buffers, primitive, jointMatrices, options);
+}
+
+lg::SkinnedVertices lg::skinVertices(lg::BorrowedGltf const& gltf, std::span<lg::BufferData const> buffers,
+	lg::BasicMeshPrimitive<lg::BorrowingStorage> const& primitive, std::span<lg::Matrix4 const> jointMatrices,
+	lg::DeformOptions const& options)
+{
+	return skinPrimitive(gltf, buffers, primitive, jointMatrices, options);
+}
+
+lg::SkinnedVertices lg::skinVertices(lg::FloatGltf const& gltf, std::span<lg::BufferData const> buffers,
+	lg::BasicMeshPrimitive<lg::FloatStorage> const& primitive, std::span<lg::Matrix4 const> jointMatrices,
+	lg::DeformOptions const& options)
+{
+	return skinPrimitive(gltf, buffers, primitive, jointMatrices, options);
+}
@@ -0,0 +1,122 @@
+// SPDX-License-Identifier: MIT
+// Copyright © 2022 Sebastian Larsson
+
+#include <load-gltf/hierarchy.hpp>
+
+#include <load-gltf/structs.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace {
+	template<typename Storage>
+	lg::NodeHierarchy analyze(lg::BasicGltf<Storage> const& gltf)
+	{
+		auto const& nodes = gltf.nodes;
+		std::size_t const nodeCount = nodes.size();
+
+		lg::NodeHierarchy result;
+		result.parents.assign(nodeCount, lg::noIndex);
+		for (std::size_t i = 0; i < nodeCount; ++i)
+		{
+			auto const& children = nodes[i].children;
+			for (std::size_t j = 0; j < children.size(); ++j)
+			{
+				std::uint32_t const child = children[j];
+				if (child >= nodeCount)
+				{
+					continue;
+				}
+				if (result.parents[child] != lg::noIndex)
+				{
+					result.sharedChildren.push_back({static_cast<std::uint32_t>(i), static_cast<std::uint32_t>(j),
+						child});
+					continue;
+				}
+				result.parents[child] = static_cast<std::uint32_t>(i);
+			}
+		}
+
+		// Breadth-first from the roots, only following the recorded parent of each child
+		result.order.reserve(nodeCount);
+		for (std::size_t i = 0; i < nodeCount; ++i)
+		{
+			if (result.parents[i] == lg::noIndex)
+			{
+				result.roots.push_back(static_cast<std::uint32_t>(i));
+				result.order.push_back(static_cast<std::uint32_t>(i));
+			}
+		}
+		for (std::size_t next = 0; next < result.order.size(); ++next)
+		{
+			std::uint32_t const node = result.order[next];
+			for (std::uint32_t const child: nodes[node].children)
+			{
+				if (child < nodeCount && result.parents[child] == node)
+				{
+					result.order.push_back(child);
+				}
+			}
+		}
+
+		// Every node not reached is in, or below, a cycle. With a single parent per node, following the parents of
+		// such a node always ends up in a cycle, or at a node already dealt with.
+		if (result.order.size() < nodeCount)
+		{
+			enum class State : std::uint8_t { unvisited, inWalk, done };
+			std::vector<State> states(nodeCount, State::unvisited);
+			for (std::uint32_t const node: result.order)
+			{
+				states[node] = State::done;
+			}
+			for (std::size_t i = 0; i < nodeCount; ++i)
+			{
+				std::size_t walk = i;
+				while (states[walk] == State::unvisited)
+				{
+					states[walk] = State::inWalk;
+					walk = result.parents[walk];
+				}
+				if (states[walk] == State::inWalk)
+				{
+					result.cycles.push_back(static_cast<std::uint32_t>(walk));
+				}
+				for (walk = i; states[walk] == State::inWalk; walk = result.parents[walk])
+				{
+					states[walk] = State::done;
+				}
+			}
+		}
+
+		result.sceneRoots.resize(gltf.scenes.size());
+		std::vector<std::uint32_t> lastScene(nodeCount, lg::noIndex);
+		for (std::size_t i = 0; i < gltf.scenes.size(); ++i)
+		{
+			for (std::uint32_t const node: gltf.scenes[i].nodes)
+			{
+				if (node < nodeCount && result.parents[node] == lg::noIndex && lastScene[node] != i)
+				{
+					lastScene[node] = static_cast<std::uint32_t>(i);
+					result.sceneRoots[i].push_back(node);
+				}
+			}
+		}
+
+		return result;
+	}
+}
+
+lg::NodeHierarchy lg::analyzeNodeHierarchy(lg::Gltf const& gltf)
+{
+	return analyze(gltf);
+}
+
+lg::NodeHierarchy lg::analyzeNodeHierarchy(lg::BorrowedGltf const& gltf)
+{
+	return analyze(gltf);
+}
+
+lg::NodeHierarchy lg::analyzeNodeHierarchy(lg::FloatGltf const& gltf)
+{
+	return analyze(gltf);
+}
@@ -0,0 +1,509 @@
+// SPDX-License-Identifier: MIT
+// Copyright © 2022 Sebastian Larsson
+
+#include <load-gltf/image.hpp>
+
+#include <load-gltf/structs.hpp>
+
+#include "parallel.hpp"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+	/**
+	 * Bytes read at a time, enough for the headers of all but JPEG images with large metadata segments
+	 */
+	constexpr std::size_t windowSize = 4096;
+
+	using Fetch = std::function<std::vector<std::byte>(std::uint64_t offset, std::size_t size)>;
+
+	/**
+	 * Reads the data of an image through a window, fetching more only when a read falls outside of it
+	 */
+	class HeaderReader
+	{
+	public:
+		explicit HeaderReader(Fetch fetch) : fetch(std::move(fetch))
+		{
+		}
+
+		/**
+		 * @return up to size bytes at the offset, fewer at the end of the data
+		 */
+		std::span<std::byte const> read(std::uint64_t offset, std::size_t size)
+		{
+			// A window shorter than was fetched ends with the data, so reads past it can not get more
+			std::uint64_t const windowEnd = windowOffset + window.size();
+			bool const covered = offset >= windowOffset
+				&& (offset + size <= windowEnd || (window.size() < fetchedSize && offset <= windowEnd));
+			if (!covered)
+			{
+				fetchedSize = std::max(size, windowSize);
+				window = fetch(offset, fetchedSize);
+				windowOffset = offset;
+				bytesRead += window.size();
+			}
+			std::size_t const start = std::min<std::uint64_t>(offset - windowOffset, window.size());
+			return std::span<std::byte const>(window).subspan(start, std::min(size, window.size() - start));
+		}
+
+		std::size_t bytesRead = 0;
+
+	private:
+		Fetch fetch;
+		std::vector<std::byte> window;
+		std::uint64_t windowOffset = 0;
+		std::size_t fetchedSize = 0;
+	};
+
+	std::uint32_t loadBigEndian(std::span<std::byte const> data, std::size_t offset, std::size_t size) noexcept
+	{
+		std::uint32_t result = 0;
+		for (std::size_t i = 0; i < size; ++i)
+		{
+			result = result << 8 | std::to_integer<std::uint32_t>(data[offset + i]);
+		}
+		return result;
+	}
+
+	std::uint32_t loadLittleEndian(std::span<std::byte const> data, std::size_t offset, std::size_t size) noexcept
+	{
+		std::uint32_t result = 0;
+		for (std::size_t i = size; i-- > 0;)
+		{
+			result = result << 8 | std::to_integer<std::uint32_t>(data[offset + i]);
+		}
+		return result;
+	}
+
+	bool startsWith(std::span<std::byte const> data, std::string_view prefix, std::size_t offset = 0) noexcept
+	{
+		return data.size() >= offset + prefix.size()
+			&& std::memcmp(data.data() + offset, prefix.data(), prefix.size()) == 0;
+	}
+
+	// ************* Formats *************************
+
+	bool probePng(HeaderReader& reader, lg::ImageInfo& info)
+	{
+		std::span<std::byte const> const header = reader.read(0, 33);
+		if (header.size() < 33 || !startsWith(header, "\x89PNG\r\n\x1a\n") || !startsWith(header, "IHDR", 12))
+		{
+			return false;
+		}
+		info.mimeType = "image/png";
+		info.width = loadBigEndian(header, 16, 4);
+		info.height = loadBigEndian(header, 20, 4);
+		info.bitDepth = std::to_integer<std::uint32_t>(header[24]);
+		switch (std::to_integer<std::uint32_t>(header[25]))
+		{
+			case 0:
+				info.channels = 1;
+				break;
+			case 2:
+			case 3:
+				info.channels = 3;
+				break;
+			case 4:
+				info.channels = 2;
+				break;
+			case 6:
+				info.channels = 4;
+				break;
+		}
+		if (info.channels == 3 || info.channels == 1)
+		{
+			// Transparency of grayscale, truecolor and palette images comes from a tRNS chunk, before the image data
+			std::uint64_t offset = 33;
+			for (int chunk = 0; chunk < 64; ++chunk)
+			{
+				std::span<std::byte const> const chunkHeader = reader.read(offset, 8);
+				if (chunkHeader.size() < 8 || startsWith(chunkHeader, "IDAT", 4))
+				{
+					break;
+				}
+				if (startsWith(chunkHeader, "tRNS", 4))
+				{
+					++info.channels;
+					break;
+				}
+				offset += 12 + std::uint64_t{loadBigEndian(chunkHeader, 0, 4)};
+			}
+		}
+		return true;
+	}
+
+	bool probeJpeg(HeaderReader& reader, lg::ImageInfo& info)
+	{
+		if (!startsWith(reader.read(0, 3), "\xff\xd8\xff"))
+		{
+			return false;
+		}
+
+		// Walk the segments up to the frame header, skipping over the contents of everything else
+		std::uint64_t offset = 2;
+		for (int segment = 0; segment < 1024; ++segment)
+		{
+			std::span<std::byte const> const marker = reader.read(offset, 4);
+			if (marker.size() < 2 || marker[0] != std::byte{0xff})
+			{
+				return false;
+			}
+			std::uint32_t const type = std::to_integer<std::uint32_t>(marker[1]);
+			if (type == 0xff)
+			{
+				offset += 1;
+				continue;
+			}
+			if (type == 0x01 || (type >= 0xd0 && type <= 0xd8))
+			{
+				offset += 2;
+				continue;
+			}
+			if (marker.size() < 4 || type == 0xd9 || type == 0xda)
+			{
+				return false;
+			}
+			if (type >= 0xc0 && type <= 0xcf && type != 0xc4 && type != 0xc8 && type != 0xcc)
+			{
+				std::span<std::byte const> const frame = reader.read(offset + 4, 6);
+				if (frame.size() < 6)
+				{
+					return false;
+				}
+				info.mimeType = "image/jpeg";
+				info.bitDepth = std::to_integer<std::uint32_t>(frame[0]);
+				info.height = loadBigEndian(frame, 1, 2);
+				info.width = loadBigEndian(frame, 3, 2);
+				info.channels = std::to_integer<std::uint32_t>(frame[5]);
+				return true;
+			}
+			offset += 2 + std::uint64_t{loadBigEndian(marker, 2, 2)};
+		}
+		return false;
+	}
+
+	bool probeWebp(HeaderReader& reader, lg::ImageInfo& info)
+	{
+		std::span<std::byte const> const header = reader.read(0, 30);
+		if (header.size() < 30 || !startsWith(header, "RIFF") || !startsWith(header, "WEBP", 8))
+		{
+			return false;
+		}
+		if (startsWith(header, "VP8 ", 12) && startsWith(header, "\x9d\x01\x2a", 23))
+		{
+			info.width = loadLittleEndian(header, 26, 2) & 0x3fff;
+			info.height = loadLittleEndian(header, 28, 2) & 0x3fff;
+			info.channels = 3;
+		}
+		else if (startsWith(header, "VP8L", 12) && header[20] == std::byte{0x2f})
+		{
+			std::uint32_t const bits = loadLittleEndian(header, 21, 4);
+			info.width = (bits & 0x3fff) + 1;
+			info.height = (bits >> 14 & 0x3fff) + 1;
+			info.channels = (bits >> 28 & 1) != 0 ? 4 : 3;
+		}
+		else if (startsWith(header, "VP8X", 12))
+		{
+			info.width = loadLittleEndian(header, 24, 3) + 1;
+			info.height = loadLittleEndian(header, 27, 3) + 1;
+			info.channels = (std::to_integer<std::uint32_t>(header[20]) & 0x10) != 0 ? 4 : 3;
+		}
+		else
+		{
+			return false;
+		}
+		info.mimeType = "image/webp";
+		info.bitDepth = 8;
+		return true;
+	}
+
+	bool probeKtx2(HeaderReader& reader, lg::ImageInfo& info)
+	{
+		std::span<std::byte const> const header = reader.read(0, 80);
+		if (header.size() < 80 || !startsWith(header, "\xabKTX 20\xbb\r\n\x1a\n"))
+		{
+			return false;
+		}
+		info.mimeType = "image/ktx2";
+		info.vkFormat = loadLittleEndian(header, 12, 4);
+		info.width = loadLittleEndian(header, 20, 4);
+		info.height = std::max(loadLittleEndian(header, 24, 4), 1u);
+		info.levels = std::max(loadLittleEndian(header, 40, 4), 1u);
+		std::uint32_t const dfdOffset = loadLittleEndian(header, 48, 4);
+		std::uint32_t const dfdLength = loadLittleEndian(header, 52, 4);
+
+		// The channels are described by the samples of the basic data format descriptor block
+		std::span<std::byte const> const dfd = reader.read(dfdOffset, std::min<std::uint32_t>(dfdLength, windowSize));
+		if (dfd.size() < 28 || loadLittleEndian(dfd, 4, 4) != 0)
+		{
+			return true;
+		}
+		std::uint32_t const colorModel = std::to_integer<std::uint32_t>(dfd[12]);
+		std::uint32_t const blockSize = std::min<std::size_t>(loadLittleEndian(dfd, 10, 2), dfd.size() - 4);
+		std::uint32_t const sampleCount = blockSize < 24 ? 0 : (blockSize - 24) / 16;
+		if (sampleCount == 0)
+		{
+			return true;
+		}
+		auto channelId = [&dfd](std::uint32_t sample)
+		{
+			return std::to_integer<std::uint32_t>(dfd[28 + sample * 16 + 3]) & 0xf;
+		};
+		if (colorModel == 163 || colorModel == 166)
+		{
+			// ETC1S and UASTC, with each sample standing for a group of channels
+			constexpr std::array<std::uint32_t, 16> etc1sChannels = {3, 0, 0, 1, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1};
+			constexpr std::array<std::uint32_t, 16> uastcChannels = {3, 0, 0, 4, 1, 2, 2, 0, 0, 0, 0, 0, 0, 0, 0, 0};
+			for (std::uint32_t sample = 0; sample < sampleCount; ++sample)
+			{
+				info.channels += (colorModel == 163 ? etc1sChannels : uastcChannels)[channelId(sample)];
+			}
+			return true;
+		}
+
+		std::array<bool, 16> channels = {};
+		for (std::uint32_t sample = 0; sample < sampleCount; ++sample)
+		{
+			channels[channelId(sample)] = true;
+		}
+		info.channels = static_cast<std::uint32_t>(std::count(channels.begin(), channels.end(), true));
+		// Uncompressed formats have texel blocks of one texel, with the block dimensions stored minus one
+		if (loadLittleEndian(dfd, 16, 4) == 0)
+		{
+			info.bitDepth = std::to_integer<std::uint32_t>(dfd[28 + 2]) + 1;
+		}
+		return true;
+	}
+
+	lg::ImageInfo probe(Fetch fetch)
+	{
+		HeaderReader reader(std::move(fetch));
+		lg::ImageInfo info;
+		for (auto const probeFormat: {probePng, probeJpeg, probeKtx2, probeWebp})
+		{
+			if (probeFormat(reader, info))
+			{
+				break;
+			}
+			info = {};
+		}
+		info.bytesRead = reader.bytesRead;
+		return info;
+	}
+
+	// ************* Sources *************************
+
+	Fetch memoryFetch(std::span<std::byte const> data)
+	{
+		return [data](std::uint64_t offset, std::size_t size)
+		{
+			std::size_t const start = std::min<std::uint64_t>(offset, data.size());
+			auto const bytes = data.subspan(start, std::min(size, data.size() - start));
+			return std::vector<std::byte>(bytes.begin(), bytes.end());
+		};
+	}
+
+	std::uint32_t base64Value(char c) noexcept
+	{
+		if (c >= 'A' && c <= 'Z')
+		{
+			return c - 'A';
+		}
+		if (c >= 'a' && c <= 'z')
+		{
+			return c - 'a' + 26;
+		}
+		if (c >= '0' && c <= '9')
+		{
+			return c - '0' + 52;
+		}
+		return c == '+' || c == '-' ? 62 : c == '/' || c == '_' ? 63 : 64;
+	}
+
+	/**
+	 * Decode base64 up to the first padding or invalid character
+	 */
+	std::vector<std::byte> decodeBase64(std::string_view text)
+	{
+		std::vector<std::byte> result;
+		result.reserve(text.size() / 4 * 3);
+		std::uint32_t bits = 0;
+		std::uint32_t bitCount = 0;
+		for (char const c: text)
+		{
+			std::uint32_t const value = base64Value(c);
+			if (value == 64)
+			{
+				break;
+			}
+			bits = bits << 6 | value;
+			bitCount += 6;
+			if (bitCount >= 8)
+			{
+				bitCount -= 8;
+				result.push_back(static_cast<std::byte>(bits >> bitCount & 0xff));
+			}
+		}
+		return result;
+	}
+
+	std::string decodePercent(std::string_view text)
+	{
+		std::string result;
+		result.reserve(text.size());
+		for (std::size_t i = 0; i < text.size(); ++i)
+		{
+			unsigned int value = {};
+			if (text[i] == '%' && i + 2 < text.size()
+				&& std::from_chars(text.data() + i + 1, text.data() + i + 3, value, 16).ptr == text.data() + i + 3)
+			{
+				result.push_back(static_cast<char>(value));
+				i += 2;
+			}
+			else
+			{
+				result.push_back(text[i]);
+			}
+		}
+		return result;
+	}
+
+	/**
+	 * Fetch from a data URI, decoding base64 only for the four-character groups covering each read
+	 */
+	Fetch dataUriFetch(std::string_view uri)
+	{
+		std::size_t const comma = uri.find(',');
+		if (comma == std::string_view::npos)
+		{
+			return memoryFetch({});
+		}
+		std::string_view const payload = uri.substr(comma + 1);
+		if (uri.substr(0, comma).ends_with(";base64"))
+		{
+			return [payload](std::uint64_t offset, std::size_t size)
+			{
+				std::uint64_t const firstGroup = offset / 3;
+				std::uint64_t const lastGroup = (offset + size + 2) / 3;
+				if (firstGroup * 4 >= payload.size())
+				{
+					return std::vector<std::byte>();
+				}
+				std::vector<std::byte> decoded = decodeBase64(payload.substr(firstGroup * 4,
+					(lastGroup - firstGroup) * 4));
+				std::size_t const skip = std::min<std::size_t>(offset - firstGroup * 3, decoded.size());
+				decoded.erase(decoded.begin(), decoded.begin() + skip);
+				decoded.resize(std::min(decoded.size(), size));
+				return decoded;
+			};
+		}
+		std::string const text = decodePercent(payload);
+		std::vector<std::byte> data(text.size());
+		std::memcpy(data.data(), text.data(), text.size());
+		return [data = std::move(data)](std::uint64_t offset, std::size_t size)
+		{
+			return memoryFetch(data)(offset, size);
+		};
+	}
+
+	template<typename Storage>
+	Fetch imageFetch(lg::BasicGltf<Storage> const& gltf, lg::ImageResources const& resources,
+		lg::BasicImage<Storage> const& image)
+	{
+		if (image.bufferView)
+		{
+			if (*image.bufferView >= gltf.bufferViews.size())
+			{
+				throw std::out_of_range("Buffer view index out of range");
+			}
+			auto const& bufferView = gltf.bufferViews[*image.bufferView];
+			if (bufferView.buffer >= resources.buffers.size())
+			{
+				throw std::out_of_range("Buffer index out of range");
+			}
+			lg::BufferData const buffer = resources.buffers[bufferView.buffer];
+			if (std::uint64_t{bufferView.byteOffset} + bufferView.byteLength > buffer.size())
+			{
+				throw std::out_of_range("Buffer view exceeds its buffer");
+			}
+			return memoryFetch(buffer.subspan(bufferView.byteOffset, bufferView.byteLength));
+		}
+		if (!image.uri)
+		{
+			return memoryFetch({});
+		}
+		std::string_view const uri = *image.uri;
+		if (uri.starts_with("data:"))
+		{
+			return dataUriFetch(uri);
+		}
+		if (!resources.readUri)
+		{
+			return memoryFetch({});
+		}
+		return [&resources, uri](std::uint64_t offset, std::size_t size)
+		{
+			return resources.readUri(uri, offset, size);
+		};
+	}
+
+	template<typename Storage>
+	std::vector<lg::ImageInfo> probeAll(lg::BasicGltf<Storage> const& gltf, lg::ImageResources const& resources,
+		lg::ImageProbeOptions const& options)
+	{
+		std::vector<lg::ImageInfo> result(gltf.images.size());
+		lg::detail::forEachIndex(gltf.images.size(), options.parallel, [&gltf, &resources, &result](std::size_t i)
+		{
+			result[i] = probe(imageFetch(gltf, resources, gltf.images[i]));
+		});
+		return result;
+	}
+}
+
+std::vector<lg::ImageInfo> lg::probeImages(lg::Gltf const& gltf, lg::ImageResources const& resources,
+	lg::ImageProbeOptions const& options)
+{
+	return probeAll(gltf, resources, options);
+}
+
+std::vector<lg::ImageInfo> lg::probeImages(lg::BorrowedGltf const& gltf, lg::ImageResources const& resources,
+	lg::ImageProbeOptions const& options)
+{
+	return probeAll(gltf, resources, options);
+}
+
+std::vector<lg::ImageInfo> lg::probeImages(lg::FloatGltf const& gltf, lg::ImageResources const& resources,
+	lg::ImageProbeOptions const& options)
+{
+	return probeAll(gltf, resources, options);
+}
+
+lg::UriReader lg::fileUriReader(std::filesystem::path directory)
+{
+	return [directory = std::move(directory)](std::string_view uri, std::uint64_t offset, std::size_t size)
+	{
+		std::string const decoded = decodePercent(uri);
+		std::filesystem::path const path(std::u8string(decoded.begin(), decoded.end()));
+		std::vector<std::byte> result;
+		if (path.has_root_path() || std::find(path.begin(), path.end(), "..") != path.end())
+		{
+			return result;
+		}
+		std::ifstream file(directory / path, std::ios::binary);
+		if (!file || !file.seekg(static_cast<std::streamoff>(offset)))
+		{
+			return result;
+		}
+		result.resize(size);
+		file.read(reinterpret_cast<char*>(result.data()), static_cast<std::streamsize>(size));
+		result.resize(static_cast<std::size_t>(file.gcount()));
+		return result;
+	};
+}
@@ -0,0 +1,79 @@
+// SPDX-License-Identifier: MIT
+// Copyright © 2022 Sebastian Larsson
+
+#include <load-gltf/json.hpp>
+
+#include <simdjson.h>
+
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace {
+	lg::JsonValue convert(simdjson::dom::element element)
+	{
+		switch (element.type())
+		{
+			case simdjson::dom::element_type::ARRAY:
+			{
+				lg::JsonValue::Array array;
+				for (simdjson::dom::element child: element.get_array())
+				{
+					array.push_back(convert(child));
+				}
+				return {std::move(array)};
+			}
+			case simdjson::dom::element_type::OBJECT:
+			{
+				lg::JsonValue::Object object;
+				for (simdjson::dom::key_value_pair member: element.get_object())
+				{
+					object.emplace_back(std::string(member.key), convert(member.value));
+				}
+				return {std::move(object)};
+			}
+			case simdjson::dom::element_type::INT64:
+			case simdjson::dom::element_type::UINT64:
+			case simdjson::dom::element_type::DOUBLE:
+				return {double(element.get_double())};
+			case simdjson::dom::element_type::STRING:
+				return {std::string(std::string_view(element.get_string()))};
+			case simdjson::dom::element_type::BOOL:
+				return {bool(element.get_bool())};
+			case simdjson::dom::element_type::NULL_VALUE:
+				return {nullptr};
+			default:
+				throw std::runtime_error("Unsupported JSON element type");
+		}
+	}
+}
+
+lg::JsonValue const* lg::JsonValue::find(std::string_view name) const noexcept
+{
+	auto const* object = std::get_if<Object>(&value);
+	if (object == nullptr)
+	{
+		return nullptr;
+	}
+	for (auto member = object->rbegin(); member != object->rend(); ++member)
+	{
+		if (member->first == name)
+		{
+			return &member->second;
+		}
+	}
+	return nullptr;
+}
+
+lg::JsonValue lg::parseJson(std::string_view json)
+{
+	simdjson::dom::parser parser;
+	simdjson::dom::element element;
+	simdjson::error_code error = parser.parse(json.data(), json.size()).get(element);
+	if (error)
+	{
+		throw std::runtime_error(std::string("Failed to parse JSON: ") + simdjson::error_message(error));
+	}
+	return convert(element);
+}
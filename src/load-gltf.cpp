@@ -3,18 +3,33 @@
 
 #include <load-gltf/load-gltf.hpp>
 
+#include <load-gltf/reload.hpp>
+#include <load-gltf/soa.hpp>
 #include <load-gltf/structs.hpp>
 
 #include <simdjson.h>
 #include <spdlog/spdlog.h>
 
+#include <algorithm>
 #include <array>
+#include <bit>
 #include <charconv>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <span>
 #include <stdexcept>
 #include <string>
 #include <string_view>
 #include <system_error>
 #include <tuple>
+#include <type_traits>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -22,6 +37,22 @@
 namespace {
 	// ************* Parser helpers *************************
 
+	/**
+	 * State shared by all parsers while loading a single document
+	 */
+	struct ParseContext
+	{
+		/// Storage for unescaped strings when loading a borrowed document, otherwise null
+		lg::BorrowingStorage::StringArena* stringArena = nullptr;
+
+		std::string_view storeString(std::string_view unescaped)
+		{
+			auto& storedString = stringArena->emplace_front(std::make_unique<char[]>(unescaped.size()));
+			std::copy(unescaped.cbegin(), unescaped.cend(), storedString.get());
+			return {storedString.get(), unescaped.size()};
+		}
+	};
+
 	uint32_t parseUint32(simdjson::ondemand::value& json)
 	{
 		double doubleValue = json.get_double();
@@ -33,84 +64,512 @@ namespace {
 		return castValue;
 	}
 
+	void parseKey(ParseContext&, simdjson::ondemand::field& field, std::string& key)
+	{
+		key = static_cast<std::string_view>(field.unescaped_key());
+	}
+
+	void parseKey(ParseContext& context, simdjson::ondemand::field& field, std::string_view& key)
+	{
+		// The raw key is longer than the unescaped key if, and only if, it contains escape sequences
+		char const* rawKey = field.key().raw();
+		std::string_view unescapedKey = field.unescaped_key();
+		if (rawKey[unescapedKey.size()] == '"'
+			&& std::string_view(rawKey, unescapedKey.size()).find('\\') == std::string_view::npos)
+		{
+			key = {rawKey, unescapedKey.size()};
+		}
+		else
+		{
+			key = context.storeString(unescapedKey);
+		}
+	}
+
+	/**
+	 * Skip over a value, returning its JSON text
+	 *
+	 * The text references the input, so capturing it is almost as cheap as skipping the value.
+	 */
+	std::string_view parseRawJson(simdjson::ondemand::value& json)
+	{
+		// Objects and arrays end where the next token starts, and scalar tokens include trailing whitespace
+		std::string_view raw = json.raw_json();
+		return raw.substr(0, raw.find_last_not_of(" \t\n\r") + 1);
+	}
+
+	/**
+	 * Output of the writers, handed to a sink whenever it grows past flushSize if there is one
+	 */
+	struct JsonWriter
+	{
+		static constexpr std::size_t flushSize = std::size_t{1} << 16;
+
+		std::string& buffer;
+		lg::OutputSink const* sink = nullptr;
+
+		void write(char character)
+		{
+			buffer.push_back(character);
+		}
+
+		void write(std::string_view text)
+		{
+			buffer.append(text);
+		}
+
+		void writeString(std::string_view text)
+		{
+			constexpr std::string_view hexDigits = "0123456789abcdef";
+
+			// Characters that need no escaping are appended in runs
+			buffer.push_back('"');
+			std::size_t runStart = 0;
+			for (std::size_t i = 0; i < text.size(); ++i)
+			{
+				auto const character = static_cast<unsigned char>(text[i]);
+				if (character >= 0x20 && character != '"' && character != '\\')
+				{
+					continue;
+				}
+
+				buffer.append(text.substr(runStart, i - runStart));
+				runStart = i + 1;
+				switch (character)
+				{
+					case '"':
+						buffer.append("\\\"");
+						break;
+					case '\\':
+						buffer.append("\\\\");
+						break;
+					case '\n':
+						buffer.append("\\n");
+						break;
+					case '\r':
+						buffer.append("\\r");
+						break;
+					case '\t':
+						buffer.append("\\t");
+						break;
+					default:
+						buffer.append("\\u00");
+						buffer.push_back(hexDigits[character >> 4]);
+						buffer.push_back(hexDigits[character & 0xf]);
+						break;
+				}
+			}
+			buffer.append(text.substr(runStart));
+			buffer.push_back('"');
+		}
+
+		/**
+		 * Write the name of an object member, preceded by a comma unless it is the first member
+		 */
+		void writeKey(std::string_view name, bool& first)
+		{
+			if (!first)
+			{
+				buffer.push_back(',');
+			}
+			first = false;
+			writeString(name);
+			buffer.push_back(':');
+		}
+
+		/**
+		 * Write the name of an object member that needs no escaping, such as a field name, like writeKey
+		 */
+		void writePlainKey(std::string_view name, bool& first)
+		{
+			if (!first)
+			{
+				buffer.push_back(',');
+			}
+			first = false;
+			buffer.push_back('"');
+			buffer.append(name);
+			buffer.append("\":");
+		}
+
+		/**
+		 * Write JSON captured by parseRawJson, or an empty object in place of empty JSON
+		 */
+		void writeRawJson(std::string_view json)
+		{
+			buffer.append(json.empty() ? std::string_view("{}") : json);
+		}
+
+		void flushIfFull()
+		{
+			if (sink != nullptr && buffer.size() >= flushSize)
+			{
+				flush();
+			}
+		}
+
+		void flush()
+		{
+			if (sink != nullptr && !buffer.empty())
+			{
+				(*sink)(std::as_bytes(std::span(buffer)));
+				buffer.clear();
+			}
+		}
+	};
+
+	// Forward declarations of the document types, defined together with their object parsers below
+	template<typename Storage>
+	void parseValue(ParseContext& context, simdjson::ondemand::value& json, lg::BasicExtension<Storage>& val);
+	template<typename Storage>
+	void parseValue(ParseContext& context, simdjson::ondemand::value& json, lg::BasicExtras<Storage>& val);
+	template<typename Storage>
+	void parseValue(ParseContext& context, simdjson::ondemand::value& json,
+		lg::BasicAccessorSparseIndices<Storage>& val);
+	template<typename Storage>
+	void parseValue(ParseContext& context, simdjson::ondemand::value& json,
+		lg::BasicAccessorSparseValues<Storage>& val);
+	template<typename Storage>
+	void parseValue(ParseContext& context, simdjson::ondemand::value& json, lg::BasicAccessorSparse<Storage>& val);
+	template<typename Storage>
+	void parseValue(ParseContext& context, simdjson::ondemand::value& json, lg::BasicAccessor<Storage>& val);
+	template<typename Storage>
+	void parseValue(ParseContext& context, simdjson::ondemand::value& json,
+		lg::BasicAnimationChannelTarget<Storage>& val);
+	template<typename Storage>
+	void parseValue(ParseContext& context, simdjson::ondemand::value& json, lg::BasicAnimationChannel<Storage>& val);
+	template<typename Storage>
+	void parseValue(ParseContext& context, simdjson::ondemand::value& json, lg::BasicAnimationSampler<Storage>& val);
+	template<typename Storage>
+	void parseValue(ParseContext& context, simdjson::ondemand::value& json, lg::BasicAnimation<Storage>& val);
+	template<typename Storage>
+	void parseValue(ParseContext& context, simdjson::ondemand::value& json, lg::BasicAsset<Storage>& val);
+	template<typename Storage>
+	void parseValue(ParseContext& context, simdjson::ondemand::value& json, lg::BasicBuffer<Storage>& val);
+	template<typename Storage>
+	void parseValue(ParseContext& context, simdjson::ondemand::value& json,
+		lg::BasicMeshoptCompression<Storage>& val);
+	template<typename Storage>
+	void parseValue(ParseContext& context, simdjson::ondemand::value& json, lg::BasicBufferView<Storage>& val);
+	template<typename Storage>
+	void parseValue(ParseContext& context, simdjson::ondemand::value& json,
+		lg::BasicCameraOrthographic<Storage>& val);
+	template<typename Storage>
+	void parseValue(ParseContext& context, simdjson::ondemand::value& json, lg::BasicCameraPerspective<Storage>& val);
+	template<typename Storage>
+	void parseValue(ParseContext& context, simdjson::ondemand::value& json, lg::BasicCamera<Storage>& val);
+	template<typename Storage>
+	void parseValue(ParseContext& context, simdjson::ondemand::value& json, lg::BasicImage<Storage>& val);
+	template<typename Storage>
+	void parseValue(ParseContext& context, simdjson::ondemand::value& json, lg::BasicTextureInfo<Storage>& val);
+	template<typename Storage>
+	void parseValue(ParseContext& context, simdjson::ondemand::value& json,
+		lg::BasicMaterialNormalTexture<Storage>& val);
+	template<typename Storage>
+	void parseValue(ParseContext& context, simdjson::ondemand::value& json,
+		lg::BasicMaterialOcclusionTexture<Storage>& val);
+	template<typename Storage>
+	void parseValue(ParseContext& context, simdjson::ondemand::value& json,
+		lg::BasicMaterialPbrMetallicRoughness<Storage>& val);
+	template<typename Storage>
+	void parseValue(ParseContext& context, simdjson::ondemand::value& json, lg::BasicMaterial<Storage>& val);
+	template<typename Storage>
+	void parseValue(ParseContext& context, simdjson::ondemand::value& json, lg::BasicMeshPrimitive<Storage>& val);
+	template<typename Storage>
+	void parseValue(ParseContext& context, simdjson::ondemand::value& json, lg::BasicMesh<Storage>& val);
+	template<typename Storage>
+	void parseValue(ParseContext& context, simdjson::ondemand::value& json, lg::BasicNode<Storage>& val);
+	template<typename Storage>
+	void parseValue(ParseContext& context, simdjson::ondemand::value& json, lg::BasicSampler<Storage>& val);
+	template<typename Storage>
+	void parseValue(ParseContext& context, simdjson::ondemand::value& json, lg::BasicScene<Storage>& val);
+	template<typename Storage>
+	void parseValue(ParseContext& context, simdjson::ondemand::value& json, lg::BasicSkin<Storage>& val);
+	template<typename Storage>
+	void parseValue(ParseContext& context, simdjson::ondemand::value& json, lg::BasicTexture<Storage>& val);
+
 	// Base case
 	template<typename ResultType>
-	void parseValue(simdjson::ondemand::value& json, ResultType&)
+	void parseValue(ParseContext& context, simdjson::ondemand::value& json, ResultType&)
 	{
 		static_assert(std::is_void_v<ResultType>, "Unhandled type");
 	}
 
 	template<typename ResultType>
-	void parseValue(simdjson::ondemand::value& json, std::optional<ResultType>& val)
+	void parseValue(ParseContext& context, simdjson::ondemand::value& json, std::optional<ResultType>& val)
 	{
 		val = ResultType{};
-		parseValue(json, val.value());
+		parseValue(context, json, val.value());
 	}
 
 	template<>
-	void parseValue(simdjson::ondemand::value& json, uint32_t& val)
+	void parseValue(ParseContext&, simdjson::ondemand::value& json, uint32_t& val)
 	{
 		val = parseUint32(json);
 	}
 
 	template<>
-	void parseValue(simdjson::ondemand::value& json, double& val)
+	void parseValue(ParseContext&, simdjson::ondemand::value& json, double& val)
 	{
 		val = json.get_double();
 	}
 
 	template<>
-	void parseValue(simdjson::ondemand::value& json, bool& val)
+	void parseValue(ParseContext&, simdjson::ondemand::value& json, float& val)
+	{
+		val = static_cast<float>(double(json.get_double()));
+	}
+
+	template<>
+	void parseValue(ParseContext&, simdjson::ondemand::value& json, bool& val)
 	{
 		val = json.get_bool();
 	}
 
 	template<>
-	void parseValue(simdjson::ondemand::value& json, std::string& val)
+	void parseValue(ParseContext&, simdjson::ondemand::value& json, std::string& val)
 	{
 		val = static_cast<std::string_view>(json.get_string());
 	}
 
+	template<>
+	void parseValue(ParseContext& context, simdjson::ondemand::value& json, std::string_view& val)
+	{
+		// The raw token includes the quotes, and possibly trailing whitespace
+		std::string_view token = json.raw_json_token();
+		if (!token.starts_with('"') || token.find('\\') != std::string_view::npos)
+		{
+			// Let simdjson unescape the string, or report the type error
+			val = context.storeString(json.get_string());
+			return;
+		}
+
+		std::size_t closingQuote = token.find_last_of('"');
+		if (closingQuote == 0)
+		{
+			throw std::invalid_argument("Unterminated string");
+		}
+		val = token.substr(1, closingQuote - 1);
+	}
+
 	template<typename ArrayElementType, size_t ArraySize>
-	void parseValue(simdjson::ondemand::value& json, std::array<ArrayElementType, ArraySize>& val)
+	void parseValue(ParseContext& context, simdjson::ondemand::value& json,
+		std::array<ArrayElementType, ArraySize>& val)
 	{
-		std::vector<ArrayElementType> parseBuffer;
+		size_t elementCount = 0;
 		for (simdjson::ondemand::value value: json.get_array())
 		{
-			parseValue(value, parseBuffer.emplace_back());
+			if (elementCount == ArraySize)
+			{
+				throw std::invalid_argument("Wrong number of elements in array");
+			}
+			parseValue(context, value, val[elementCount++]);
 		}
 
-		if (parseBuffer.size() != ArraySize)
+		if (elementCount != ArraySize)
 		{
 			throw std::invalid_argument("Wrong number of elements in array");
 		}
-
-		std::move(parseBuffer.cbegin(), parseBuffer.cend(), val.begin());
 	}
 
 	template<typename ElementType>
-	void parseValue(simdjson::ondemand::value& json, std::vector<ElementType>& val)
+	void parseValue(ParseContext& context, simdjson::ondemand::value& json, std::vector<ElementType>& val)
 	{
 		val.clear();
 		for (simdjson::ondemand::value value: json.get_array())
 		{
-			parseValue(value, val.emplace_back());
+			parseValue(context, value, val.emplace_back());
 		}
 	}
 
-	template<typename ElementType>
-	void parseValue(simdjson::ondemand::value& json, std::unordered_map<std::string, ElementType>& val)
+	template<typename KeyType, typename ElementType>
+	void parseValue(ParseContext& context, simdjson::ondemand::value& json,
+		std::unordered_map<KeyType, ElementType>& val)
 	{
 		val.clear();
-		for (simdjson::ondemand::field&& field: json.get_object())
+		for (simdjson::ondemand::field field: json.get_object())
 		{
-			std::string_view key = field.unescaped_key();
+			KeyType key = {};
+			parseKey(context, field, key);
 			ElementType value = {};
-			parseValue(field.value(), value);
-			val.insert_or_assign(std::string(key), std::move(value));
+			parseValue(context, field.value(), value);
+			val.insert_or_assign(std::move(key), std::move(value));
+		}
+	}
+
+	// Writers of the same values, found through argument-dependent lookup like those of the document types below
+
+	void writeValue(JsonWriter& writer, std::uint32_t val)
+	{
+		std::array<char, 16> text;
+		char const* end = std::to_chars(text.data(), text.data() + text.size(), val).ptr;
+		writer.write(std::string_view(text.data(), end));
+	}
+
+	template<typename FloatType>
+	void writeFloatingPoint(JsonWriter& writer, FloatType val)
+	{
+		if (!std::isfinite(val))
+		{
+			throw std::invalid_argument("Non-finite numbers can not be written as JSON");
+		}
+
+		// Whole numbers are common, and much faster to write as integers. Otherwise, to_chars without a format writes
+		// the shortest text that is read back as the same value.
+		constexpr auto maxExactInteger =
+			static_cast<FloatType>(std::uint64_t{1} << std::numeric_limits<FloatType>::digits);
+		std::array<char, 32> text;
+		char const* end = nullptr;
+		if (std::abs(val) < maxExactInteger && val == std::trunc(val) && !(val == 0 && std::signbit(val)))
+		{
+			end = std::to_chars(text.data(), text.data() + text.size(), static_cast<std::int64_t>(val)).ptr;
+		}
+		else
+		{
+			end = std::to_chars(text.data(), text.data() + text.size(), val).ptr;
+		}
+		writer.write(std::string_view(text.data(), end));
+	}
+
+	void writeValue(JsonWriter& writer, double val)
+	{
+		writeFloatingPoint(writer, val);
+	}
+
+	void writeValue(JsonWriter& writer, float val)
+	{
+		writeFloatingPoint(writer, val);
+	}
+
+	void writeValue(JsonWriter& writer, bool val)
+	{
+		writer.write(val ? "true" : "false");
+	}
+
+	void writeValue(JsonWriter& writer, std::string_view val)
+	{
+		writer.writeString(val);
+	}
+
+	template<typename ResultType>
+	void writeValue(JsonWriter& writer, std::optional<ResultType> const& val)
+	{
+		writeValue(writer, val.value());
+	}
+
+	template<typename Range>
+	void writeArray(JsonWriter& writer, Range const& range)
+	{
+		writer.write('[');
+		bool first = true;
+		for (auto const& element: range)
+		{
+			if (!first)
+			{
+				writer.write(',');
+			}
+			first = false;
+			writeValue(writer, element);
+			writer.flushIfFull();
+		}
+		writer.write(']');
+	}
+
+	template<typename ArrayElementType, size_t ArraySize>
+	void writeValue(JsonWriter& writer, std::array<ArrayElementType, ArraySize> const& val)
+	{
+		writeArray(writer, val);
+	}
+
+	template<typename ElementType>
+	void writeValue(JsonWriter& writer, std::vector<ElementType> const& val)
+	{
+		writeArray(writer, val);
+	}
+
+	/**
+	 * Write the entries of a map as members of an open object, sorted by name as the order of the map depends on how
+	 * it was built
+	 *
+	 * @param excludedName name of an entry to leave out, if not empty
+	 */
+	template<typename KeyType, typename ElementType>
+	void writeMembers(JsonWriter& writer, std::unordered_map<KeyType, ElementType> const& val, bool& first,
+		std::string_view excludedName = {})
+	{
+		std::vector<typename std::unordered_map<KeyType, ElementType>::value_type const*> members;
+		members.reserve(val.size());
+		for (auto const& member: val)
+		{
+			if (excludedName.empty() || member.first != excludedName)
+			{
+				members.push_back(&member);
+			}
+		}
+		std::sort(members.begin(), members.end(), [](auto const* lhs, auto const* rhs)
+		{
+			return lhs->first < rhs->first;
+		});
+
+		for (auto const* member: members)
+		{
+			writer.writeKey(member->first, first);
+			writeValue(writer, member->second);
+		}
+	}
+
+	template<typename KeyType, typename ElementType>
+	void writeValue(JsonWriter& writer, std::unordered_map<KeyType, ElementType> const& val)
+	{
+		writer.write('{');
+		bool first = true;
+		writeMembers(writer, val, first);
+		writer.write('}');
+	}
+
+	/**
+	 * @return whether a member that is not required can be left out, as it is absent, empty or at its default
+	 */
+	template<typename MemberType>
+	bool isDefaultValue(MemberType const& val, MemberType const& defaultValue)
+	{
+		if constexpr (std::equality_comparable<MemberType>)
+		{
+			return val == defaultValue;
 		}
+		else
+		{
+			return false;
+		}
+	}
+
+	template<typename ResultType>
+	bool isDefaultValue(std::optional<ResultType> const& val, std::optional<ResultType> const&)
+	{
+		return !val.has_value();
+	}
+
+	template<typename ElementType>
+	bool isDefaultValue(std::vector<ElementType> const& val, std::vector<ElementType> const&)
+	{
+		return val.empty();
+	}
+
+	template<typename KeyType, typename ElementType>
+	bool isDefaultValue(std::unordered_map<KeyType, ElementType> const& val,
+		std::unordered_map<KeyType, ElementType> const&)
+	{
+		return val.empty();
 	}
 
+	/**
+	 * Tag for fields without a default value in the specification, which are written even if they are empty or zero
+	 */
+	struct RequiredField
+	{
+	};
+
+	constexpr RequiredField required;
+
 	/**
 	 * Represents a single field to be parsed in an object
 	 *
@@ -122,6 +581,7 @@ namespace {
 	{
 		std::string_view name;
 		MemberType Type::* fieldPtr;
+		bool required = false;
 	};
 
 	/**
@@ -144,189 +604,344 @@ namespace {
 		ObjectParser<ResultType, MemberTypes..., MemberType>
 		operator()(std::string_view fieldName, MemberType ResultType::* memberPtr) const noexcept
 		{
+			return addField(ObjectParserField<ResultType, MemberType>{fieldName, memberPtr});
+		}
+
+		template<typename MemberType>
+		ObjectParser<ResultType, MemberTypes..., MemberType>
+		operator()(std::string_view fieldName, MemberType ResultType::* memberPtr, RequiredField) const noexcept
+		{
+			return addField(ObjectParserField<ResultType, MemberType>{fieldName, memberPtr, true});
+		}
+
+		template<typename MemberType>
+		ObjectParser<ResultType, MemberTypes..., MemberType>
+		addField(ObjectParserField<ResultType, MemberType> field) const noexcept
+		{
+			return [&]<size_t...I>(std::index_sequence<I...>)
+			{
+				return ObjectParser<ResultType, MemberTypes..., MemberType>{name, std::get<I>(fields)..., field};
+			}(std::index_sequence_for<MemberTypes...>());
+		}
+
+		/**
+		 * Parse a single property into the matching field of result
+		 *
+		 * @return false if no field matches the property
+		 */
+		bool parseField(ParseContext& context, ResultType& result, std::string_view propertyName,
+			simdjson::ondemand::value& propertyValue) const
+		{
+			auto matchAndAssign = [&context, &result, &propertyName, &propertyValue]
+				<typename FieldType>(ObjectParserField<ResultType, FieldType> objectParserField)
+			{
+				if (objectParserField.name == propertyName)
+				{
+					parseValue(context, propertyValue, result.*objectParserField.fieldPtr);
+					return true;
+				}
+				else
+				{
+					return false;
+				}
+			};
+			return [&]<size_t...I>(std::index_sequence<I...>)
+			{
+				return (false || ... || matchAndAssign(std::get<I>(fields)));
+			}(std::index_sequence_for<MemberTypes...>());
+		}
+
+		/**
+		 * Call visitor with the field matching a property
+		 *
+		 * @return false if no field matches the property
+		 */
+		template<typename Visitor>
+		bool visitField(std::string_view propertyName, Visitor&& visitor) const
+		{
+			auto matchAndVisit = [&propertyName, &visitor]
+				<typename FieldType>(ObjectParserField<ResultType, FieldType> objectParserField)
+			{
+				if (objectParserField.name == propertyName)
+				{
+					visitor(objectParserField);
+					return true;
+				}
+				else
+				{
+					return false;
+				}
+			};
 			return [&]<size_t...I>(std::index_sequence<I...>)
 			{
-				return ObjectParser<ResultType, MemberTypes..., MemberType>{name, std::get<I>(fields)...,
-					{fieldName, memberPtr}};
+				return (false || ... || matchAndVisit(std::get<I>(fields)));
+			}(std::index_sequence_for<MemberTypes...>());
+		}
+
+		/**
+		 * Write the fields of value that are required or not at their defaults, as members of an open object
+		 *
+		 * @param first whether no member has been written to the object yet, updated as members are written
+		 */
+		void writeFields(JsonWriter& writer, ResultType const& value, bool& first) const
+		{
+			static ResultType const defaults = {};
+			auto writeField = [&writer, &value, &first]
+				<typename FieldType>(ObjectParserField<ResultType, FieldType> objectParserField)
+			{
+				FieldType const& member = value.*objectParserField.fieldPtr;
+				if (objectParserField.required || !isDefaultValue(member, defaults.*objectParserField.fieldPtr))
+				{
+					writer.writePlainKey(objectParserField.name, first);
+					writeValue(writer, member);
+				}
+			};
+			[&]<size_t...I>(std::index_sequence<I...>)
+			{
+				(writeField(std::get<I>(fields)), ...);
 			}(std::index_sequence_for<MemberTypes...>());
 		}
 
-		ResultType parse(simdjson::ondemand::object& json) const
+		void write(JsonWriter& writer, ResultType const& value) const
+		{
+			writer.write('{');
+			bool first = true;
+			writeFields(writer, value, first);
+			writer.write('}');
+		}
+
+		ResultType parse(ParseContext& context, simdjson::ondemand::object& json) const
 		{
 			ResultType result = {};
 			for (simdjson::ondemand::field field: json)
 			{
 				std::string_view propertyName = field.unescaped_key();
 				simdjson::ondemand::value propertyValue = field.value();
-
-				auto matchAndAssign = [&result, &propertyName, &propertyValue]
-					<typename FieldType>(ObjectParserField<ResultType, FieldType> objectParserField)
-				{
-					if (objectParserField.name == propertyName)
-					{
-						parseValue(propertyValue, result.*objectParserField.fieldPtr);
-						return true;
-					}
-					else
-					{
-						return false;
-					}
-				};
-				[&]<size_t...I>(std::index_sequence<I...>)
+				if (!parseField(context, result, propertyName, propertyValue))
 				{
-					if (!(false || ... || matchAndAssign(std::get<I>(fields))))
-					{
-						SPDLOG_INFO("Unknown {} property: {}", name, propertyName);
-					}
-				}(std::index_sequence_for<MemberTypes...>());
+					SPDLOG_INFO("Unknown {} property: {}", name, propertyName);
+				}
 			}
 			return result;
 		}
 
-		ResultType parse(simdjson::ondemand::value& json) const
+		ResultType parse(ParseContext& context, simdjson::ondemand::value& json) const
 		{
 			simdjson::ondemand::object object = json.get_object();
-			return parse(object);
+			return parse(context, object);
 		}
 
-		ResultType parse(simdjson::ondemand::document& json) const
+		ResultType parse(ParseContext& context, simdjson::ondemand::document& json) const
 		{
 			simdjson::ondemand::object object = json.get_object();
-			return parse(object);
+			return parse(context, object);
 		}
 	};
 
 	// ********************* Parser definitions *********************
 
-	template<>
-	void parseValue(simdjson::ondemand::value& json, lg::Extension& val)
+	template<typename Storage>
+	void parseValue(ParseContext&, simdjson::ondemand::value& json, lg::BasicExtension<Storage>& val)
 	{
-		// No implementation yet
+		val.json = parseRawJson(json);
 	}
 
-	template<>
-	void parseValue(simdjson::ondemand::value& json, lg::Extras& val)
+	template<typename Storage>
+	void parseValue(ParseContext&, simdjson::ondemand::value& json, lg::BasicExtras<Storage>& val)
 	{
-		// No implementation yet
+		val.json = parseRawJson(json);
 	}
 
-	auto const accessorSparseIndicesParser = ObjectParser<lg::AccessorSparseIndices>("accessorSparseIndices")
-		("bufferView", &lg::AccessorSparseIndices::bufferView)
-		("byteOffset", &lg::AccessorSparseIndices::byteOffset)
-		("componentType", &lg::AccessorSparseIndices::componentType)
-		("extensions", &lg::AccessorSparseIndices::extensions)
-		("extras", &lg::AccessorSparseIndices::extras);
+	template<typename Storage>
+	void writeValue(JsonWriter& writer, lg::BasicExtension<Storage> const& val)
+	{
+		writer.writeRawJson(val.json);
+	}
 
-	template<>
-	void parseValue(simdjson::ondemand::value& json, lg::AccessorSparseIndices& val)
+	template<typename Storage>
+	void writeValue(JsonWriter& writer, lg::BasicExtras<Storage> const& val)
 	{
-		val = accessorSparseIndicesParser.parse(json);
+		writer.writeRawJson(val.json);
 	}
 
-	auto const accessorSparseValuesParser = ObjectParser<lg::AccessorSparseValues>("accessorSparseValues")
-		("bufferView", &lg::AccessorSparseValues::bufferView)
-		("byteOffset", &lg::AccessorSparseValues::byteOffset)
-		("extensions", &lg::AccessorSparseValues::extensions)
-		("extras", &lg::AccessorSparseValues::extras);
+	template<typename Storage>
+	auto const accessorSparseIndicesParser = ObjectParser<lg::BasicAccessorSparseIndices<Storage>>(
+		"accessorSparseIndices")
+		("bufferView", &lg::BasicAccessorSparseIndices<Storage>::bufferView, required)
+		("byteOffset", &lg::BasicAccessorSparseIndices<Storage>::byteOffset)
+		("componentType", &lg::BasicAccessorSparseIndices<Storage>::componentType, required)
+		("extensions", &lg::BasicAccessorSparseIndices<Storage>::extensions)
+		("extras", &lg::BasicAccessorSparseIndices<Storage>::extras);
+
+	template<typename Storage>
+	void parseValue(ParseContext& context, simdjson::ondemand::value& json,
+		lg::BasicAccessorSparseIndices<Storage>& val)
+	{
+		val = accessorSparseIndicesParser<Storage>.parse(context, json);
+	}
 
-	template<>
-	void parseValue(simdjson::ondemand::value& json, lg::AccessorSparseValues& val)
+	template<typename Storage>
+	void writeValue(JsonWriter& writer, lg::BasicAccessorSparseIndices<Storage> const& val)
 	{
-		val = accessorSparseValuesParser.parse(json);
+		accessorSparseIndicesParser<Storage>.write(writer, val);
 	}
 
-	auto const accessorSparseParser = ObjectParser<lg::AccessorSparse>("accessorSparse")
-		("count", &lg::AccessorSparse::count)
-		("indices", &lg::AccessorSparse::indices)
-		("values", &lg::AccessorSparse::values)
-		("extensions", &lg::AccessorSparse::extensions)
-		("extras", &lg::AccessorSparse::extras);
+	template<typename Storage>
+	auto const accessorSparseValuesParser = ObjectParser<lg::BasicAccessorSparseValues<Storage>>(
+		"accessorSparseValues")
+		("bufferView", &lg::BasicAccessorSparseValues<Storage>::bufferView, required)
+		("byteOffset", &lg::BasicAccessorSparseValues<Storage>::byteOffset)
+		("extensions", &lg::BasicAccessorSparseValues<Storage>::extensions)
+		("extras", &lg::BasicAccessorSparseValues<Storage>::extras);
 
-	template<>
-	void parseValue(simdjson::ondemand::value& json, lg::AccessorSparse& val)
+	template<typename Storage>
+	void parseValue(ParseContext& context, simdjson::ondemand::value& json, lg::BasicAccessorSparseValues<Storage>& val)
+	{
+		val = accessorSparseValuesParser<Storage>.parse(context, json);
+	}
+
+	template<typename Storage>
+	void writeValue(JsonWriter& writer, lg::BasicAccessorSparseValues<Storage> const& val)
 	{
-		val = accessorSparseParser.parse(json);
+		accessorSparseValuesParser<Storage>.write(writer, val);
 	}
 
-	auto const accessorParser = ObjectParser<lg::Accessor>("accessor")
-		("bufferView", &lg::Accessor::bufferView)
-		("byteOffset", &lg::Accessor::byteOffset)
-		("componentType", &lg::Accessor::componentType)
-		("normalized", &lg::Accessor::normalized)
-		("count", &lg::Accessor::count)
-		("type", &lg::Accessor::type)
-		("max", &lg::Accessor::max)
-		("min", &lg::Accessor::min)
-		("sparse", &lg::Accessor::sparse)
-		("name", &lg::Accessor::name)
-		("extensions", &lg::Accessor::extensions)
-		("extras", &lg::Accessor::extras);
+	template<typename Storage>
+	auto const accessorSparseParser = ObjectParser<lg::BasicAccessorSparse<Storage>>("accessorSparse")
+		("count", &lg::BasicAccessorSparse<Storage>::count, required)
+		("indices", &lg::BasicAccessorSparse<Storage>::indices, required)
+		("values", &lg::BasicAccessorSparse<Storage>::values, required)
+		("extensions", &lg::BasicAccessorSparse<Storage>::extensions)
+		("extras", &lg::BasicAccessorSparse<Storage>::extras);
 
-	template<>
-	void parseValue(simdjson::ondemand::value& json, lg::Accessor& val)
+	template<typename Storage>
+	void parseValue(ParseContext& context, simdjson::ondemand::value& json, lg::BasicAccessorSparse<Storage>& val)
 	{
-		val = accessorParser.parse(json);
+		val = accessorSparseParser<Storage>.parse(context, json);
 	}
 
-	auto const channelTargetParser = ObjectParser<lg::AnimationChannelTarget>("animation channel target")
-		("node", &lg::AnimationChannelTarget::node)
-		("path", &lg::AnimationChannelTarget::path)
-		("extensions", &lg::AnimationChannelTarget::extensions)
-		("extras", &lg::AnimationChannelTarget::extras);
+	template<typename Storage>
+	void writeValue(JsonWriter& writer, lg::BasicAccessorSparse<Storage> const& val)
+	{
+		accessorSparseParser<Storage>.write(writer, val);
+	}
 
-	template<>
-	void parseValue(simdjson::ondemand::value& json, lg::AnimationChannelTarget& val)
+	template<typename Storage>
+	auto const accessorParser = ObjectParser<lg::BasicAccessor<Storage>>("accessor")
+		("bufferView", &lg::BasicAccessor<Storage>::bufferView)
+		("byteOffset", &lg::BasicAccessor<Storage>::byteOffset)
+		("componentType", &lg::BasicAccessor<Storage>::componentType, required)
+		("normalized", &lg::BasicAccessor<Storage>::normalized)
+		("count", &lg::BasicAccessor<Storage>::count, required)
+		("type", &lg::BasicAccessor<Storage>::type, required)
+		("max", &lg::BasicAccessor<Storage>::max)
+		("min", &lg::BasicAccessor<Storage>::min)
+		("sparse", &lg::BasicAccessor<Storage>::sparse)
+		("name", &lg::BasicAccessor<Storage>::name)
+		("extensions", &lg::BasicAccessor<Storage>::extensions)
+		("extras", &lg::BasicAccessor<Storage>::extras);
+
+	template<typename Storage>
+	void parseValue(ParseContext& context, simdjson::ondemand::value& json, lg::BasicAccessor<Storage>& val)
+	{
+		val = accessorParser<Storage>.parse(context, json);
+	}
+
+	template<typename Storage>
+	void writeValue(JsonWriter& writer, lg::BasicAccessor<Storage> const& val)
 	{
-		val = channelTargetParser.parse(json);
+		accessorParser<Storage>.write(writer, val);
 	}
 
-	auto const animationChannelParser = ObjectParser<lg::AnimationChannel>("animation channel")
-		("sampler", &lg::AnimationChannel::sampler)
-		("target", &lg::AnimationChannel::target)
-		("extensions", &lg::AnimationChannel::extensions)
-		("extras", &lg::AnimationChannel::extras);
+	template<typename Storage>
+	auto const channelTargetParser = ObjectParser<lg::BasicAnimationChannelTarget<Storage>>(
+		"animation channel target")
+		("node", &lg::BasicAnimationChannelTarget<Storage>::node)
+		("path", &lg::BasicAnimationChannelTarget<Storage>::path, required)
+		("extensions", &lg::BasicAnimationChannelTarget<Storage>::extensions)
+		("extras", &lg::BasicAnimationChannelTarget<Storage>::extras);
+
+	template<typename Storage>
+	void parseValue(ParseContext& context, simdjson::ondemand::value& json,
+		lg::BasicAnimationChannelTarget<Storage>& val)
+	{
+		val = channelTargetParser<Storage>.parse(context, json);
+	}
 
-	template<>
-	void parseValue(simdjson::ondemand::value& json, lg::AnimationChannel& val)
+	template<typename Storage>
+	void writeValue(JsonWriter& writer, lg::BasicAnimationChannelTarget<Storage> const& val)
 	{
-		val = animationChannelParser.parse(json);
+		channelTargetParser<Storage>.write(writer, val);
 	}
 
-	auto const animationSamplerParser = ObjectParser<lg::AnimationSampler>("animation sampler")
-		("input", &lg::AnimationSampler::input)
-		("interpolation", &lg::AnimationSampler::interpolation)
-		("output", &lg::AnimationSampler::output)
-		("extensions", &lg::AnimationSampler::extensions)
-		("extras", &lg::AnimationSampler::extras);
+	template<typename Storage>
+	auto const animationChannelParser = ObjectParser<lg::BasicAnimationChannel<Storage>>("animation channel")
+		("sampler", &lg::BasicAnimationChannel<Storage>::sampler, required)
+		("target", &lg::BasicAnimationChannel<Storage>::target, required)
+		("extensions", &lg::BasicAnimationChannel<Storage>::extensions)
+		("extras", &lg::BasicAnimationChannel<Storage>::extras);
 
-	template<>
-	void parseValue(simdjson::ondemand::value& json, lg::AnimationSampler& val)
+	template<typename Storage>
+	void parseValue(ParseContext& context, simdjson::ondemand::value& json, lg::BasicAnimationChannel<Storage>& val)
 	{
-		val = animationSamplerParser.parse(json);
+		val = animationChannelParser<Storage>.parse(context, json);
 	}
 
-	auto const animationParser = ObjectParser<lg::Animation>("animation")
-		("channels", &lg::Animation::channels)
-		("samplers", &lg::Animation::samplers)
-		("name", &lg::Animation::name)
-		("extensions", &lg::Animation::extensions)
-		("extras", &lg::Animation::extras);
+	template<typename Storage>
+	void writeValue(JsonWriter& writer, lg::BasicAnimationChannel<Storage> const& val)
+	{
+		animationChannelParser<Storage>.write(writer, val);
+	}
 
-	template<>
-	void parseValue(simdjson::ondemand::value& json, lg::Animation& val)
+	template<typename Storage>
+	auto const animationSamplerParser = ObjectParser<lg::BasicAnimationSampler<Storage>>("animation sampler")
+		("input", &lg::BasicAnimationSampler<Storage>::input, required)
+		("interpolation", &lg::BasicAnimationSampler<Storage>::interpolation)
+		("output", &lg::BasicAnimationSampler<Storage>::output, required)
+		("extensions", &lg::BasicAnimationSampler<Storage>::extensions)
+		("extras", &lg::BasicAnimationSampler<Storage>::extras);
+
+	template<typename Storage>
+	void parseValue(ParseContext& context, simdjson::ondemand::value& json, lg::BasicAnimationSampler<Storage>& val)
 	{
-		val = animationParser.parse(json);
+		val = animationSamplerParser<Storage>.parse(context, json);
 	}
 
-	template<>
-	void parseValue(simdjson::ondemand::value& json, lg::Version& val)
+	template<typename Storage>
+	void writeValue(JsonWriter& writer, lg::BasicAnimationSampler<Storage> const& val)
 	{
-		std::string_view versionString = json.get_string();
-		uint32_t major = 0;
-		uint32_t minor = 0;
-		char const* endPtr = versionString.data() + versionString.length();
-		auto [majorEnd, majorEc] = std::from_chars(versionString.data(), endPtr, major);
-		if (majorEc != std::errc{} || majorEnd == endPtr || majorEnd[0] != '.')
+		animationSamplerParser<Storage>.write(writer, val);
+	}
+
+	template<typename Storage>
+	auto const animationParser = ObjectParser<lg::BasicAnimation<Storage>>("animation")
+		("channels", &lg::BasicAnimation<Storage>::channels, required)
+		("samplers", &lg::BasicAnimation<Storage>::samplers, required)
+		("name", &lg::BasicAnimation<Storage>::name)
+		("extensions", &lg::BasicAnimation<Storage>::extensions)
+		("extras", &lg::BasicAnimation<Storage>::extras);
+
+	template<typename Storage>
+	void parseValue(ParseContext& context, simdjson::ondemand::value& json, lg::BasicAnimation<Storage>& val)
+	{
+		val = animationParser<Storage>.parse(context, json);
+	}
+
+	template<typename Storage>
+	void writeValue(JsonWriter& writer, lg::BasicAnimation<Storage> const& val)
+	{
+		animationParser<Storage>.write(writer, val);
+	}
+
+	template<>
+	void parseValue(ParseContext&, simdjson::ondemand::value& json, lg::Version& val)
+	{
+		std::string_view versionString = json.get_string();
+		uint32_t major = 0;
+		uint32_t minor = 0;
+		char const* endPtr = versionString.data() + versionString.length();
+		auto [majorEnd, majorEc] = std::from_chars(versionString.data(), endPtr, major);
+		if (majorEc != std::errc{} || majorEnd == endPtr || majorEnd[0] != '.')
 		{
 			throw std::invalid_argument("Failed to parse major version");
 		}
@@ -339,318 +954,1100 @@ namespace {
 		val = {major, minor};
 	}
 
-	auto const assetParser = ObjectParser<lg::Asset>("asset")
-		("copyright", &lg::Asset::copyright)
-		("generator", &lg::Asset::generator)
-		("version", &lg::Asset::version)
-		("minVersion", &lg::Asset::minVersion)
-		("extensions", &lg::Asset::extensions)
-		("extras", &lg::Asset::extras);
+	void writeValue(JsonWriter& writer, lg::Version const& val)
+	{
+		writer.writeString(std::to_string(val.major) + '.' + std::to_string(val.minor));
+	}
 
-	template<>
-	void parseValue(simdjson::ondemand::value& json, lg::Asset& val)
+	template<typename Storage>
+	auto const assetParser = ObjectParser<lg::BasicAsset<Storage>>("asset")
+		("copyright", &lg::BasicAsset<Storage>::copyright)
+		("generator", &lg::BasicAsset<Storage>::generator)
+		("version", &lg::BasicAsset<Storage>::version, required)
+		("minVersion", &lg::BasicAsset<Storage>::minVersion)
+		("extensions", &lg::BasicAsset<Storage>::extensions)
+		("extras", &lg::BasicAsset<Storage>::extras);
+
+	template<typename Storage>
+	void parseValue(ParseContext& context, simdjson::ondemand::value& json, lg::BasicAsset<Storage>& val)
 	{
-		val = assetParser.parse(json);
+		val = assetParser<Storage>.parse(context, json);
 	}
 
-	auto const bufferParser = ObjectParser<lg::Buffer>("buffer")
-		("uri", &lg::Buffer::uri)
-		("byteLength", &lg::Buffer::byteLength)
-		("name", &lg::Buffer::name)
-		("extensions", &lg::Buffer::extensions)
-		("extras", &lg::Buffer::extras);
+	template<typename Storage>
+	void writeValue(JsonWriter& writer, lg::BasicAsset<Storage> const& val)
+	{
+		assetParser<Storage>.write(writer, val);
+	}
 
-	template<>
-	void parseValue(simdjson::ondemand::value& json, lg::Buffer& val)
+	template<typename Storage>
+	auto const bufferParser = ObjectParser<lg::BasicBuffer<Storage>>("buffer")
+		("uri", &lg::BasicBuffer<Storage>::uri)
+		("byteLength", &lg::BasicBuffer<Storage>::byteLength, required)
+		("name", &lg::BasicBuffer<Storage>::name)
+		("extensions", &lg::BasicBuffer<Storage>::extensions)
+		("extras", &lg::BasicBuffer<Storage>::extras);
+
+	template<typename Storage>
+	void parseValue(ParseContext& context, simdjson::ondemand::value& json, lg::BasicBuffer<Storage>& val)
 	{
-		val = bufferParser.parse(json);
+		val = bufferParser<Storage>.parse(context, json);
 	}
 
-	auto const bufferViewParser = ObjectParser<lg::BufferView>("buffer view")
-		("buffer", &lg::BufferView::buffer)
-		("byteOffset", &lg::BufferView::byteOffset)
-		("byteLength", &lg::BufferView::byteLength)
-		("byteStride", &lg::BufferView::byteStride)
-		("target", &lg::BufferView::target)
-		("name", &lg::BufferView::name)
-		("extensions", &lg::BufferView::extensions)
-		("extras", &lg::BufferView::extras);
+	template<typename Storage>
+	void writeValue(JsonWriter& writer, lg::BasicBuffer<Storage> const& val)
+	{
+		bufferParser<Storage>.write(writer, val);
+	}
 
-	template<>
-	void parseValue(simdjson::ondemand::value& json, lg::BufferView& val)
+	template<typename Storage>
+	auto const meshoptCompressionParser = ObjectParser<lg::BasicMeshoptCompression<Storage>>("meshopt compression")
+		("buffer", &lg::BasicMeshoptCompression<Storage>::buffer, required)
+		("byteOffset", &lg::BasicMeshoptCompression<Storage>::byteOffset)
+		("byteLength", &lg::BasicMeshoptCompression<Storage>::byteLength, required)
+		("byteStride", &lg::BasicMeshoptCompression<Storage>::byteStride, required)
+		("count", &lg::BasicMeshoptCompression<Storage>::count, required)
+		("mode", &lg::BasicMeshoptCompression<Storage>::mode, required)
+		("filter", &lg::BasicMeshoptCompression<Storage>::filter);
+
+	template<typename Storage>
+	void parseValue(ParseContext& context, simdjson::ondemand::value& json, lg::BasicMeshoptCompression<Storage>& val)
 	{
-		val = bufferViewParser.parse(json);
+		val = meshoptCompressionParser<Storage>.parse(context, json);
 	}
 
-	auto const cameraOrthographicParser = ObjectParser<lg::CameraOrthographic>("camera orthographic")
-		("xmag", &lg::CameraOrthographic::xmag)
-		("ymag", &lg::CameraOrthographic::ymag)
-		("zfar", &lg::CameraOrthographic::zfar)
-		("znear", &lg::CameraOrthographic::znear)
-		("extensions", &lg::CameraOrthographic::extensions)
-		("extras", &lg::CameraOrthographic::extras);
+	template<typename Storage>
+	void writeValue(JsonWriter& writer, lg::BasicMeshoptCompression<Storage> const& val)
+	{
+		meshoptCompressionParser<Storage>.write(writer, val);
+	}
 
-	template<>
-	void parseValue(simdjson::ondemand::value& json, lg::CameraOrthographic& val)
+	// The extensions of a buffer view are parsed separately, to make the supported ones typed
+	template<typename Storage>
+	auto const bufferViewParser = ObjectParser<lg::BasicBufferView<Storage>>("buffer view")
+		("buffer", &lg::BasicBufferView<Storage>::buffer, required)
+		("byteOffset", &lg::BasicBufferView<Storage>::byteOffset)
+		("byteLength", &lg::BasicBufferView<Storage>::byteLength, required)
+		("byteStride", &lg::BasicBufferView<Storage>::byteStride)
+		("target", &lg::BasicBufferView<Storage>::target)
+		("name", &lg::BasicBufferView<Storage>::name)
+		("extras", &lg::BasicBufferView<Storage>::extras);
+
+	template<typename Storage>
+	void parseBufferViewExtensions(ParseContext& context, simdjson::ondemand::value& json,
+		lg::BasicBufferView<Storage>& val)
 	{
-		val = cameraOrthographicParser.parse(json);
+		val.extensions.clear();
+		for (simdjson::ondemand::field field: json.get_object())
+		{
+			typename Storage::String key = {};
+			parseKey(context, field, key);
+			simdjson::ondemand::value value = field.value();
+			lg::BasicExtension<Storage> extension = {};
+			if (key == "EXT_meshopt_compression")
+			{
+				parseValue(context, value, val.meshoptCompression);
+			}
+			else
+			{
+				parseValue(context, value, extension);
+			}
+			val.extensions.insert_or_assign(std::move(key), std::move(extension));
+		}
 	}
 
-	auto const cameraPerspectiveParser = ObjectParser<lg::CameraPerspective>("camera perspective")
-		("aspectRatio", &lg::CameraPerspective::aspectRatio)
-		("yfov", &lg::CameraPerspective::yfov)
-		("zfar", &lg::CameraPerspective::zfar)
-		("znear", &lg::CameraPerspective::znear)
-		("extensions", &lg::CameraPerspective::extensions)
-		("extras", &lg::CameraPerspective::extras);
+	template<typename Storage>
+	void parseValue(ParseContext& context, simdjson::ondemand::value& json, lg::BasicBufferView<Storage>& val)
+	{
+		val = {};
+		for (simdjson::ondemand::field field: json.get_object())
+		{
+			std::string_view propertyName = field.unescaped_key();
+			simdjson::ondemand::value propertyValue = field.value();
+			if (propertyName == "extensions")
+			{
+				parseBufferViewExtensions(context, propertyValue, val);
+			}
+			else if (!bufferViewParser<Storage>.parseField(context, val, propertyName, propertyValue))
+			{
+				SPDLOG_INFO("Unknown {} property: {}", bufferViewParser<Storage>.name, propertyName);
+			}
+		}
+	}
 
-	template<>
-	void parseValue(simdjson::ondemand::value& json, lg::CameraPerspective& val)
+	template<typename Storage>
+	void writeValue(JsonWriter& writer, lg::BasicBufferView<Storage> const& val)
 	{
-		val = cameraPerspectiveParser.parse(json);
+		writer.write('{');
+		bool first = true;
+		bufferViewParser<Storage>.writeFields(writer, val, first);
+		if (!val.extensions.empty() || val.meshoptCompression)
+		{
+			// The entry of a typed extension only holds a placeholder, so the typed member is written in its place
+			writer.writePlainKey("extensions", first);
+			writer.write('{');
+			bool firstExtension = true;
+			if (val.meshoptCompression)
+			{
+				writer.writePlainKey("EXT_meshopt_compression", firstExtension);
+				writeValue(writer, *val.meshoptCompression);
+			}
+			writeMembers(writer, val.extensions, firstExtension,
+				val.meshoptCompression ? "EXT_meshopt_compression" : std::string_view());
+			writer.write('}');
+		}
+		writer.write('}');
 	}
 
-	auto const cameraParser = ObjectParser<lg::Camera>("camera")
-		("orthographic", &lg::Camera::orthographic)
-		("perspective", &lg::Camera::perspective)
-		("type", &lg::Camera::type)
-		("name", &lg::Camera::name)
-		("extensions", &lg::Camera::extensions)
-		("extras", &lg::Camera::extras);
+	template<typename Storage>
+	auto const cameraOrthographicParser = ObjectParser<lg::BasicCameraOrthographic<Storage>>("camera orthographic")
+		("xmag", &lg::BasicCameraOrthographic<Storage>::xmag, required)
+		("ymag", &lg::BasicCameraOrthographic<Storage>::ymag, required)
+		("zfar", &lg::BasicCameraOrthographic<Storage>::zfar, required)
+		("znear", &lg::BasicCameraOrthographic<Storage>::znear, required)
+		("extensions", &lg::BasicCameraOrthographic<Storage>::extensions)
+		("extras", &lg::BasicCameraOrthographic<Storage>::extras);
+
+	template<typename Storage>
+	void parseValue(ParseContext& context, simdjson::ondemand::value& json, lg::BasicCameraOrthographic<Storage>& val)
+	{
+		val = cameraOrthographicParser<Storage>.parse(context, json);
+	}
 
-	template<>
-	void parseValue(simdjson::ondemand::value& json, lg::Camera& val)
+	template<typename Storage>
+	void writeValue(JsonWriter& writer, lg::BasicCameraOrthographic<Storage> const& val)
 	{
-		val = cameraParser.parse(json);
+		cameraOrthographicParser<Storage>.write(writer, val);
 	}
 
-	auto const imageParser = ObjectParser<lg::Image>("image")
-		("uri", &lg::Image::uri)
-		("mimeType", &lg::Image::mimeType)
-		("bufferView", &lg::Image::bufferView)
-		("name", &lg::Image::name)
-		("extensions", &lg::Image::extensions)
-		("extras", &lg::Image::extras);
+	template<typename Storage>
+	auto const cameraPerspectiveParser = ObjectParser<lg::BasicCameraPerspective<Storage>>("camera perspective")
+		("aspectRatio", &lg::BasicCameraPerspective<Storage>::aspectRatio)
+		("yfov", &lg::BasicCameraPerspective<Storage>::yfov, required)
+		("zfar", &lg::BasicCameraPerspective<Storage>::zfar)
+		("znear", &lg::BasicCameraPerspective<Storage>::znear, required)
+		("extensions", &lg::BasicCameraPerspective<Storage>::extensions)
+		("extras", &lg::BasicCameraPerspective<Storage>::extras);
+
+	template<typename Storage>
+	void parseValue(ParseContext& context, simdjson::ondemand::value& json, lg::BasicCameraPerspective<Storage>& val)
+	{
+		val = cameraPerspectiveParser<Storage>.parse(context, json);
+	}
 
-	template<>
-	void parseValue(simdjson::ondemand::value& json, lg::Image& val)
+	template<typename Storage>
+	void writeValue(JsonWriter& writer, lg::BasicCameraPerspective<Storage> const& val)
 	{
-		val = imageParser.parse(json);
+		cameraPerspectiveParser<Storage>.write(writer, val);
 	}
 
-	auto const textureInfoParser = ObjectParser<lg::TextureInfo>("texture info")
-		("index", &lg::TextureInfo::index)
-		("texCoord", &lg::TextureInfo::texCoord)
-		("extensions", &lg::TextureInfo::extensions)
-		("extras", &lg::TextureInfo::extras);
+	template<typename Storage>
+	auto const cameraParser = ObjectParser<lg::BasicCamera<Storage>>("camera")
+		("orthographic", &lg::BasicCamera<Storage>::orthographic)
+		("perspective", &lg::BasicCamera<Storage>::perspective)
+		("type", &lg::BasicCamera<Storage>::type, required)
+		("name", &lg::BasicCamera<Storage>::name)
+		("extensions", &lg::BasicCamera<Storage>::extensions)
+		("extras", &lg::BasicCamera<Storage>::extras);
+
+	template<typename Storage>
+	void parseValue(ParseContext& context, simdjson::ondemand::value& json, lg::BasicCamera<Storage>& val)
+	{
+		val = cameraParser<Storage>.parse(context, json);
+	}
 
-	template<>
-	void parseValue(simdjson::ondemand::value& json, lg::TextureInfo& val)
+	template<typename Storage>
+	void writeValue(JsonWriter& writer, lg::BasicCamera<Storage> const& val)
 	{
-		val = textureInfoParser.parse(json);
+		cameraParser<Storage>.write(writer, val);
 	}
 
-	auto const materialNormalTextureParser = ObjectParser<lg::MaterialNormalTexture>("material normal texture")
-		("index", &lg::MaterialNormalTexture::index)
-		("texCoord", &lg::MaterialNormalTexture::texCoord)
-		("scale", &lg::MaterialNormalTexture::scale)
-		("extensions", &lg::MaterialNormalTexture::extensions)
-		("extras", &lg::MaterialNormalTexture::extras);
+	template<typename Storage>
+	auto const imageParser = ObjectParser<lg::BasicImage<Storage>>("image")
+		("uri", &lg::BasicImage<Storage>::uri)
+		("mimeType", &lg::BasicImage<Storage>::mimeType)
+		("bufferView", &lg::BasicImage<Storage>::bufferView)
+		("name", &lg::BasicImage<Storage>::name)
+		("extensions", &lg::BasicImage<Storage>::extensions)
+		("extras", &lg::BasicImage<Storage>::extras);
+
+	template<typename Storage>
+	void parseValue(ParseContext& context, simdjson::ondemand::value& json, lg::BasicImage<Storage>& val)
+	{
+		val = imageParser<Storage>.parse(context, json);
+	}
 
-	template<>
-	void parseValue(simdjson::ondemand::value& json, lg::MaterialNormalTexture& val)
+	template<typename Storage>
+	void writeValue(JsonWriter& writer, lg::BasicImage<Storage> const& val)
 	{
-		val = materialNormalTextureParser.parse(json);
+		imageParser<Storage>.write(writer, val);
 	}
 
-	auto const materialOcclusionTextureParser = ObjectParser<lg::MaterialOcclusionTexture>("material occlusion texture")
-		("index", &lg::MaterialOcclusionTexture::index)
-		("texCoord", &lg::MaterialOcclusionTexture::texCoord)
-		("strength", &lg::MaterialOcclusionTexture::strength)
-		("extensions", &lg::MaterialOcclusionTexture::extensions)
-		("extras", &lg::MaterialOcclusionTexture::extras);
+	template<typename Storage>
+	auto const textureInfoParser = ObjectParser<lg::BasicTextureInfo<Storage>>("texture info")
+		("index", &lg::BasicTextureInfo<Storage>::index, required)
+		("texCoord", &lg::BasicTextureInfo<Storage>::texCoord)
+		("extensions", &lg::BasicTextureInfo<Storage>::extensions)
+		("extras", &lg::BasicTextureInfo<Storage>::extras);
 
-	template<>
-	void parseValue(simdjson::ondemand::value& json, lg::MaterialOcclusionTexture& val)
+	template<typename Storage>
+	void parseValue(ParseContext& context, simdjson::ondemand::value& json, lg::BasicTextureInfo<Storage>& val)
+	{
+		val = textureInfoParser<Storage>.parse(context, json);
+	}
+
+	template<typename Storage>
+	void writeValue(JsonWriter& writer, lg::BasicTextureInfo<Storage> const& val)
+	{
+		textureInfoParser<Storage>.write(writer, val);
+	}
+
+	template<typename Storage>
+	auto const materialNormalTextureParser = ObjectParser<lg::BasicMaterialNormalTexture<Storage>>(
+		"material normal texture")
+		("index", &lg::BasicMaterialNormalTexture<Storage>::index, required)
+		("texCoord", &lg::BasicMaterialNormalTexture<Storage>::texCoord)
+		("scale", &lg::BasicMaterialNormalTexture<Storage>::scale)
+		("extensions", &lg::BasicMaterialNormalTexture<Storage>::extensions)
+		("extras", &lg::BasicMaterialNormalTexture<Storage>::extras);
+
+	template<typename Storage>
+	void parseValue(ParseContext& context, simdjson::ondemand::value& json,
+		lg::BasicMaterialNormalTexture<Storage>& val)
+	{
+		val = materialNormalTextureParser<Storage>.parse(context, json);
+	}
+
+	template<typename Storage>
+	void writeValue(JsonWriter& writer, lg::BasicMaterialNormalTexture<Storage> const& val)
+	{
+		materialNormalTextureParser<Storage>.write(writer, val);
+	}
+
+	template<typename Storage>
+	auto const materialOcclusionTextureParser = ObjectParser<lg::BasicMaterialOcclusionTexture<Storage>>(
+		"material occlusion texture")
+		("index", &lg::BasicMaterialOcclusionTexture<Storage>::index, required)
+		("texCoord", &lg::BasicMaterialOcclusionTexture<Storage>::texCoord)
+		("strength", &lg::BasicMaterialOcclusionTexture<Storage>::strength)
+		("extensions", &lg::BasicMaterialOcclusionTexture<Storage>::extensions)
+		("extras", &lg::BasicMaterialOcclusionTexture<Storage>::extras);
+
+	template<typename Storage>
+	void parseValue(ParseContext& context, simdjson::ondemand::value& json,
+		lg::BasicMaterialOcclusionTexture<Storage>& val)
 	{
-		val = materialOcclusionTextureParser.parse(json);
+		val = materialOcclusionTextureParser<Storage>.parse(context, json);
 	}
 
-	auto const materialPbrMetallicRoughnessParser = ObjectParser<lg::MaterialPbrMetallicRoughness>(
+	template<typename Storage>
+	void writeValue(JsonWriter& writer, lg::BasicMaterialOcclusionTexture<Storage> const& val)
+	{
+		materialOcclusionTextureParser<Storage>.write(writer, val);
+	}
+
+	template<typename Storage>
+	auto const materialPbrMetallicRoughnessParser = ObjectParser<lg::BasicMaterialPbrMetallicRoughness<Storage>>(
 		"material PBR metallic roughness")
-		("baseColorFactor", &lg::MaterialPbrMetallicRoughness::baseColorFactor)
-		("baseColorTexture", &lg::MaterialPbrMetallicRoughness::baseColorTexture)
-		("metallicFactor", &lg::MaterialPbrMetallicRoughness::metallicFactor)
-		("roughnessFactor", &lg::MaterialPbrMetallicRoughness::roughnessFactor)
-		("metallicRoughnessTexture", &lg::MaterialPbrMetallicRoughness::metallicRoughnessTexture)
-		("extensions", &lg::MaterialPbrMetallicRoughness::extensions)
-		("extras", &lg::MaterialPbrMetallicRoughness::extras);
+		("baseColorFactor", &lg::BasicMaterialPbrMetallicRoughness<Storage>::baseColorFactor)
+		("baseColorTexture", &lg::BasicMaterialPbrMetallicRoughness<Storage>::baseColorTexture)
+		("metallicFactor", &lg::BasicMaterialPbrMetallicRoughness<Storage>::metallicFactor)
+		("roughnessFactor", &lg::BasicMaterialPbrMetallicRoughness<Storage>::roughnessFactor)
+		("metallicRoughnessTexture", &lg::BasicMaterialPbrMetallicRoughness<Storage>::metallicRoughnessTexture)
+		("extensions", &lg::BasicMaterialPbrMetallicRoughness<Storage>::extensions)
+		("extras", &lg::BasicMaterialPbrMetallicRoughness<Storage>::extras);
+
+	template<typename Storage>
+	void parseValue(ParseContext& context, simdjson::ondemand::value& json,
+		lg::BasicMaterialPbrMetallicRoughness<Storage>& val)
+	{
+		val = materialPbrMetallicRoughnessParser<Storage>.parse(context, json);
+	}
 
-	template<>
-	void parseValue(simdjson::ondemand::value& json, lg::MaterialPbrMetallicRoughness& val)
+	template<typename Storage>
+	void writeValue(JsonWriter& writer, lg::BasicMaterialPbrMetallicRoughness<Storage> const& val)
 	{
-		val = materialPbrMetallicRoughnessParser.parse(json);
+		materialPbrMetallicRoughnessParser<Storage>.write(writer, val);
 	}
 
-	auto const materialParser = ObjectParser<lg::Material>("material")
-		("name", &lg::Material::name)
-		("extensions", &lg::Material::extensions)
-		("extras", &lg::Material::extras)
-		("pbrMetallicRoughness", &lg::Material::pbrMetallicRoughness)
-		("normalTexture", &lg::Material::normalTexture)
-		("occlusionTexture", &lg::Material::occlusionTexture)
-		("emissiveTexture", &lg::Material::emissiveTexture)
-		("emissiveFactor", &lg::Material::emissiveFactor)
-		("alphaMode", &lg::Material::alphaMode)
-		("alphaCutoff", &lg::Material::alphaCutoff)
-		("doubleSided", &lg::Material::doubleSided);
+	template<typename Storage>
+	auto const materialParser = ObjectParser<lg::BasicMaterial<Storage>>("material")
+		("name", &lg::BasicMaterial<Storage>::name)
+		("extensions", &lg::BasicMaterial<Storage>::extensions)
+		("extras", &lg::BasicMaterial<Storage>::extras)
+		("pbrMetallicRoughness", &lg::BasicMaterial<Storage>::pbrMetallicRoughness)
+		("normalTexture", &lg::BasicMaterial<Storage>::normalTexture)
+		("occlusionTexture", &lg::BasicMaterial<Storage>::occlusionTexture)
+		("emissiveTexture", &lg::BasicMaterial<Storage>::emissiveTexture)
+		("emissiveFactor", &lg::BasicMaterial<Storage>::emissiveFactor)
+		("alphaMode", &lg::BasicMaterial<Storage>::alphaMode)
+		("alphaCutoff", &lg::BasicMaterial<Storage>::alphaCutoff)
+		("doubleSided", &lg::BasicMaterial<Storage>::doubleSided);
+
+	template<typename Storage>
+	void parseValue(ParseContext& context, simdjson::ondemand::value& json, lg::BasicMaterial<Storage>& val)
+	{
+		val = materialParser<Storage>.parse(context, json);
+	}
 
-	template<>
-	void parseValue(simdjson::ondemand::value& json, lg::Material& val)
+	template<typename Storage>
+	void writeValue(JsonWriter& writer, lg::BasicMaterial<Storage> const& val)
+	{
+		materialParser<Storage>.write(writer, val);
+	}
+
+	template<typename Storage>
+	auto const meshPrimitiveParser = ObjectParser<lg::BasicMeshPrimitive<Storage>>("mesh primitive")
+		("attributes", &lg::BasicMeshPrimitive<Storage>::attributes, required)
+		("indices", &lg::BasicMeshPrimitive<Storage>::indices)
+		("material", &lg::BasicMeshPrimitive<Storage>::material)
+		("mode", &lg::BasicMeshPrimitive<Storage>::mode)
+		("targets", &lg::BasicMeshPrimitive<Storage>::targets)
+		("extensions", &lg::BasicMeshPrimitive<Storage>::extensions)
+		("extras", &lg::BasicMeshPrimitive<Storage>::extras);
+
+	template<typename Storage>
+	void parseValue(ParseContext& context, simdjson::ondemand::value& json, lg::BasicMeshPrimitive<Storage>& val)
+	{
+		val = meshPrimitiveParser<Storage>.parse(context, json);
+	}
+
+	template<typename Storage>
+	void writeValue(JsonWriter& writer, lg::BasicMeshPrimitive<Storage> const& val)
+	{
+		meshPrimitiveParser<Storage>.write(writer, val);
+	}
+
+	template<typename Storage>
+	auto const meshParser = ObjectParser<lg::BasicMesh<Storage>>("mesh")
+		("primitives", &lg::BasicMesh<Storage>::primitives, required)
+		("weights", &lg::BasicMesh<Storage>::weights)
+		("name", &lg::BasicMesh<Storage>::name)
+		("extensions", &lg::BasicMesh<Storage>::extensions)
+		("extras", &lg::BasicMesh<Storage>::extras);
+
+	template<typename Storage>
+	void parseValue(ParseContext& context, simdjson::ondemand::value& json, lg::BasicMesh<Storage>& val)
+	{
+		val = meshParser<Storage>.parse(context, json);
+	}
+
+	template<typename Storage>
+	void writeValue(JsonWriter& writer, lg::BasicMesh<Storage> const& val)
+	{
+		meshParser<Storage>.write(writer, val);
+	}
+
+	template<typename Storage>
+	auto const nodeParser = ObjectParser<lg::BasicNode<Storage>>("node")
+		("camera", &lg::BasicNode<Storage>::camera)
+		("children", &lg::BasicNode<Storage>::children)
+		("skin", &lg::BasicNode<Storage>::skin)
+		("matrix", &lg::BasicNode<Storage>::matrix)
+		("mesh", &lg::BasicNode<Storage>::mesh)
+		("rotation", &lg::BasicNode<Storage>::rotation)
+		("scale", &lg::BasicNode<Storage>::scale)
+		("translation", &lg::BasicNode<Storage>::translation)
+		("weights", &lg::BasicNode<Storage>::weights)
+		("name", &lg::BasicNode<Storage>::name)
+		("extensions", &lg::BasicNode<Storage>::extensions)
+		("extras", &lg::BasicNode<Storage>::extras);
+
+	template<typename Storage>
+	void parseValue(ParseContext& context, simdjson::ondemand::value& json, lg::BasicNode<Storage>& val)
 	{
-		val = materialParser.parse(json);
+		val = nodeParser<Storage>.parse(context, json);
 	}
 
-	std::unordered_map<std::string, uint32_t> parseAttributes(simdjson::ondemand::value& json)
+	template<typename Storage>
+	void writeValue(JsonWriter& writer, lg::BasicNode<Storage> const& val)
 	{
-		std::unordered_map<std::string, uint32_t> result = {};
+		nodeParser<Storage>.write(writer, val);
+	}
+
+	template<typename Storage>
+	auto const samplerParser = ObjectParser<lg::BasicSampler<Storage>>("sampler")
+		("magFilter", &lg::BasicSampler<Storage>::magFilter)
+		("minFilter", &lg::BasicSampler<Storage>::minFilter)
+		("wrapS", &lg::BasicSampler<Storage>::wrapS)
+		("wrapT", &lg::BasicSampler<Storage>::wrapT)
+		("name", &lg::BasicSampler<Storage>::name)
+		("extensions", &lg::BasicSampler<Storage>::extensions)
+		("extras", &lg::BasicSampler<Storage>::extras);
+
+	template<typename Storage>
+	void parseValue(ParseContext& context, simdjson::ondemand::value& json, lg::BasicSampler<Storage>& val)
+	{
+		val = samplerParser<Storage>.parse(context, json);
+	}
+
+	template<typename Storage>
+	void writeValue(JsonWriter& writer, lg::BasicSampler<Storage> const& val)
+	{
+		samplerParser<Storage>.write(writer, val);
+	}
+
+	template<typename Storage>
+	auto const sceneParser = ObjectParser<lg::BasicScene<Storage>>("scene")
+		("nodes", &lg::BasicScene<Storage>::nodes)
+		("name", &lg::BasicScene<Storage>::name)
+		("extensions", &lg::BasicScene<Storage>::extensions)
+		("extras", &lg::BasicScene<Storage>::extras);
+
+	template<typename Storage>
+	void parseValue(ParseContext& context, simdjson::ondemand::value& json, lg::BasicScene<Storage>& val)
+	{
+		val = sceneParser<Storage>.parse(context, json);
+	}
+
+	template<typename Storage>
+	void writeValue(JsonWriter& writer, lg::BasicScene<Storage> const& val)
+	{
+		sceneParser<Storage>.write(writer, val);
+	}
+
+	template<typename Storage>
+	auto const skinParser = ObjectParser<lg::BasicSkin<Storage>>("skin")
+		("inverseBindMatrices", &lg::BasicSkin<Storage>::inverseBindMatrices)
+		("skeleton", &lg::BasicSkin<Storage>::skeleton)
+		("joints", &lg::BasicSkin<Storage>::joints, required)
+		("name", &lg::BasicSkin<Storage>::name)
+		("extensions", &lg::BasicSkin<Storage>::extensions)
+		("extras", &lg::BasicSkin<Storage>::extras);
+
+	template<typename Storage>
+	void parseValue(ParseContext& context, simdjson::ondemand::value& json, lg::BasicSkin<Storage>& val)
+	{
+		val = skinParser<Storage>.parse(context, json);
+	}
+
+	template<typename Storage>
+	void writeValue(JsonWriter& writer, lg::BasicSkin<Storage> const& val)
+	{
+		skinParser<Storage>.write(writer, val);
+	}
+
+	template<typename Storage>
+	auto const textureParser = ObjectParser<lg::BasicTexture<Storage>>("texture")
+		("sampler", &lg::BasicTexture<Storage>::sampler)
+		("source", &lg::BasicTexture<Storage>::source)
+		("name", &lg::BasicTexture<Storage>::name)
+		("extensions", &lg::BasicTexture<Storage>::extensions)
+		("extras", &lg::BasicTexture<Storage>::extras);
+
+	template<typename Storage>
+	void parseValue(ParseContext& context, simdjson::ondemand::value& json, lg::BasicTexture<Storage>& val)
+	{
+		val = textureParser<Storage>.parse(context, json);
+	}
+
+	template<typename Storage>
+	void writeValue(JsonWriter& writer, lg::BasicTexture<Storage> const& val)
+	{
+		textureParser<Storage>.write(writer, val);
+	}
+
+	template<typename Storage>
+	auto const gltfParser = ObjectParser<lg::BasicGltf<Storage>>("GLTF")
+		("extensionsUsed", &lg::BasicGltf<Storage>::extensionsUsed)
+		("extensionsRequired", &lg::BasicGltf<Storage>::extensionsRequired)
+		("accessors", &lg::BasicGltf<Storage>::accessors)
+		("animations", &lg::BasicGltf<Storage>::animations)
+		("asset", &lg::BasicGltf<Storage>::asset, required)
+		("buffers", &lg::BasicGltf<Storage>::buffers)
+		("bufferViews", &lg::BasicGltf<Storage>::bufferViews)
+		("cameras", &lg::BasicGltf<Storage>::cameras)
+		("images", &lg::BasicGltf<Storage>::images)
+		("materials", &lg::BasicGltf<Storage>::materials)
+		("meshes", &lg::BasicGltf<Storage>::meshes)
+		("nodes", &lg::BasicGltf<Storage>::nodes)
+		("samplers", &lg::BasicGltf<Storage>::samplers)
+		("scene", &lg::BasicGltf<Storage>::scene)
+		("scenes", &lg::BasicGltf<Storage>::scenes)
+		("skins", &lg::BasicGltf<Storage>::skins)
+		("textures", &lg::BasicGltf<Storage>::textures)
+		("extensions", &lg::BasicGltf<Storage>::extensions)
+		("extras", &lg::BasicGltf<Storage>::extras);
+
+	// ********************* Structure-of-arrays parsers *********************
+
+	/**
+	 * Append a node, parsed by nodeParser, to the columns, moving its variable length members out of it
+	 *
+	 * @param hasMatrix whether the node has a matrix property, which can not be told from the value of the matrix
+	 */
+	template<typename Storage>
+	void appendSoANode(lg::BasicSoANodes<Storage>& nodes, lg::BasicNode<Storage>& node, bool hasMatrix)
+	{
+		// Fields added to nodeParser need a column here, or they would only be loaded into nodes of lg::BasicGltf
+		static_assert(std::tuple_size_v<decltype(nodeParser<Storage>.fields)> == 12,
+			"Every node field needs a structure-of-arrays column");
+		using SoANodes = lg::BasicSoANodes<Storage>;
+
+		std::uint8_t flags = hasMatrix ? SoANodes::hasMatrix : 0;
+		flags |= node.mesh ? SoANodes::hasMesh : 0;
+		flags |= node.skin ? SoANodes::hasSkin : 0;
+		flags |= node.camera ? SoANodes::hasCamera : 0;
+		auto const index = static_cast<std::uint32_t>(nodes.flags.size());
+		nodes.flags.push_back(flags);
+		nodes.translations.push_back(node.translation);
+		nodes.rotations.push_back(node.rotation);
+		nodes.scales.push_back(node.scale);
+		nodes.matrices.push_back(node.matrix);
+		nodes.meshes.push_back(node.mesh.value_or(lg::noIndex));
+		nodes.skins.push_back(node.skin.value_or(lg::noIndex));
+		nodes.cameras.push_back(node.camera.value_or(lg::noIndex));
+		nodes.children.insert(nodes.children.end(), node.children.cbegin(), node.children.cend());
+		nodes.childOffsets.push_back(static_cast<std::uint32_t>(nodes.children.size()));
+		nodes.weights.insert(nodes.weights.end(), node.weights.cbegin(), node.weights.cend());
+		nodes.weightOffsets.push_back(static_cast<std::uint32_t>(nodes.weights.size()));
+		nodes.names.push_back(std::move(node.name));
+		if (!node.extensions.empty() || node.extras)
+		{
+			nodes.extendedNodes.push_back(index);
+			nodes.extensions.push_back(std::move(node.extensions));
+			nodes.extras.push_back(std::move(node.extras));
+		}
+	}
+
+	/**
+	 * Parse a node with nodeParser into a scratch node, and append it to the columns
+	 *
+	 * The scratch node is reused between nodes, so that its vectors keep their capacity.
+	 */
+	template<typename Storage>
+	void parseSoANode(ParseContext& context, simdjson::ondemand::value& json, lg::BasicNode<Storage>& node,
+		lg::BasicSoANodes<Storage>& nodes)
+	{
+		static lg::BasicNode<Storage> const defaults = {};
+		node = defaults;
+		bool hasMatrix = false;
+		for (simdjson::ondemand::field field: json.get_object())
+		{
+			std::string_view propertyName = field.unescaped_key();
+			simdjson::ondemand::value propertyValue = field.value();
+			if (!nodeParser<Storage>.parseField(context, node, propertyName, propertyValue))
+			{
+				SPDLOG_INFO("Unknown {} property: {}", nodeParser<Storage>.name, propertyName);
+			}
+			else if (propertyName == "matrix")
+			{
+				hasMatrix = true;
+			}
+		}
+		appendSoANode(nodes, node, hasMatrix);
+	}
+
+	template<typename Storage>
+	void parseValue(ParseContext& context, simdjson::ondemand::value& json, lg::BasicSoANodes<Storage>& val)
+	{
+		val = {};
+		lg::BasicNode<Storage> node;
+		for (simdjson::ondemand::value value: json.get_array())
+		{
+			parseSoANode(context, value, node, val);
+		}
+	}
+
+	/**
+	 * Append an accessor, parsed by accessorParser, to the columns, moving its variable length members out of it
+	 */
+	template<typename Storage>
+	void appendSoAAccessor(lg::BasicSoAAccessors<Storage>& accessors, lg::BasicAccessor<Storage>& accessor)
+	{
+		// Fields added to accessorParser need a column here, or they would only be loaded into lg::BasicGltf
+		static_assert(std::tuple_size_v<decltype(accessorParser<Storage>.fields)> == 12,
+			"Every accessor field needs a structure-of-arrays column");
+		using SoAAccessors = lg::BasicSoAAccessors<Storage>;
+
+		std::uint8_t flags = accessor.bufferView ? SoAAccessors::hasBufferView : 0;
+		flags |= accessor.normalized ? SoAAccessors::isNormalized : 0;
+		flags |= accessor.sparse ? SoAAccessors::isSparse : 0;
+		auto const index = static_cast<std::uint32_t>(accessors.flags.size());
+		accessors.flags.push_back(flags);
+		accessors.bufferViews.push_back(accessor.bufferView.value_or(lg::noIndex));
+		accessors.byteOffsets.push_back(accessor.byteOffset);
+		accessors.componentTypes.push_back(accessor.componentType);
+		accessors.counts.push_back(accessor.count);
+		accessors.types.push_back(std::move(accessor.type));
+		accessors.max.insert(accessors.max.end(), accessor.max.cbegin(), accessor.max.cend());
+		accessors.maxOffsets.push_back(static_cast<std::uint32_t>(accessors.max.size()));
+		accessors.min.insert(accessors.min.end(), accessor.min.cbegin(), accessor.min.cend());
+		accessors.minOffsets.push_back(static_cast<std::uint32_t>(accessors.min.size()));
+		if (accessor.sparse)
+		{
+			accessors.sparseAccessors.push_back(index);
+			accessors.sparse.push_back(std::move(*accessor.sparse));
+		}
+		accessors.names.push_back(std::move(accessor.name));
+		if (!accessor.extensions.empty() || accessor.extras)
+		{
+			accessors.extendedAccessors.push_back(index);
+			accessors.extensions.push_back(std::move(accessor.extensions));
+			accessors.extras.push_back(std::move(accessor.extras));
+		}
+	}
+
+	/**
+	 * Parse an accessor with accessorParser into a scratch accessor, and append it to the columns
+	 */
+	template<typename Storage>
+	void parseSoAAccessor(ParseContext& context, simdjson::ondemand::value& json,
+		lg::BasicAccessor<Storage>& accessor, lg::BasicSoAAccessors<Storage>& accessors)
+	{
+		static lg::BasicAccessor<Storage> const defaults = {};
+		accessor = defaults;
 		for (simdjson::ondemand::field field: json.get_object())
 		{
-			std::string_view key = field.unescaped_key();
-			uint32_t value = parseUint32(field.value());
-			result.insert_or_assign(std::string(key), value);
+			std::string_view propertyName = field.unescaped_key();
+			simdjson::ondemand::value propertyValue = field.value();
+			if (!accessorParser<Storage>.parseField(context, accessor, propertyName, propertyValue))
+			{
+				SPDLOG_INFO("Unknown {} property: {}", accessorParser<Storage>.name, propertyName);
+			}
+		}
+		appendSoAAccessor(accessors, accessor);
+	}
+
+	template<typename Storage>
+	void parseValue(ParseContext& context, simdjson::ondemand::value& json, lg::BasicSoAAccessors<Storage>& val)
+	{
+		val = {};
+		lg::BasicAccessor<Storage> accessor;
+		for (simdjson::ondemand::value value: json.get_array())
+		{
+			parseSoAAccessor(context, value, accessor, val);
+		}
+	}
+
+	template<typename Storage>
+	lg::BasicSoAScene<Storage> parseSoAScene(simdjson::ondemand::document& doc)
+	{
+		ParseContext context;
+		lg::BasicSoAScene<Storage> result;
+		for (simdjson::ondemand::field field: doc.get_object())
+		{
+			std::string_view propertyName = field.unescaped_key();
+			simdjson::ondemand::value propertyValue = field.value();
+			if (propertyName == "nodes")
+			{
+				parseValue(context, propertyValue, result.nodes);
+			}
+			else if (propertyName == "accessors")
+			{
+				parseValue(context, propertyValue, result.accessors);
+			}
+			else if (!gltfParser<Storage>.parseField(context, result.document, propertyName, propertyValue))
+			{
+				SPDLOG_INFO("Unknown {} property: {}", "GLTF", propertyName);
+			}
 		}
 		return result;
 	}
 
-	template<>
-	void parseValue(simdjson::ondemand::value& json, std::unordered_map<std::string, uint32_t>& val)
+	// ********************* Reloading *********************
+
+	/**
+	 * 64-bit xxHash of a string, used to detect changed JSON text
+	 */
+	std::uint64_t hashJson(std::string_view text)
 	{
-		val = parseAttributes(json);
+		constexpr std::uint64_t prime1 = 0x9e3779b185ebca87;
+		constexpr std::uint64_t prime2 = 0xc2b2ae3d27d4eb4f;
+		constexpr std::uint64_t prime3 = 0x165667b19e3779f9;
+		constexpr std::uint64_t prime4 = 0x85ebca77c2b2ae63;
+		constexpr std::uint64_t prime5 = 0x27d4eb2f165667c5;
+
+		auto read64 = [](char const* data)
+		{
+			std::uint64_t word;
+			std::memcpy(&word, data, sizeof(word));
+			return word;
+		};
+		auto round = [](std::uint64_t accumulator, std::uint64_t word)
+		{
+			return std::rotl(accumulator + word * prime2, 31) * prime1;
+		};
+
+		char const* data = text.data();
+		char const* const end = data + text.size();
+		std::uint64_t hash = prime5;
+		if (text.size() >= 32)
+		{
+			std::array<std::uint64_t, 4> lanes = {prime1 + prime2, prime2, 0, 0 - prime1};
+			for (; end - data >= 32; data += 32)
+			{
+				for (std::size_t lane = 0; lane < lanes.size(); ++lane)
+				{
+					lanes[lane] = round(lanes[lane], read64(data + lane * 8));
+				}
+			}
+			hash = std::rotl(lanes[0], 1) + std::rotl(lanes[1], 7) + std::rotl(lanes[2], 12) + std::rotl(lanes[3], 18);
+			for (std::uint64_t lane: lanes)
+			{
+				hash = (hash ^ round(0, lane)) * prime1 + prime4;
+			}
+		}
+
+		hash += text.size();
+		for (; end - data >= 8; data += 8)
+		{
+			hash = std::rotl(hash ^ round(0, read64(data)), 27) * prime1 + prime4;
+		}
+		if (end - data >= 4)
+		{
+			std::uint32_t word;
+			std::memcpy(&word, data, sizeof(word));
+			hash = std::rotl(hash ^ word * prime1, 23) * prime2 + prime3;
+			data += 4;
+		}
+		for (; data != end; ++data)
+		{
+			hash = std::rotl(hash ^ static_cast<unsigned char>(*data) * prime5, 11) * prime1;
+		}
+
+		hash = (hash ^ hash >> 33) * prime2;
+		hash = (hash ^ hash >> 29) * prime3;
+		return hash ^ hash >> 32;
 	}
 
-	auto const meshPrimitiveParser = ObjectParser<lg::MeshPrimitive>("mesh primitive")
-		("attributes", &lg::MeshPrimitive::attributes)
-		("indices", &lg::MeshPrimitive::indices)
-		("material", &lg::MeshPrimitive::material)
-		("mode", &lg::MeshPrimitive::mode)
-		("targets", &lg::MeshPrimitive::targets)
-		("extensions", &lg::MeshPrimitive::extensions)
-		("extras", &lg::MeshPrimitive::extras);
+	/**
+	 * Type of the values a top-level member is reloaded as: the elements of arrays of objects, which are compared
+	 * element by element, and the whole member otherwise
+	 */
+	template<typename MemberType>
+	struct ReloadUnit
+	{
+		using Type = MemberType;
+		static constexpr bool perElement = false;
+	};
 
-	template<>
-	void parseValue(simdjson::ondemand::value& json, lg::MeshPrimitive& val)
+	template<typename ElementType>
+	struct ReloadUnit<std::vector<ElementType>>
+	{
+		static constexpr bool perElement = std::is_class_v<ElementType>
+			&& !std::is_same_v<ElementType, std::string> && !std::is_same_v<ElementType, std::string_view>;
+		using Type = std::conditional_t<perElement, ElementType, std::vector<ElementType>>;
+	};
+
+	/**
+	 * Hash the JSON text of a top-level property, calling callback with the index, hash and text of every unit
+	 */
+	template<typename MemberType, typename Callback>
+	void hashProperty(simdjson::ondemand::value& json, Callback&& callback)
 	{
-		val = meshPrimitiveParser.parse(json);
+		if constexpr (ReloadUnit<MemberType>::perElement)
+		{
+			std::uint32_t index = 0;
+			for (simdjson::ondemand::value element: json.get_array())
+			{
+				std::string_view rawJson = parseRawJson(element);
+				callback(index++, hashJson(rawJson), rawJson);
+			}
+		}
+		else
+		{
+			std::string_view rawJson = parseRawJson(json);
+			callback(std::uint32_t{0}, hashJson(rawJson), rawJson);
+		}
 	}
 
-	auto const meshParser = ObjectParser<lg::Mesh>("mesh")
-		("primitives", &lg::Mesh::primitives)
-		("weights", &lg::Mesh::weights)
-		("name", &lg::Mesh::name)
-		("extensions", &lg::Mesh::extensions)
-		("extras", &lg::Mesh::extras);
+	/**
+	 * Parse a value from JSON text captured with parseRawJson
+	 */
+	template<typename ValueType>
+	void parseRawValue(simdjson::ondemand::parser& parser, ParseContext& context, std::string_view rawJson,
+		ValueType& val)
+	{
+		// Wrap the text in an array, as scalar documents can not be parsed as values
+		simdjson::padded_string text(rawJson.size() + 2);
+		text.data()[0] = '[';
+		std::copy(rawJson.cbegin(), rawJson.cend(), text.data() + 1);
+		text.data()[rawJson.size() + 1] = ']';
+		simdjson::ondemand::document doc = parser.iterate(text);
+		for (simdjson::ondemand::value value: doc.get_array())
+		{
+			parseValue(context, value, val);
+		}
+	}
 
-	template<>
-	void parseValue(simdjson::ondemand::value& json, lg::Mesh& val)
+	std::vector<std::uint32_t>* changedIndices(lg::ChangeSet& changes, std::string_view propertyName)
 	{
-		val = meshParser.parse(json);
+		if (propertyName == "nodes")
+		{
+			return &changes.nodes;
+		}
+		else if (propertyName == "meshes")
+		{
+			return &changes.meshes;
+		}
+		else if (propertyName == "materials")
+		{
+			return &changes.materials;
+		}
+		return nullptr;
 	}
 
-	auto const nodeParser = ObjectParser<lg::Node>("node")
-		("camera", &lg::Node::camera)
-		("children", &lg::Node::children)
-		("skin", &lg::Node::skin)
-		("matrix", &lg::Node::matrix)
-		("mesh", &lg::Node::mesh)
-		("rotation", &lg::Node::rotation)
-		("scale", &lg::Node::scale)
-		("translation", &lg::Node::translation)
-		("weights", &lg::Node::weights)
-		("name", &lg::Node::name)
-		("extensions", &lg::Node::extensions)
-		("extras", &lg::Node::extras);
+	lg::DocumentHashes hashDocument(std::string_view paddedInputJson)
+	{
+		simdjson::ondemand::parser parser;
+		simdjson::ondemand::document doc = parser.iterate(paddedInputJson, paddedInputJson.size() + lg::paddingSize);
+		lg::DocumentHashes result;
+		for (simdjson::ondemand::field field: doc.get_object())
+		{
+			std::string_view propertyName = field.unescaped_key();
+			simdjson::ondemand::value propertyValue = field.value();
+			bool const known = gltfParser<lg::OwningStorage>.visitField(propertyName,
+				[&]<typename MemberType>(ObjectParserField<lg::Gltf, MemberType>)
+			{
+				auto& hashes = result.properties[std::string(propertyName)];
+				hashes.clear();
+				hashProperty<MemberType>(propertyValue, [&hashes](std::uint32_t, std::uint64_t hash, std::string_view)
+				{
+					hashes.push_back(hash);
+				});
+			});
+			if (!known)
+			{
+				SPDLOG_INFO("Unknown {} property: {}", "GLTF", propertyName);
+			}
+		}
+		return result;
+	}
 
-	template<>
-	void parseValue(simdjson::ondemand::value& json, lg::Node& val)
+	template<typename Storage>
+	lg::ChangeSet reloadDocument(lg::BasicGltf<Storage>& gltf, lg::DocumentHashes& hashes,
+		std::string_view paddedInputJson)
 	{
-		val = nodeParser.parse(json);
+		simdjson::ondemand::parser parser;
+		simdjson::ondemand::document doc = parser.iterate(paddedInputJson, paddedInputJson.size() + lg::paddingSize);
+		SPDLOG_INFO("Reloading Gltf...");
+
+		// Changed values are parsed from their text by a second parser, and only moved into the document once all of
+		// the input has been read, so that errors leave the document unchanged
+		simdjson::ondemand::parser valueParser;
+		ParseContext context;
+		lg::DocumentHashes newHashes;
+		lg::ChangeSet changes;
+		std::vector<std::function<void()>> updates;
+		for (simdjson::ondemand::field field: doc.get_object())
+		{
+			std::string_view propertyName = field.unescaped_key();
+			simdjson::ondemand::value propertyValue = field.value();
+			bool const known = gltfParser<Storage>.visitField(propertyName,
+				[&]<typename MemberType>(ObjectParserField<lg::BasicGltf<Storage>, MemberType> objectParserField)
+			{
+				using Unit = typename ReloadUnit<MemberType>::Type;
+
+				std::string name(propertyName);
+				auto const previous = hashes.properties.find(name);
+				std::vector<std::uint64_t> const* previousHashes =
+					previous != hashes.properties.end() ? &previous->second : nullptr;
+				auto& propertyHashes = newHashes.properties[name];
+				propertyHashes.clear();
+
+				std::vector<std::pair<std::uint32_t, Unit>> changedUnits;
+				hashProperty<MemberType>(propertyValue,
+					[&](std::uint32_t index, std::uint64_t hash, std::string_view rawJson)
+				{
+					propertyHashes.push_back(hash);
+					if (previousHashes == nullptr || index >= previousHashes->size()
+						|| (*previousHashes)[index] != hash)
+					{
+						parseRawValue(valueParser, context, rawJson, changedUnits.emplace_back(index, Unit{}).second);
+					}
+				});
+				if (changedUnits.empty() && previousHashes != nullptr
+					&& previousHashes->size() == propertyHashes.size())
+				{
+					return;
+				}
+
+				changes.properties.push_back(std::move(name));
+				if (std::vector<std::uint32_t>* indices = changedIndices(changes, propertyName))
+				{
+					for (auto const& changedUnit: changedUnits)
+					{
+						indices->push_back(changedUnit.first);
+					}
+				}
+				updates.emplace_back([&gltf, member = objectParserField.fieldPtr, units = std::move(changedUnits),
+					size = propertyHashes.size()]() mutable
+				{
+					if constexpr (ReloadUnit<MemberType>::perElement)
+					{
+						(gltf.*member).resize(size);
+						for (auto& [index, unit]: units)
+						{
+							(gltf.*member)[index] = std::move(unit);
+						}
+					}
+					else
+					{
+						gltf.*member = std::move(units.front().second);
+					}
+				});
+			});
+			if (!known)
+			{
+				SPDLOG_INFO("Unknown {} property: {}", "GLTF", propertyName);
+			}
+		}
+
+		// Properties that are no longer present are reset to their defaults
+		for (auto const& property: hashes.properties)
+		{
+			if (newHashes.properties.contains(property.first))
+			{
+				continue;
+			}
+			changes.properties.push_back(property.first);
+			gltfParser<Storage>.visitField(property.first,
+				[&]<typename MemberType>(ObjectParserField<lg::BasicGltf<Storage>, MemberType> objectParserField)
+			{
+				updates.emplace_back([&gltf, member = objectParserField.fieldPtr]()
+				{
+					gltf.*member = MemberType{};
+				});
+			});
+		}
+
+		for (auto& update: updates)
+		{
+			update();
+		}
+		hashes = std::move(newHashes);
+		return changes;
 	}
 
-	auto const samplerParser = ObjectParser<lg::Sampler>("sampler")
-		("magFilter", &lg::Sampler::magFilter)
-		("minFilter", &lg::Sampler::minFilter)
-		("wrapS", &lg::Sampler::wrapS)
-		("wrapT", &lg::Sampler::wrapT)
-		("name", &lg::Sampler::name)
-		("extensions", &lg::Sampler::extensions)
-		("extras", &lg::Sampler::extras);
+	// ********************* Writing *********************
 
-	template<>
-	void parseValue(simdjson::ondemand::value& json, lg::Sampler& val)
+	constexpr std::uint32_t glbMagic = 0x46546c67;
+	constexpr std::uint32_t glbVersion = 2;
+	constexpr std::uint32_t glbJsonChunkType = 0x4e4f534a;
+	constexpr std::uint32_t glbBinChunkType = 0x004e4942;
+	constexpr std::size_t glbHeaderSize = 12;
+	constexpr std::size_t glbChunkHeaderSize = 8;
+
+	template<typename Storage>
+	void writeDocument(lg::BasicGltf<Storage> const& gltf, std::string& buffer, lg::OutputSink const* sink)
 	{
-		val = samplerParser.parse(json);
+		JsonWriter writer{buffer, sink};
+		gltfParser<Storage>.write(writer, gltf);
+		writer.flush();
 	}
 
-	auto const sceneParser = ObjectParser<lg::Scene>("scene")
-		("nodes", &lg::Scene::nodes)
-		("name", &lg::Scene::name)
-		("extensions", &lg::Scene::extensions)
-		("extras", &lg::Scene::extras);
+	template<typename Storage>
+	std::string writeDocument(lg::BasicGltf<Storage> const& gltf)
+	{
+		std::string result;
+		writeDocument(gltf, result, nullptr);
+		return result;
+	}
 
-	template<>
-	void parseValue(simdjson::ondemand::value& json, lg::Scene& val)
+	template<typename Storage>
+	void writeDocument(lg::BasicGltf<Storage> const& gltf, lg::OutputSink const& sink)
 	{
-		val = sceneParser.parse(json);
+		std::string buffer;
+		buffer.reserve(JsonWriter::flushSize * 2);
+		writeDocument(gltf, buffer, &sink);
 	}
 
-	auto const skinParser = ObjectParser<lg::Skin>("skin")
-		("inverseBindMatrices", &lg::Skin::inverseBindMatrices)
-		("skeleton", &lg::Skin::skeleton)
-		("joints", &lg::Skin::joints)
-		("name", &lg::Skin::name)
-		("extensions", &lg::Skin::extensions)
-		("extras", &lg::Skin::extras);
+	std::size_t padTo4(std::size_t size)
+	{
+		return (size + 3) & ~std::size_t{3};
+	}
 
-	template<>
-	void parseValue(simdjson::ondemand::value& json, lg::Skin& val)
+	/**
+	 * @return the JSON chunk of a GLB file, padded with spaces
+	 */
+	template<typename Storage>
+	std::string writeGlbJson(lg::BasicGltf<Storage> const& gltf, lg::BufferData binChunk)
+	{
+		if (!binChunk.empty()
+			&& (gltf.buffers.empty() || gltf.buffers.front().uri || gltf.buffers.front().byteLength != binChunk.size()))
+		{
+			throw std::invalid_argument("The binary chunk must be the contents of a first buffer without a URI");
+		}
+		if (binChunk.empty() && !gltf.buffers.empty() && !gltf.buffers.front().uri
+			&& gltf.buffers.front().byteLength != 0)
+		{
+			throw std::invalid_argument("A first buffer without a URI needs its contents as the binary chunk");
+		}
+
+		std::string json;
+		writeDocument(gltf, json, nullptr);
+		json.resize(padTo4(json.size()), ' ');
+		return json;
+	}
+
+	std::size_t glbSize(std::string_view json, lg::BufferData binChunk)
+	{
+		std::size_t size = glbHeaderSize + glbChunkHeaderSize + json.size();
+		if (!binChunk.empty())
+		{
+			size += glbChunkHeaderSize + padTo4(binChunk.size());
+		}
+		if (size > std::numeric_limits<std::uint32_t>::max())
+		{
+			throw std::invalid_argument("Document too large for GLB");
+		}
+		return size;
+	}
+
+	void storeUint32(std::byte* destination, std::uint32_t value)
 	{
-		val = skinParser.parse(json);
+		for (std::size_t i = 0; i < sizeof(value); ++i)
+		{
+			destination[i] = static_cast<std::byte>(value >> (i * 8));
+		}
 	}
 
-	auto const textureParser = ObjectParser<lg::Texture>("texture")
-		("sampler", &lg::Texture::sampler)
-		("source", &lg::Texture::source)
-		("name", &lg::Texture::name)
-		("extensions", &lg::Texture::extensions)
-		("extras", &lg::Texture::extras);
+	void writeGlbChunks(std::string_view json, lg::BufferData binChunk, lg::OutputSink const& sink)
+	{
+		std::array<std::byte, glbHeaderSize + glbChunkHeaderSize> header;
+		storeUint32(header.data(), glbMagic);
+		storeUint32(header.data() + 4, glbVersion);
+		storeUint32(header.data() + 8, static_cast<std::uint32_t>(glbSize(json, binChunk)));
+		storeUint32(header.data() + 12, static_cast<std::uint32_t>(json.size()));
+		storeUint32(header.data() + 16, glbJsonChunkType);
+		sink(header);
+		sink(std::as_bytes(std::span(json)));
+
+		if (!binChunk.empty())
+		{
+			std::size_t const paddedSize = padTo4(binChunk.size());
+			std::array<std::byte, glbChunkHeaderSize> chunkHeader;
+			storeUint32(chunkHeader.data(), static_cast<std::uint32_t>(paddedSize));
+			storeUint32(chunkHeader.data() + 4, glbBinChunkType);
+			sink(chunkHeader);
+			sink(binChunk);
+			std::array<std::byte, 3> const padding = {};
+			if (paddedSize != binChunk.size())
+			{
+				sink(std::span(padding).first(paddedSize - binChunk.size()));
+			}
+		}
+	}
 
-	template<>
-	void parseValue(simdjson::ondemand::value& json, lg::Texture& val)
-	{
-		val = textureParser.parse(json);
-	}
-
-	auto const gltfParser = ObjectParser<lg::Gltf>("GLTF")
-		("extensionsUsed", &lg::Gltf::extensionsUsed)
-		("extensionsRequired", &lg::Gltf::extensionsRequired)
-		("accessors", &lg::Gltf::accessors)
-		("animations", &lg::Gltf::animations)
-		("asset", &lg::Gltf::asset)
-		("buffers", &lg::Gltf::buffers)
-		("bufferViews", &lg::Gltf::bufferViews)
-		("cameras", &lg::Gltf::cameras)
-		("images", &lg::Gltf::images)
-		("materials", &lg::Gltf::materials)
-		("meshes", &lg::Gltf::meshes)
-		("nodes", &lg::Gltf::nodes)
-		("samplers", &lg::Gltf::samplers)
-		("scene", &lg::Gltf::scene)
-		("scenes", &lg::Gltf::scenes)
-		("skins", &lg::Gltf::skins)
-		("textures", &lg::Gltf::textures)
-		("extensions", &lg::Gltf::extensions)
-		("extras", &lg::Gltf::extras);
+	template<typename Storage>
+	std::vector<std::byte> writeGlbDocument(lg::BasicGltf<Storage> const& gltf, lg::BufferData binChunk)
+	{
+		std::string const json = writeGlbJson(gltf, binChunk);
+		std::vector<std::byte> result;
+		result.reserve(glbSize(json, binChunk));
+		writeGlbChunks(json, binChunk, [&result](std::span<std::byte const> data)
+		{
+			result.insert(result.end(), data.begin(), data.end());
+		});
+		return result;
+	}
+
+	template<typename Storage>
+	void writeGlbDocument(lg::BasicGltf<Storage> const& gltf, lg::BufferData binChunk, lg::OutputSink const& sink)
+	{
+		writeGlbChunks(writeGlbJson(gltf, binChunk), binChunk, sink);
+	}
 }
 
 lg::Gltf lg::loadGltf(std::string_view inputJson)
@@ -665,7 +2062,140 @@ lg::Gltf lg::loadGltfPrePadded(std::string_view paddedInputJson)
 	simdjson::ondemand::parser parser;
 	simdjson::ondemand::document doc = parser.iterate(paddedInputJson, paddedInputJson.size() + lg::paddingSize);
 	SPDLOG_INFO("Loading Gltf...");
-	lg::Gltf result = gltfParser.parse(doc);
-	// TODO: Implement validation
+	ParseContext context;
+	lg::Gltf result = gltfParser<lg::OwningStorage>.parse(context, doc);
+	return result;
+}
+
+lg::FloatGltf lg::loadGltfFloat(std::string_view inputJson)
+{
+	return lg::loadGltfFloatPrePadded(simdjson::padded_string(inputJson));
+}
+
+lg::FloatGltf lg::loadGltfFloatPrePadded(std::string_view paddedInputJson)
+{
+	simdjson::ondemand::parser parser;
+	simdjson::ondemand::document doc = parser.iterate(paddedInputJson, paddedInputJson.size() + lg::paddingSize);
+	SPDLOG_INFO("Loading single precision Gltf...");
+	ParseContext context;
+	lg::FloatGltf result = gltfParser<lg::FloatStorage>.parse(context, doc);
 	return result;
 }
+
+lg::BorrowedGltf lg::loadGltfBorrowed(std::string_view paddedInputJson)
+{
+	simdjson::ondemand::parser parser;
+	simdjson::ondemand::document doc = parser.iterate(paddedInputJson, paddedInputJson.size() + lg::paddingSize);
+	SPDLOG_INFO("Loading borrowed Gltf...");
+	lg::BorrowingStorage::StringArena stringArena;
+	ParseContext context{&stringArena};
+	lg::BorrowedGltf result = gltfParser<lg::BorrowingStorage>.parse(context, doc);
+	result.stringArena = std::move(stringArena);
+	return result;
+}
+
+lg::SoAScene lg::loadSoAScene(std::string_view paddedInputJson)
+{
+	simdjson::ondemand::parser parser;
+	simdjson::ondemand::document doc = parser.iterate(paddedInputJson, paddedInputJson.size() + lg::paddingSize);
+	SPDLOG_INFO("Loading SoA scene...");
+	return parseSoAScene<lg::OwningStorage>(doc);
+}
+
+lg::FloatSoAScene lg::loadSoASceneFloat(std::string_view paddedInputJson)
+{
+	simdjson::ondemand::parser parser;
+	simdjson::ondemand::document doc = parser.iterate(paddedInputJson, paddedInputJson.size() + lg::paddingSize);
+	SPDLOG_INFO("Loading single precision SoA scene...");
+	return parseSoAScene<lg::FloatStorage>(doc);
+}
+
+lg::DocumentHashes lg::hashGltf(std::string_view inputJson)
+{
+	return lg::hashGltfPrePadded(simdjson::padded_string(inputJson));
+}
+
+lg::DocumentHashes lg::hashGltfPrePadded(std::string_view paddedInputJson)
+{
+	return hashDocument(paddedInputJson);
+}
+
+lg::ChangeSet lg::reload(lg::Gltf& gltf, lg::DocumentHashes& hashes, std::string_view inputJson)
+{
+	return lg::reloadPrePadded(gltf, hashes, simdjson::padded_string(inputJson));
+}
+
+lg::ChangeSet lg::reload(lg::FloatGltf& gltf, lg::DocumentHashes& hashes, std::string_view inputJson)
+{
+	return lg::reloadPrePadded(gltf, hashes, simdjson::padded_string(inputJson));
+}
+
+lg::ChangeSet lg::reloadPrePadded(lg::Gltf& gltf, lg::DocumentHashes& hashes, std::string_view paddedInputJson)
+{
+	return reloadDocument(gltf, hashes, paddedInputJson);
+}
+
+lg::ChangeSet lg::reloadPrePadded(lg::FloatGltf& gltf, lg::DocumentHashes& hashes, std::string_view paddedInputJson)
+{
+	return reloadDocument(gltf, hashes, paddedInputJson);
+}
+
+std::string lg::writeGltf(lg::Gltf const& gltf)
+{
+	return writeDocument(gltf);
+}
+
+std::string lg::writeGltf(lg::BorrowedGltf const& gltf)
+{
+	return writeDocument(gltf);
+}
+
+std::string lg::writeGltf(lg::FloatGltf const& gltf)
+{
+	return writeDocument(gltf);
+}
+
+void lg::writeGltf(lg::Gltf const& gltf, lg::OutputSink const& sink)
+{
+	writeDocument(gltf, sink);
+}
+
+void lg::writeGltf(lg::BorrowedGltf const& gltf, lg::OutputSink const& sink)
+{
+	writeDocument(gltf, sink);
+}
+
+void lg::writeGltf(lg::FloatGltf const& gltf, lg::OutputSink const& sink)
+{
+	writeDocument(gltf, sink);
+}
+
+std::vector<std::byte> lg::writeGlb(lg::Gltf const& gltf, lg::BufferData binChunk)
+{
+	return writeGlbDocument(gltf, binChunk);
+}
+
+std::vector<std::byte> lg::writeGlb(lg::BorrowedGltf const& gltf, lg::BufferData binChunk)
+{
+	return writeGlbDocument(gltf, binChunk);
+}
+
+std::vector<std::byte> lg::writeGlb(lg::FloatGltf const& gltf, lg::BufferData binChunk)
+{
+	return writeGlbDocument(gltf, binChunk);
+}
+
+void lg::writeGlb(lg::Gltf const& gltf, lg::BufferData binChunk, lg::OutputSink const& sink)
+{
+	writeGlbDocument(gltf, binChunk, sink);
+}
+
+void lg::writeGlb(lg::BorrowedGltf const& gltf, lg::BufferData binChunk, lg::OutputSink const& sink)
+{
+	writeGlbDocument(gltf, binChunk, sink);
+}
+
+void lg::writeGlb(lg::FloatGltf const& gltf, lg::BufferData binChunk, lg::OutputSink const& sink)
+{
+	writeGlbDocument(gltf, binChunk, sink);
+}
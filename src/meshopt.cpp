@@ -0,0 +1,933 @@
+// SPDX-License-Identifier: MIT
+// Copyright © 2022 Sebastian Larsson
+
+#include <load-gltf/meshopt.hpp>
+
+#include <load-gltf/structs.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#define LG_SSE2
+#include <emmintrin.h>
+#endif
+
+// The byte group decoder needs SSSE3 shuffles, which are not part of the x86-64 baseline, so check for them at runtime
+#if defined(LG_SSE2) && (defined(__GNUC__) || defined(__clang__))
+#define LG_SSSE3
+#include <tmmintrin.h>
+#endif
+
+namespace {
+	// *** Attribute codec ***
+
+	constexpr std::uint8_t attributeHeader = 0xa0;
+	constexpr std::size_t byteGroupSize = 16;
+	// Decoding a byte group reads at most this many bytes, which valid data always has left thanks to its tail
+	constexpr std::size_t byteGroupDecodeLimit = 24;
+	constexpr std::size_t blockMaxBytes = 8192;
+	constexpr std::size_t blockMaxVertices = 256;
+	constexpr std::size_t tailMinSize = 32;
+
+	std::uint8_t unzigzag8(std::uint8_t value) noexcept
+	{
+		return static_cast<std::uint8_t>(-(value & 1) ^ (value >> 1));
+	}
+
+	std::size_t byteGroupHeaderSize(std::size_t size) noexcept
+	{
+		// Two bits per group
+		return (size / byteGroupSize + 3) / 4;
+	}
+
+	int byteGroupBits(std::uint8_t const* header, std::size_t group) noexcept
+	{
+		return (header[group / 4] >> (group % 4 * 2)) & 3;
+	}
+
+	/**
+	 * Decode a group of 16 bytes, stored with 0, 2, 4 or 8 bits each
+	 *
+	 * Values with all bits set are sentinels, for values stored in full after the packed bits.
+	 */
+	std::uint8_t const* decodeByteGroup(std::uint8_t const* data, std::uint8_t* buffer, int bitsLog2) noexcept
+	{
+		switch (bitsLog2)
+		{
+			case 0:
+				std::memset(buffer, 0, byteGroupSize);
+				return data;
+			case 1:
+			case 2:
+			{
+				int const bits = 1 << bitsLog2;
+				std::uint8_t const sentinel = static_cast<std::uint8_t>((1 << bits) - 1);
+				std::uint8_t const* extra = data + bits * byteGroupSize / 8;
+				for (std::size_t i = 0; i < byteGroupSize; ++i)
+				{
+					// Packed most significant bits first
+					std::size_t const bit = i * bits;
+					std::uint8_t value = (data[bit / 8] >> (8 - bits - bit % 8)) & sentinel;
+					if (value == sentinel)
+					{
+						value = *extra++;
+					}
+					buffer[i] = value;
+				}
+				return extra;
+			}
+			default:
+				std::memcpy(buffer, data, byteGroupSize);
+				return data + byteGroupSize;
+		}
+	}
+
+	std::uint8_t const* decodeBytes(std::uint8_t const* data, std::uint8_t const* end, std::uint8_t* buffer,
+		std::size_t size)
+	{
+		std::uint8_t const* header = data;
+		std::size_t const headerSize = byteGroupHeaderSize(size);
+		if (static_cast<std::size_t>(end - data) < headerSize)
+		{
+			throw std::invalid_argument("Truncated meshopt attribute data");
+		}
+		data += headerSize;
+		for (std::size_t i = 0; i < size; i += byteGroupSize)
+		{
+			if (static_cast<std::size_t>(end - data) < byteGroupDecodeLimit)
+			{
+				throw std::invalid_argument("Truncated meshopt attribute data");
+			}
+			data = decodeByteGroup(data, buffer + i, byteGroupBits(header, i / byteGroupSize));
+		}
+		return data;
+	}
+
+#ifdef LG_SSSE3
+	struct ByteGroupShuffles
+	{
+		/// Shuffle gathering the sentinel values of 8 bytes, for every mask of sentinel positions
+		std::array<std::array<std::uint8_t, 8>, 256> shuffles = {};
+		/// Number of sentinels in every mask
+		std::array<std::uint8_t, 256> counts = {};
+	};
+
+	constexpr ByteGroupShuffles byteGroupShuffles = []
+	{
+		ByteGroupShuffles result;
+		for (std::size_t mask = 0; mask < 256; ++mask)
+		{
+			std::uint8_t count = 0;
+			for (std::size_t i = 0; i < 8; ++i)
+			{
+				bool const isSentinel = (mask >> i) & 1;
+				result.shuffles[mask][i] = isSentinel ? count : 0x80;
+				count += isSentinel;
+			}
+			result.counts[mask] = count;
+		}
+		return result;
+	}();
+
+	[[gnu::target("ssse3")]]
+	std::uint8_t const* decodeByteGroupSsse3(std::uint8_t const* data, std::uint8_t* buffer, int bitsLog2) noexcept
+	{
+		if (bitsLog2 == 0 || bitsLog2 == 3)
+		{
+			return decodeByteGroup(data, buffer, bitsLog2);
+		}
+
+		// Spread the packed bits to one value per byte, most significant bits first
+		std::size_t const headerSize = bitsLog2 == 1 ? 4 : 8;
+		__m128i values;
+		if (bitsLog2 == 1)
+		{
+			std::int32_t packed;
+			std::memcpy(&packed, data, sizeof(packed));
+			__m128i const bits2 = _mm_cvtsi32_si128(packed);
+			__m128i const bits4 = _mm_unpacklo_epi8(_mm_srli_epi16(bits2, 4), bits2);
+			__m128i const bits8 = _mm_unpacklo_epi8(_mm_srli_epi16(bits4, 2), bits4);
+			values = _mm_and_si128(bits8, _mm_set1_epi8(3));
+		}
+		else
+		{
+			__m128i const bits4 = _mm_loadl_epi64(reinterpret_cast<__m128i const*>(data));
+			__m128i const bits8 = _mm_unpacklo_epi8(_mm_srli_epi16(bits4, 4), bits4);
+			values = _mm_and_si128(bits8, _mm_set1_epi8(15));
+		}
+		__m128i const sentinel = bitsLog2 == 1 ? _mm_set1_epi8(3) : _mm_set1_epi8(15);
+		__m128i const isSentinel = _mm_cmpeq_epi8(values, sentinel);
+		int const mask = _mm_movemask_epi8(isSentinel);
+		int const mask0 = mask & 0xff;
+		int const mask1 = mask >> 8;
+
+		// Gather the full values following the packed bits into the sentinel positions
+		__m128i const shuffle0 = _mm_loadl_epi64(
+			reinterpret_cast<__m128i const*>(byteGroupShuffles.shuffles[mask0].data()));
+		__m128i const shuffle1 = _mm_add_epi8(
+			_mm_loadl_epi64(reinterpret_cast<__m128i const*>(byteGroupShuffles.shuffles[mask1].data())),
+			_mm_set1_epi8(static_cast<char>(byteGroupShuffles.counts[mask0])));
+		__m128i const extra = _mm_loadu_si128(reinterpret_cast<__m128i const*>(data + headerSize));
+		__m128i const result = _mm_or_si128(_mm_shuffle_epi8(extra, _mm_unpacklo_epi64(shuffle0, shuffle1)),
+			_mm_andnot_si128(isSentinel, values));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(buffer), result);
+		return data + headerSize + byteGroupShuffles.counts[mask0] + byteGroupShuffles.counts[mask1];
+	}
+
+	[[gnu::target("ssse3")]]
+	std::uint8_t const* decodeBytesSsse3(std::uint8_t const* data, std::uint8_t const* end, std::uint8_t* buffer,
+		std::size_t size)
+	{
+		std::uint8_t const* header = data;
+		std::size_t const headerSize = byteGroupHeaderSize(size);
+		if (static_cast<std::size_t>(end - data) < headerSize)
+		{
+			throw std::invalid_argument("Truncated meshopt attribute data");
+		}
+		data += headerSize;
+		for (std::size_t i = 0; i < size; i += byteGroupSize)
+		{
+			if (static_cast<std::size_t>(end - data) < byteGroupDecodeLimit)
+			{
+				throw std::invalid_argument("Truncated meshopt attribute data");
+			}
+			data = decodeByteGroupSsse3(data, buffer + i, byteGroupBits(header, i / byteGroupSize));
+		}
+		return data;
+	}
+#endif
+
+	using DecodeBytes = std::uint8_t const* (*)(std::uint8_t const* data, std::uint8_t const* end,
+		std::uint8_t* buffer, std::size_t size);
+
+	DecodeBytes selectDecodeBytes() noexcept
+	{
+#ifdef LG_SSSE3
+		if (__builtin_cpu_supports("ssse3"))
+		{
+			return decodeBytesSsse3;
+		}
+#endif
+		return decodeBytes;
+	}
+
+	void decodeAttributes(std::uint8_t* destination, std::size_t count, std::size_t stride, std::uint8_t const* data,
+		std::size_t size)
+	{
+		if (stride == 0 || stride > 256 || stride % 4 != 0)
+		{
+			throw std::invalid_argument("Unsupported meshopt attribute byte stride");
+		}
+		if (size < 1 + stride)
+		{
+			throw std::invalid_argument("Truncated meshopt attribute data");
+		}
+		if ((data[0] & 0xf0) != attributeHeader)
+		{
+			throw std::invalid_argument("Not meshopt attribute data");
+		}
+		if ((data[0] & 0x0f) != 0)
+		{
+			throw std::invalid_argument("Unsupported meshopt attribute codec version");
+		}
+		std::uint8_t const* const end = data + size;
+		++data;
+
+		static DecodeBytes const decodeBlockBytes = selectDecodeBytes();
+
+		// The tail holds the vertex the first block is delta encoded against
+		std::array<std::uint8_t, 256> lastVertex = {};
+		std::memcpy(lastVertex.data(), end - stride, stride);
+		std::size_t const blockSize = std::min(blockMaxBytes / stride & ~(byteGroupSize - 1), blockMaxVertices);
+		std::array<std::uint8_t, blockMaxVertices> bytes = {};
+		for (std::size_t offset = 0; offset < count; offset += blockSize)
+		{
+			// Every byte of the vertices of a block is stored separately, as deltas between consecutive vertices
+			std::size_t const blockCount = std::min(blockSize, count - offset);
+			std::size_t const alignedCount = (blockCount + byteGroupSize - 1) & ~(byteGroupSize - 1);
+			std::uint8_t* const block = destination + offset * stride;
+			for (std::size_t k = 0; k < stride; ++k)
+			{
+				data = decodeBlockBytes(data, end, bytes.data(), alignedCount);
+				std::uint8_t previous = lastVertex[k];
+				for (std::size_t i = 0; i < blockCount; ++i)
+				{
+					previous = static_cast<std::uint8_t>(unzigzag8(bytes[i]) + previous);
+					block[i * stride + k] = previous;
+				}
+			}
+			std::memcpy(lastVertex.data(), block + (blockCount - 1) * stride, stride);
+		}
+
+		if (static_cast<std::size_t>(end - data) != std::max(stride, tailMinSize))
+		{
+			throw std::invalid_argument("Malformed meshopt attribute data");
+		}
+	}
+
+	// *** Index codecs ***
+
+	constexpr std::uint8_t triangleHeader = 0xe0;
+	constexpr std::uint8_t sequenceHeader = 0xd0;
+
+	std::uint32_t decodeVByte(std::uint8_t const*& data) noexcept
+	{
+		std::uint8_t const lead = *data++;
+		if (lead < 128)
+		{
+			return lead;
+		}
+		std::uint32_t result = lead & 127;
+		for (std::uint32_t shift = 7; shift < 35; shift += 7)
+		{
+			std::uint8_t const group = *data++;
+			result |= std::uint32_t{group & 127u} << shift;
+			if (group < 128)
+			{
+				break;
+			}
+		}
+		return result;
+	}
+
+	std::uint32_t unzigzag32(std::uint32_t value) noexcept
+	{
+		return (value >> 1) ^ (0u - (value & 1));
+	}
+
+	template<typename Index>
+	void writeIndex(std::uint8_t* destination, std::size_t i, std::uint32_t index) noexcept
+	{
+		auto const value = static_cast<Index>(index);
+		std::memcpy(destination + i * sizeof(Index), &value, sizeof(Index));
+	}
+
+	/**
+	 * Decode a triangle list, encoded as references to a FIFO of recent edges and one of recent vertices
+	 *
+	 * The FIFOs must be updated exactly as the encoder did.
+	 */
+	template<typename Index>
+	void decodeTriangles(std::uint8_t* destination, std::size_t count, std::uint8_t const* buffer, std::size_t size)
+	{
+		if (count % 3 != 0)
+		{
+			throw std::invalid_argument("Triangle index count is not a multiple of 3");
+		}
+		if (size < 1 + count / 3 + 16)
+		{
+			throw std::invalid_argument("Truncated meshopt triangle data");
+		}
+		if ((buffer[0] & 0xf0) != triangleHeader)
+		{
+			throw std::invalid_argument("Not meshopt triangle data");
+		}
+		int const version = buffer[0] & 0x0f;
+		if (version > 1)
+		{
+			throw std::invalid_argument("Unsupported meshopt triangle codec version");
+		}
+
+		std::array<std::array<std::uint32_t, 2>, 16> edges;
+		std::array<std::uint32_t, 16> vertices;
+		edges.fill({lg::noIndex, lg::noIndex});
+		vertices.fill(lg::noIndex);
+		std::uint32_t edgeOffset = 0;
+		std::uint32_t vertexOffset = 0;
+		auto pushEdge = [&edges, &edgeOffset](std::uint32_t a, std::uint32_t b)
+		{
+			edges[edgeOffset] = {a, b};
+			edgeOffset = (edgeOffset + 1) & 15;
+		};
+		auto pushVertex = [&vertices, &vertexOffset](std::uint32_t vertex, bool isNew = true)
+		{
+			vertices[vertexOffset] = vertex;
+			vertexOffset = (vertexOffset + isNew) & 15;
+		};
+
+		std::uint32_t next = 0;
+		std::uint32_t last = 0;
+		auto decodeIndex = [&last](std::uint8_t const*& data)
+		{
+			last += unzigzag32(decodeVByte(data));
+			return last;
+		};
+		// Version 1 encodes small deltas to the last free index in the vertex FIFO reference
+		int const vertexReferenceMax = version >= 1 ? 13 : 15;
+
+		// One code per triangle, then free indices, then a table of the 16 most common auxiliary codes
+		std::uint8_t const* codes = buffer + 1;
+		std::uint8_t const* data = codes + count / 3;
+		std::uint8_t const* const dataEnd = buffer + size - 16;
+		std::uint8_t const* const auxiliaryCodes = dataEnd;
+		for (std::size_t i = 0; i < count; i += 3)
+		{
+			// A triangle reads at most 16 bytes of data, which the auxiliary code table guarantees are readable
+			if (data > dataEnd)
+			{
+				throw std::invalid_argument("Truncated meshopt triangle data");
+			}
+
+			std::uint8_t const code = codes[i / 3];
+			std::uint32_t a = 0;
+			std::uint32_t b = 0;
+			std::uint32_t c = 0;
+			if (code < 0xf0)
+			{
+				// Edge from the FIFO, and a third vertex that is new, from the FIFO, or free
+				std::array<std::uint32_t, 2> const edge = edges[(edgeOffset - 1 - (code >> 4)) & 15];
+				a = edge[0];
+				b = edge[1];
+				int const vertexReference = code & 15;
+				if (vertexReference < vertexReferenceMax)
+				{
+					bool const isNew = vertexReference == 0;
+					c = isNew ? next++ : vertices[(vertexOffset - 1 - vertexReference) & 15];
+					pushVertex(c, isNew);
+				}
+				else
+				{
+					// Free index, or the last free index plus or minus one
+					if (vertexReference == 15)
+					{
+						c = decodeIndex(data);
+					}
+					else
+					{
+						c = last = vertexReference == 13 ? last - 1 : last + 1;
+					}
+					pushVertex(c);
+				}
+				pushEdge(c, b);
+				pushEdge(a, c);
+			}
+			else if (code < 0xfe)
+			{
+				// Three vertices that are new or from the FIFO, with the reference codes in the table. The table can
+				// not refer to free indices, so a reference of 15 reads the FIFO like any other.
+				std::uint8_t const auxiliaryCode = auxiliaryCodes[code & 15];
+				int const bReference = auxiliaryCode >> 4;
+				int const cReference = auxiliaryCode & 15;
+				a = next++;
+				b = bReference == 0 ? next++ : vertices[(vertexOffset - bReference) & 15];
+				c = cReference == 0 ? next++ : vertices[(vertexOffset - cReference) & 15];
+				pushVertex(a);
+				pushVertex(b, bReference == 0);
+				pushVertex(c, cReference == 0);
+				pushEdge(b, a);
+				pushEdge(c, b);
+				pushEdge(a, c);
+			}
+			else
+			{
+				// Three vertices that are new, from the FIFO, or free, with the reference codes in a byte of their own
+				std::uint8_t const auxiliaryCode = *data++;
+				int const aReference = code == 0xfe ? 0 : 15;
+				int const bReference = auxiliaryCode >> 4;
+				int const cReference = auxiliaryCode & 15;
+				// A zero code that could have been taken from the table restarts the numbering of new vertices
+				if (auxiliaryCode == 0)
+				{
+					next = 0;
+				}
+
+				a = aReference == 0 ? next++ : 0;
+				b = bReference == 0 ? next++ : vertices[(vertexOffset - bReference) & 15];
+				c = cReference == 0 ? next++ : vertices[(vertexOffset - cReference) & 15];
+				if (aReference == 15)
+				{
+					a = decodeIndex(data);
+				}
+				if (bReference == 15)
+				{
+					b = decodeIndex(data);
+				}
+				if (cReference == 15)
+				{
+					c = decodeIndex(data);
+				}
+				pushVertex(a);
+				pushVertex(b, bReference == 0 || bReference == 15);
+				pushVertex(c, cReference == 0 || cReference == 15);
+				pushEdge(b, a);
+				pushEdge(c, b);
+				pushEdge(a, c);
+			}
+			writeIndex<Index>(destination, i + 0, a);
+			writeIndex<Index>(destination, i + 1, b);
+			writeIndex<Index>(destination, i + 2, c);
+		}
+
+		if (data != dataEnd)
+		{
+			throw std::invalid_argument("Malformed meshopt triangle data");
+		}
+	}
+
+	/**
+	 * Decode an index sequence, encoded as deltas to one of two previous indices
+	 */
+	template<typename Index>
+	void decodeSequence(std::uint8_t* destination, std::size_t count, std::uint8_t const* buffer, std::size_t size)
+	{
+		if (size < 1 + count + 4)
+		{
+			throw std::invalid_argument("Truncated meshopt index data");
+		}
+		if ((buffer[0] & 0xf0) != sequenceHeader)
+		{
+			throw std::invalid_argument("Not meshopt index data");
+		}
+		if ((buffer[0] & 0x0f) > 1)
+		{
+			throw std::invalid_argument("Unsupported meshopt index codec version");
+		}
+
+		std::uint8_t const* data = buffer + 1;
+		// An index reads at most 5 bytes of data, which the 4 byte tail guarantees are readable
+		std::uint8_t const* const dataEnd = buffer + size - 4;
+		std::array<std::uint32_t, 2> last = {};
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			if (data >= dataEnd)
+			{
+				throw std::invalid_argument("Truncated meshopt index data");
+			}
+			std::uint32_t const value = decodeVByte(data);
+			std::uint32_t& baseline = last[value & 1];
+			baseline += unzigzag32(value >> 1);
+			writeIndex<Index>(destination, i, baseline);
+		}
+
+		if (data != dataEnd)
+		{
+			throw std::invalid_argument("Malformed meshopt index data");
+		}
+	}
+
+	// *** Filters ***
+
+	template<typename Component>
+	Component loadComponent(std::uint8_t const* data, std::size_t i) noexcept
+	{
+		Component value;
+		std::memcpy(&value, data + i * sizeof(Component), sizeof(Component));
+		return value;
+	}
+
+	template<typename Component>
+	void storeComponent(std::uint8_t* data, std::size_t i, int value) noexcept
+	{
+		auto const component = static_cast<Component>(value);
+		std::memcpy(data + i * sizeof(Component), &component, sizeof(Component));
+	}
+
+	int roundToInt(float value) noexcept
+	{
+		return static_cast<int>(value + (value >= 0.0f ? 0.5f : -0.5f));
+	}
+
+	/**
+	 * Decode normalized vectors, stored as octahedral x and y followed by the encoded length in z
+	 */
+	template<typename Component>
+	void filterOctahedral(std::uint8_t* data, std::size_t begin, std::size_t count) noexcept
+	{
+		float const max = static_cast<float>((1 << (sizeof(Component) * 8 - 1)) - 1);
+		for (std::size_t i = begin; i < count; ++i)
+		{
+			float x = loadComponent<Component>(data, i * 4 + 0);
+			float y = loadComponent<Component>(data, i * 4 + 1);
+			float const z = loadComponent<Component>(data, i * 4 + 2) - std::fabs(x) - std::fabs(y);
+
+			// Unfold the lower hemisphere
+			float const t = z < 0.0f ? z : 0.0f;
+			x += x >= 0.0f ? t : -t;
+			y += y >= 0.0f ? t : -t;
+
+			float const scale = max / std::sqrt(x * x + y * y + z * z);
+			storeComponent<Component>(data, i * 4 + 0, roundToInt(x * scale));
+			storeComponent<Component>(data, i * 4 + 1, roundToInt(y * scale));
+			storeComponent<Component>(data, i * 4 + 2, roundToInt(z * scale));
+		}
+	}
+
+	/**
+	 * Decode unit quaternions, stored as the three smallest components and the index of the largest one
+	 */
+	void filterQuaternion(std::uint8_t* data, std::size_t begin, std::size_t count) noexcept
+	{
+		float const range = 1.0f / std::sqrt(2.0f);
+		for (std::size_t i = begin; i < count; ++i)
+		{
+			// The bits above the index of the largest component hold the scale of the others
+			int const stored = loadComponent<std::int16_t>(data, i * 4 + 3);
+			float const scale = range / static_cast<float>(stored | 3);
+			float const x = loadComponent<std::int16_t>(data, i * 4 + 0) * scale;
+			float const y = loadComponent<std::int16_t>(data, i * 4 + 1) * scale;
+			float const z = loadComponent<std::int16_t>(data, i * 4 + 2) * scale;
+			float const ww = 1.0f - x * x - y * y - z * z;
+			float const w = std::sqrt(ww >= 0.0f ? ww : 0.0f);
+
+			int const largest = stored & 3;
+			storeComponent<std::int16_t>(data, i * 4 + ((largest + 1) & 3), roundToInt(x * 32767.0f));
+			storeComponent<std::int16_t>(data, i * 4 + ((largest + 2) & 3), roundToInt(y * 32767.0f));
+			storeComponent<std::int16_t>(data, i * 4 + ((largest + 3) & 3), roundToInt(z * 32767.0f));
+			storeComponent<std::int16_t>(data, i * 4 + largest, static_cast<int>(w * 32767.0f + 0.5f));
+		}
+	}
+
+	/**
+	 * Decode floats, stored as a 24 bit signed mantissa and an 8 bit signed exponent
+	 */
+	void filterExponential(std::uint8_t* data, std::size_t begin, std::size_t count) noexcept
+	{
+		for (std::size_t i = begin; i < count; ++i)
+		{
+			std::uint32_t const stored = loadComponent<std::uint32_t>(data, i);
+			int const mantissa = static_cast<std::int32_t>(stored << 8) >> 8;
+			int const exponent = static_cast<std::int32_t>(stored) >> 24;
+			// Exact, as the mantissa fits in a float, unlike std::ldexp this does not handle denormals
+			std::uint32_t const powerBits = static_cast<std::uint32_t>(exponent + 127) << 23;
+			float power;
+			std::memcpy(&power, &powerBits, sizeof(power));
+			float const value = power * static_cast<float>(mantissa);
+			std::memcpy(data + i * 4, &value, sizeof(value));
+		}
+	}
+
+#ifdef LG_SSE2
+	// The vectorized filters process four elements at a time, with the same operations as the scalar ones, so the
+	// results are identical
+
+	__m128 signBits(__m128 value) noexcept
+	{
+		return _mm_and_ps(_mm_cmplt_ps(value, _mm_setzero_ps()), _mm_set1_ps(-0.0f));
+	}
+
+	__m128i roundToInt(__m128 value) noexcept
+	{
+		return _mm_cvttps_epi32(_mm_add_ps(value, _mm_or_ps(_mm_set1_ps(0.5f), signBits(value))));
+	}
+
+	__m128i signExtend16(__m128i value, int shift) noexcept
+	{
+		return _mm_srai_epi32(_mm_slli_epi32(value, 16 - shift), 16);
+	}
+
+	/**
+	 * @param x, y, z components, replaced by the decoded normal
+	 */
+	void filterOctahedral(__m128i& x, __m128i& y, __m128i& z, float max) noexcept
+	{
+		__m128 const absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+		__m128 xf = _mm_cvtepi32_ps(x);
+		__m128 yf = _mm_cvtepi32_ps(y);
+		__m128 const zf = _mm_sub_ps(_mm_sub_ps(_mm_cvtepi32_ps(z), _mm_and_ps(xf, absMask)),
+			_mm_and_ps(yf, absMask));
+
+		__m128 const t = _mm_min_ps(zf, _mm_setzero_ps());
+		xf = _mm_add_ps(xf, _mm_xor_ps(t, signBits(xf)));
+		yf = _mm_add_ps(yf, _mm_xor_ps(t, signBits(yf)));
+
+		__m128 const length = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(xf, xf), _mm_mul_ps(yf, yf)),
+			_mm_mul_ps(zf, zf)));
+		__m128 const scale = _mm_div_ps(_mm_set1_ps(max), length);
+		x = roundToInt(_mm_mul_ps(xf, scale));
+		y = roundToInt(_mm_mul_ps(yf, scale));
+		z = roundToInt(_mm_mul_ps(zf, scale));
+	}
+
+	void filterOctahedral8Sse2(std::uint8_t* data, std::size_t count) noexcept
+	{
+		std::size_t i = 0;
+		for (; i + 4 <= count; i += 4)
+		{
+			__m128i const stored = _mm_loadu_si128(reinterpret_cast<__m128i const*>(data + i * 4));
+			__m128i x = _mm_srai_epi32(_mm_slli_epi32(stored, 24), 24);
+			__m128i y = _mm_srai_epi32(_mm_slli_epi32(stored, 16), 24);
+			__m128i z = _mm_srai_epi32(_mm_slli_epi32(stored, 8), 24);
+			filterOctahedral(x, y, z, 127.0f);
+
+			__m128i const byteMask = _mm_set1_epi32(0xff);
+			__m128i const result = _mm_or_si128(
+				_mm_or_si128(_mm_and_si128(x, byteMask), _mm_slli_epi32(_mm_and_si128(y, byteMask), 8)),
+				_mm_or_si128(_mm_slli_epi32(_mm_and_si128(z, byteMask), 16),
+					_mm_andnot_si128(_mm_set1_epi32(0x00ffffff), stored)));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(data + i * 4), result);
+		}
+		filterOctahedral<std::int8_t>(data, i, count);
+	}
+
+	void filterOctahedral16Sse2(std::uint8_t* data, std::size_t count) noexcept
+	{
+		std::size_t i = 0;
+		for (; i + 4 <= count; i += 4)
+		{
+			// Split the four elements into xy and zw pairs
+			__m128 const stored0 = _mm_loadu_ps(reinterpret_cast<float const*>(data + i * 8));
+			__m128 const stored1 = _mm_loadu_ps(reinterpret_cast<float const*>(data + i * 8 + 16));
+			__m128i const xy = _mm_castps_si128(_mm_shuffle_ps(stored0, stored1, _MM_SHUFFLE(2, 0, 2, 0)));
+			__m128i const zw = _mm_castps_si128(_mm_shuffle_ps(stored0, stored1, _MM_SHUFFLE(3, 1, 3, 1)));
+			__m128i x = signExtend16(xy, 0);
+			__m128i y = signExtend16(xy, 16);
+			__m128i z = signExtend16(zw, 0);
+			filterOctahedral(x, y, z, 32767.0f);
+
+			__m128i const lowMask = _mm_set1_epi32(0xffff);
+			__m128i const resultXy = _mm_or_si128(_mm_and_si128(x, lowMask), _mm_slli_epi32(y, 16));
+			__m128i const resultZw = _mm_or_si128(_mm_and_si128(z, lowMask), _mm_andnot_si128(lowMask, zw));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(data + i * 8), _mm_unpacklo_epi32(resultXy, resultZw));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(data + i * 8 + 16), _mm_unpackhi_epi32(resultXy, resultZw));
+		}
+		filterOctahedral<std::int16_t>(data, i, count);
+	}
+
+	void filterQuaternionSse2(std::uint8_t* data, std::size_t count) noexcept
+	{
+		std::size_t i = 0;
+		for (; i + 4 <= count; i += 4)
+		{
+			__m128 const stored0 = _mm_loadu_ps(reinterpret_cast<float const*>(data + i * 8));
+			__m128 const stored1 = _mm_loadu_ps(reinterpret_cast<float const*>(data + i * 8 + 16));
+			__m128i const xy = _mm_castps_si128(_mm_shuffle_ps(stored0, stored1, _MM_SHUFFLE(2, 0, 2, 0)));
+			__m128i const zw = _mm_castps_si128(_mm_shuffle_ps(stored0, stored1, _MM_SHUFFLE(3, 1, 3, 1)));
+			__m128i const stored = signExtend16(zw, 16);
+
+			__m128 const scale = _mm_div_ps(_mm_set1_ps(1.0f / std::sqrt(2.0f)),
+				_mm_cvtepi32_ps(_mm_or_si128(stored, _mm_set1_epi32(3))));
+			__m128 const x = _mm_mul_ps(_mm_cvtepi32_ps(signExtend16(xy, 0)), scale);
+			__m128 const y = _mm_mul_ps(_mm_cvtepi32_ps(signExtend16(xy, 16)), scale);
+			__m128 const z = _mm_mul_ps(_mm_cvtepi32_ps(signExtend16(zw, 0)), scale);
+			__m128 const ww = _mm_sub_ps(_mm_sub_ps(_mm_sub_ps(_mm_set1_ps(1.0f), _mm_mul_ps(x, x)), _mm_mul_ps(y, y)),
+				_mm_mul_ps(z, z));
+			__m128 const w = _mm_sqrt_ps(_mm_max_ps(ww, _mm_setzero_ps()));
+
+			__m128 const unit = _mm_set1_ps(32767.0f);
+			alignas(16) std::array<std::array<std::int32_t, 4>, 4> components;
+			_mm_store_si128(reinterpret_cast<__m128i*>(components[0].data()), roundToInt(_mm_mul_ps(x, unit)));
+			_mm_store_si128(reinterpret_cast<__m128i*>(components[1].data()), roundToInt(_mm_mul_ps(y, unit)));
+			_mm_store_si128(reinterpret_cast<__m128i*>(components[2].data()), roundToInt(_mm_mul_ps(z, unit)));
+			_mm_store_si128(reinterpret_cast<__m128i*>(components[3].data()),
+				_mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(w, unit), _mm_set1_ps(0.5f))));
+
+			// The position of every component depends on which one was largest
+			alignas(16) std::array<std::int32_t, 4> largest;
+			_mm_store_si128(reinterpret_cast<__m128i*>(largest.data()), _mm_and_si128(stored, _mm_set1_epi32(3)));
+			for (std::size_t lane = 0; lane < 4; ++lane)
+			{
+				std::size_t const element = (i + lane) * 4;
+				storeComponent<std::int16_t>(data, element + ((largest[lane] + 1) & 3), components[0][lane]);
+				storeComponent<std::int16_t>(data, element + ((largest[lane] + 2) & 3), components[1][lane]);
+				storeComponent<std::int16_t>(data, element + ((largest[lane] + 3) & 3), components[2][lane]);
+				storeComponent<std::int16_t>(data, element + largest[lane], components[3][lane]);
+			}
+		}
+		filterQuaternion(data, i, count);
+	}
+
+	void filterExponentialSse2(std::uint8_t* data, std::size_t count) noexcept
+	{
+		std::size_t i = 0;
+		for (; i + 4 <= count; i += 4)
+		{
+			__m128i const stored = _mm_loadu_si128(reinterpret_cast<__m128i const*>(data + i * 4));
+			__m128i const mantissa = _mm_srai_epi32(_mm_slli_epi32(stored, 8), 8);
+			__m128i const exponent = _mm_srai_epi32(stored, 24);
+			__m128 const power = _mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(exponent, _mm_set1_epi32(127)), 23));
+			_mm_storeu_ps(reinterpret_cast<float*>(data + i * 4), _mm_mul_ps(power, _mm_cvtepi32_ps(mantissa)));
+		}
+		filterExponential(data, i, count);
+	}
+#endif
+
+	void applyFilter(std::uint8_t* data, std::size_t count, std::size_t stride, std::string_view filter)
+	{
+		if (filter == "NONE")
+		{
+			return;
+		}
+		if (filter == "OCTAHEDRAL")
+		{
+			if (stride != 4 && stride != 8)
+			{
+				throw std::invalid_argument("Octahedral filter requires a byte stride of 4 or 8");
+			}
+			if (stride == 4)
+			{
+#ifdef LG_SSE2
+				filterOctahedral8Sse2(data, count);
+#else
+				filterOctahedral<std::int8_t>(data, 0, count);
+#endif
+			}
+			else
+			{
+#ifdef LG_SSE2
+				filterOctahedral16Sse2(data, count);
+#else
+				filterOctahedral<std::int16_t>(data, 0, count);
+#endif
+			}
+		}
+		else if (filter == "QUATERNION")
+		{
+			if (stride != 8)
+			{
+				throw std::invalid_argument("Quaternion filter requires a byte stride of 8");
+			}
+#ifdef LG_SSE2
+			filterQuaternionSse2(data, count);
+#else
+			filterQuaternion(data, 0, count);
+#endif
+		}
+		else if (filter == "EXPONENTIAL")
+		{
+			// The stride is already checked to be a multiple of 4
+#ifdef LG_SSE2
+			filterExponentialSse2(data, count * stride / 4);
+#else
+			filterExponential(data, 0, count * stride / 4);
+#endif
+		}
+		else
+		{
+			throw std::invalid_argument("Unknown meshopt filter");
+		}
+	}
+
+	template<typename Storage>
+	void decodeBufferView(lg::BasicGltf<Storage> const& gltf, std::span<lg::BufferData const> buffers,
+		std::uint32_t bufferViewIndex, std::span<std::byte> destination)
+	{
+		if (bufferViewIndex >= gltf.bufferViews.size())
+		{
+			throw std::out_of_range("Buffer view index out of range");
+		}
+		auto const& bufferView = gltf.bufferViews[bufferViewIndex];
+		if (!bufferView.meshoptCompression)
+		{
+			throw std::invalid_argument("Buffer view is not meshopt compressed");
+		}
+		auto const& compression = *bufferView.meshoptCompression;
+		if (compression.buffer >= buffers.size())
+		{
+			throw std::out_of_range("Buffer index out of range");
+		}
+		lg::BufferData const buffer = buffers[compression.buffer];
+		if (std::uint64_t{compression.byteOffset} + compression.byteLength > buffer.size())
+		{
+			throw std::out_of_range("Compressed data exceeds its buffer");
+		}
+		lg::decodeMeshopt(destination, compression.count, compression.byteStride, compression.mode,
+			compression.filter, buffer.subspan(compression.byteOffset, compression.byteLength));
+	}
+
+	template<typename Storage>
+	std::vector<std::byte> decodeBufferView(lg::BasicGltf<Storage> const& gltf, std::span<lg::BufferData const> buffers,
+		std::uint32_t bufferViewIndex)
+	{
+		if (bufferViewIndex >= gltf.bufferViews.size())
+		{
+			throw std::out_of_range("Buffer view index out of range");
+		}
+		auto const& compression = gltf.bufferViews[bufferViewIndex].meshoptCompression;
+		std::vector<std::byte> result(compression ? std::size_t{compression->count} * compression->byteStride : 0);
+		decodeBufferView(gltf, buffers, bufferViewIndex, std::span<std::byte>(result));
+		return result;
+	}
+}
+
+void lg::decodeMeshopt(std::span<std::byte> destination, std::uint32_t count, std::uint32_t byteStride,
+	std::string_view mode, std::string_view filter, lg::BufferData source)
+{
+	if (destination.size() < std::uint64_t{count} * byteStride)
+	{
+		throw std::out_of_range("Destination too small for the decoded data");
+	}
+	auto* const output = reinterpret_cast<std::uint8_t*>(destination.data());
+	auto const* const input = reinterpret_cast<std::uint8_t const*>(source.data());
+
+	if (mode == "ATTRIBUTES")
+	{
+		decodeAttributes(output, count, byteStride, input, source.size());
+		applyFilter(output, count, byteStride, filter);
+		return;
+	}
+
+	if (filter != "NONE")
+	{
+		throw std::invalid_argument("Filters only apply to meshopt attribute data");
+	}
+	if (byteStride != 2 && byteStride != 4)
+	{
+		throw std::invalid_argument("Unsupported meshopt index byte stride");
+	}
+	if (mode == "TRIANGLES")
+	{
+		if (byteStride == 2)
+		{
+			decodeTriangles<std::uint16_t>(output, count, input, source.size());
+		}
+		else
+		{
+			decodeTriangles<std::uint32_t>(output, count, input, source.size());
+		}
+	}
+	else if (mode == "INDICES")
+	{
+		if (byteStride == 2)
+		{
+			decodeSequence<std::uint16_t>(output, count, input, source.size());
+		}
+		else
+		{
+			decodeSequence<std::uint32_t>(output, count, input, source.size());
+		}
+	}
+	else
+	{
+		throw std::invalid_argument("Unknown meshopt compression mode");
+	}
+}
+
+void lg::decodeMeshoptBufferView(lg::Gltf const& gltf, std::span<lg::BufferData const> buffers,
+	std::uint32_t bufferView, std::span<std::byte> destination)
+{
+	decodeBufferView(gltf, buffers, bufferView, destination);
+}
+
+void lg::decodeMeshoptBufferView(lg::BorrowedGltf const& gltf, std::span<lg::BufferData const> buffers,
+	std::uint32_t bufferView, std::span<std::byte> destination)
+{
+	decodeBufferView(gltf, buffers, bufferView, destination);
+}
+
+void lg::decodeMeshoptBufferView(lg::FloatGltf const& gltf, std::span<lg::BufferData const> buffers,
+	std::uint32_t bufferView, std::span<std::byte> destination)
+{
+	decodeBufferView(gltf, buffers, bufferView, destination);
+}
+
+std::vector<std::byte> lg::decodeMeshoptBufferView(lg::Gltf const& gltf, std::span<lg::BufferData const> buffers,
+	std::uint32_t bufferView)
+{
+	return decodeBufferView(gltf, buffers, bufferView);
+}
+
+std::vector<std::byte> lg::decodeMeshoptBufferView(lg::BorrowedGltf const& gltf,
+	std::span<lg::BufferData const> buffers, std::uint32_t bufferView)
+{
+	return decodeBufferView(gltf, buffers, bufferView);
+}
+
+std::vector<std::byte> lg::decodeMeshoptBufferView(lg::FloatGltf const& gltf,
+	std::span<lg::BufferData const> buffers, std::uint32_t bufferView)
+{
+	return decodeBufferView(gltf, buffers, bufferView);
+}
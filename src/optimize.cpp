@@ -0,0 +1,327 @@
+// SPDX-License-Identifier: MIT
+// Copyright © 2022 Sebastian Larsson
+
+#include <load-gltf/optimize.hpp>
+
+#include <load-gltf/accessor.hpp>
+#include <load-gltf/structs.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+	void checkIndices(std::span<std::uint32_t const> indices, std::uint32_t vertexCount)
+	{
+		if (std::any_of(indices.begin(), indices.end(), [vertexCount](std::uint32_t index)
+		{
+			return index >= vertexCount;
+		}))
+		{
+			throw std::out_of_range("Vertex index out of range");
+		}
+	}
+
+	/**
+	 * Find the next vertex to fan around, as described by Sander et al., "Fast Triangle Reordering for Vertex Locality
+	 * and Reduced Overdraw"
+	 *
+	 * @return the next vertex, or noIndex when all triangles are emitted
+	 */
+	std::uint32_t nextFanningVertex(std::vector<std::uint32_t> const& candidates,
+		std::vector<std::uint32_t> const& liveTriangles, std::vector<std::uint32_t> const& cacheTimes,
+		std::uint32_t time, std::uint32_t cacheSize, std::vector<std::uint32_t>& deadEnds, std::uint32_t& cursor)
+	{
+		std::uint32_t best = lg::noIndex;
+		std::int64_t bestPriority = -1;
+		for (std::uint32_t const candidate: candidates)
+		{
+			if (liveTriangles[candidate] == 0)
+			{
+				continue;
+			}
+			// Prefer the oldest vertex that stays in the cache while fanning around it
+			std::int64_t priority = 0;
+			if (time - cacheTimes[candidate] + 2 * liveTriangles[candidate] <= cacheSize)
+			{
+				priority = time - cacheTimes[candidate];
+			}
+			if (priority > bestPriority)
+			{
+				bestPriority = priority;
+				best = candidate;
+			}
+		}
+		if (best != lg::noIndex)
+		{
+			return best;
+		}
+
+		// Dead end, continue with a recently used vertex, or in input order
+		while (!deadEnds.empty())
+		{
+			std::uint32_t const deadEnd = deadEnds.back();
+			deadEnds.pop_back();
+			if (liveTriangles[deadEnd] > 0)
+			{
+				return deadEnd;
+			}
+		}
+		for (; cursor < liveTriangles.size(); ++cursor)
+		{
+			if (liveTriangles[cursor] > 0)
+			{
+				return cursor;
+			}
+		}
+		return lg::noIndex;
+	}
+
+	template<typename Map>
+	std::vector<std::pair<std::string, std::uint32_t>> sortedAttributes(Map const& map)
+	{
+		std::vector<std::pair<std::string, std::uint32_t>> attributes(map.begin(), map.end());
+		std::sort(attributes.begin(), attributes.end());
+		return attributes;
+	}
+
+	/**
+	 * Check that the accessors of some attributes exist and have the same count
+	 *
+	 * @param vertexCount the count the accessors must have, or noIndex for the count of the first accessor
+	 * @return the count of the accessors
+	 */
+	template<typename Storage>
+	std::uint32_t checkVertexCount(lg::BasicGltf<Storage> const& gltf,
+		std::vector<std::pair<std::string, std::uint32_t>> const& attributes, std::uint32_t vertexCount)
+	{
+		for (auto const& [name, accessor]: attributes)
+		{
+			if (accessor >= gltf.accessors.size())
+			{
+				throw std::out_of_range("Accessor index out of range");
+			}
+			std::uint32_t const count = gltf.accessors[accessor].count;
+			if (vertexCount != lg::noIndex && count != vertexCount)
+			{
+				throw std::invalid_argument("Attributes differ in count");
+			}
+			vertexCount = count;
+		}
+		return vertexCount;
+	}
+
+	/**
+	 * Read the data of some attributes and write it in the order of the optimized vertices
+	 */
+	template<typename Storage>
+	std::vector<lg::OptimizedAttribute> remapAttributes(lg::BasicGltf<Storage> const& gltf,
+		std::span<lg::BufferData const> buffers, std::vector<std::pair<std::string, std::uint32_t>> const& attributes,
+		std::vector<std::uint32_t> const& remap, std::uint32_t optimizedVertexCount)
+	{
+		std::vector<lg::OptimizedAttribute> result;
+		result.reserve(attributes.size());
+		for (auto const& [name, accessor]: attributes)
+		{
+			std::vector<std::byte> const data = lg::readAccessorData(gltf, buffers, accessor);
+			std::size_t const size = lg::elementSize(gltf.accessors[accessor].type,
+				gltf.accessors[accessor].componentType);
+
+			lg::OptimizedAttribute& attribute = result.emplace_back();
+			attribute.name = name;
+			attribute.accessor = accessor;
+			attribute.data.resize(size * optimizedVertexCount);
+			for (std::size_t vertex = 0; vertex < remap.size(); ++vertex)
+			{
+				if (remap[vertex] != lg::noIndex)
+				{
+					std::memcpy(attribute.data.data() + remap[vertex] * size, data.data() + vertex * size, size);
+				}
+			}
+		}
+		return result;
+	}
+
+	template<typename Storage>
+	lg::OptimizedPrimitive optimize(lg::BasicGltf<Storage> const& gltf, std::span<lg::BufferData const> buffers,
+		lg::BasicMeshPrimitive<Storage> const& primitive, lg::MeshOptimizationOptions const& options)
+	{
+		if (primitive.mode != 4)
+		{
+			throw std::invalid_argument("Only triangle lists can be optimized");
+		}
+		if (primitive.attributes.empty())
+		{
+			throw std::invalid_argument("Primitive has no attributes");
+		}
+
+		std::vector<std::pair<std::string, std::uint32_t>> const attributes = sortedAttributes(primitive.attributes);
+		std::vector<std::vector<std::pair<std::string, std::uint32_t>>> targets;
+		targets.reserve(primitive.targets.size());
+		for (auto const& target: primitive.targets)
+		{
+			targets.push_back(sortedAttributes(target));
+		}
+
+		std::uint32_t const vertexCount = checkVertexCount(gltf, attributes, lg::noIndex);
+		for (auto const& target: targets)
+		{
+			checkVertexCount(gltf, target, vertexCount);
+		}
+
+		std::vector<std::uint32_t> indices;
+		if (primitive.indices)
+		{
+			indices = lg::readAccessorUints(gltf, buffers, *primitive.indices);
+		}
+		else
+		{
+			indices.resize(vertexCount);
+			std::iota(indices.begin(), indices.end(), 0);
+		}
+		if (indices.size() % 3 != 0)
+		{
+			throw std::invalid_argument("Triangle list index count is not a multiple of 3");
+		}
+
+		lg::OptimizedPrimitive result;
+		result.acmrBefore = lg::computeAcmr(indices, vertexCount, options.cacheSize);
+		result.indices = lg::optimizeVertexCache(indices, vertexCount, options.cacheSize);
+		result.acmrAfter = lg::computeAcmr(result.indices, vertexCount, options.cacheSize);
+
+		std::vector<std::uint32_t> const remap = lg::optimizeVertexFetch(result.indices, vertexCount);
+		result.vertexCount = static_cast<std::uint32_t>(
+			std::count_if(remap.begin(), remap.end(), [](std::uint32_t index) { return index != lg::noIndex; }));
+
+		result.attributes = remapAttributes(gltf, buffers, attributes, remap, result.vertexCount);
+		for (auto const& target: targets)
+		{
+			result.targets.push_back(remapAttributes(gltf, buffers, target, remap, result.vertexCount));
+		}
+
+		return result;
+	}
+}
+
+double lg::computeAcmr(std::span<std::uint32_t const> indices, std::uint32_t vertexCount, std::uint32_t cacheSize)
+{
+	checkIndices(indices, vertexCount);
+	if (indices.size() < 3)
+	{
+		return 0.0;
+	}
+
+	// A vertex is in the cache if fewer than cacheSize misses have happened since it was last loaded
+	std::vector<std::uint64_t> cacheTimes(vertexCount, 0);
+	std::uint64_t time = std::uint64_t{cacheSize} + 1;
+	for (std::uint32_t const index: indices)
+	{
+		if (time - cacheTimes[index] > cacheSize)
+		{
+			cacheTimes[index] = time++;
+		}
+	}
+	std::uint64_t const misses = time - cacheSize - 1;
+	return static_cast<double>(misses) / static_cast<double>(indices.size() / 3);
+}
+
+std::vector<std::uint32_t> lg::optimizeVertexCache(std::span<std::uint32_t const> indices, std::uint32_t vertexCount,
+	std::uint32_t cacheSize)
+{
+	checkIndices(indices, vertexCount);
+	std::size_t const triangleCount = indices.size() / 3;
+
+	// Triangles adjacent to every vertex, in compressed sparse row form
+	std::vector<std::uint32_t> liveTriangles(vertexCount, 0);
+	for (std::size_t i = 0; i < triangleCount * 3; ++i)
+	{
+		++liveTriangles[indices[i]];
+	}
+	std::vector<std::uint32_t> adjacencyOffsets(vertexCount + 1, 0);
+	std::partial_sum(liveTriangles.begin(), liveTriangles.end(), adjacencyOffsets.begin() + 1);
+	std::vector<std::uint32_t> adjacency(adjacencyOffsets.back());
+	{
+		std::vector<std::uint32_t> fill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+		for (std::size_t i = 0; i < triangleCount * 3; ++i)
+		{
+			adjacency[fill[indices[i]]++] = static_cast<std::uint32_t>(i / 3);
+		}
+	}
+
+	std::vector<std::uint32_t> result;
+	result.reserve(triangleCount * 3);
+	std::vector<std::uint32_t> cacheTimes(vertexCount, 0);
+	std::vector<bool> emitted(triangleCount, false);
+	std::vector<std::uint32_t> deadEnds;
+	std::vector<std::uint32_t> candidates;
+	std::uint32_t time = cacheSize + 1;
+	std::uint32_t cursor = 0;
+
+	std::uint32_t fanningVertex = vertexCount > 0 ? 0 : lg::noIndex;
+	while (fanningVertex != lg::noIndex)
+	{
+		candidates.clear();
+		for (std::uint32_t i = adjacencyOffsets[fanningVertex]; i < adjacencyOffsets[fanningVertex + 1]; ++i)
+		{
+			std::uint32_t const triangle = adjacency[i];
+			if (emitted[triangle])
+			{
+				continue;
+			}
+			for (std::size_t corner = 0; corner < 3; ++corner)
+			{
+				std::uint32_t const vertex = indices[triangle * 3 + corner];
+				result.push_back(vertex);
+				deadEnds.push_back(vertex);
+				candidates.push_back(vertex);
+				--liveTriangles[vertex];
+				if (time - cacheTimes[vertex] > cacheSize)
+				{
+					cacheTimes[vertex] = time++;
+				}
+			}
+			emitted[triangle] = true;
+		}
+		fanningVertex = nextFanningVertex(candidates, liveTriangles, cacheTimes, time, cacheSize, deadEnds, cursor);
+	}
+
+	return result;
+}
+
+std::vector<std::uint32_t> lg::optimizeVertexFetch(std::span<std::uint32_t> indices, std::uint32_t vertexCount)
+{
+	checkIndices(indices, vertexCount);
+	std::vector<std::uint32_t> remap(vertexCount, lg::noIndex);
+	std::uint32_t nextVertex = 0;
+	for (std::uint32_t& index: indices)
+	{
+		if (remap[index] == lg::noIndex)
+		{
+			remap[index] = nextVertex++;
+		}
+		index = remap[index];
+	}
+	return remap;
+}
+
+lg::OptimizedPrimitive lg::optimizePrimitive(lg::Gltf const& gltf, std::span<lg::BufferData const> buffers,
+	lg::MeshPrimitive const& primitive, lg::MeshOptimizationOptions const& options)
+{
+	return optimize(gltf, buffers, primitive, options);
+}
+
+lg::OptimizedPrimitive lg::optimizePrimitive(lg::BorrowedGltf const& gltf, std::span<lg::BufferData const> buffers,
+	lg::BasicMeshPrimitive<lg::BorrowingStorage> const& primitive, lg::MeshOptimizationOptions const& options)
+{
+	return optimize(gltf, buffers, primitive, options);
+}
+
+lg::OptimizedPrimitive lg::optimizePrimitive(lg::FloatGltf const& gltf, std::span<lg::BufferData const> buffers,
+	lg::BasicMeshPrimitive<lg::FloatStorage> const& primitive, lg::MeshOptimizationOptions const& options)
+{
+	return optimize(gltf, buffers, primitive, options);
+}
@@ -0,0 +1,80 @@
+// SPDX-License-Identifier: MIT
+// Copyright © 2022 Sebastian Larsson
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <future>
+#include <thread>
+#include <vector>
+
+namespace lg::detail {
+	/**
+	 * Call a function with consecutive ranges covering [0, count), concurrently if the ranges are large enough
+	 *
+	 * @param minimumTaskSize smallest number of elements worth a task of its own
+	 */
+	template<typename Function>
+	void forEachRange(std::size_t count, std::size_t minimumTaskSize, bool parallel, Function const& function)
+	{
+		std::size_t const taskCount = parallel
+			? std::min<std::size_t>(std::max(std::thread::hardware_concurrency(), 1u), count / minimumTaskSize) : 1;
+		if (taskCount <= 1)
+		{
+			function(std::size_t{0}, count);
+			return;
+		}
+
+		std::size_t const taskSize = (count + taskCount - 1) / taskCount;
+		std::vector<std::future<void>> tasks;
+		for (std::size_t begin = 0; begin < count; begin += taskSize)
+		{
+			std::size_t const end = std::min(begin + taskSize, count);
+			tasks.push_back(std::async(std::launch::async, [&function, begin, end]
+			{
+				function(begin, end);
+			}));
+		}
+		for (auto& task: tasks)
+		{
+			task.get();
+		}
+	}
+
+	/**
+	 * Call a function with every index in [0, count), concurrently if parallel is set
+	 *
+	 * Every task takes the next index when done with one, so this suits items that differ a lot in cost.
+	 */
+	template<typename Function>
+	void forEachIndex(std::size_t count, bool parallel, Function const& function)
+	{
+		std::atomic<std::size_t> next = 0;
+		auto work = [count, &function, &next]
+		{
+			for (std::size_t i = next++; i < count; i = next++)
+			{
+				function(i);
+			}
+		};
+		std::size_t const taskCount = parallel
+			? std::min<std::size_t>(std::max(std::thread::hardware_concurrency(), 1u), count) : 1;
+		if (taskCount <= 1)
+		{
+			work();
+			return;
+		}
+
+		std::vector<std::future<void>> tasks;
+		for (std::size_t i = 0; i < taskCount; ++i)
+		{
+			tasks.push_back(std::async(std::launch::async, work));
+		}
+		for (auto& task: tasks)
+		{
+			task.get();
+		}
+	}
+}
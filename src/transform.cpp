@@ -0,0 +1,115 @@
+// SPDX-License-Identifier: MIT
+// Copyright © 2022 Sebastian Larsson
+
+#include <load-gltf/transform.hpp>
+
+#include <load-gltf/hierarchy.hpp>
+#include <load-gltf/structs.hpp>
+
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#define LG_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace {
+	template<typename Storage>
+	lg::Matrix4 nodeTransform(lg::BasicNode<Storage> const& node) noexcept
+	{
+		auto const& [x, y, z, w] = node.rotation;
+		auto const& [sx, sy, sz] = node.scale;
+		auto const& [tx, ty, tz] = node.translation;
+		lg::Matrix4 const trs = {
+			(1.0 - 2.0 * (y * y + z * z)) * sx, 2.0 * (x * y + z * w) * sx, 2.0 * (x * z - y * w) * sx, 0.0,
+			2.0 * (x * y - z * w) * sy, (1.0 - 2.0 * (x * x + z * z)) * sy, 2.0 * (y * z + x * w) * sy, 0.0,
+			2.0 * (x * z + y * w) * sz, 2.0 * (y * z - x * w) * sz, (1.0 - 2.0 * (x * x + y * y)) * sz, 0.0,
+			tx, ty, tz, 1.0};
+
+		// A node has either a matrix or TRS properties, the other being the identity
+		lg::Matrix4 matrix;
+		std::copy(node.matrix.begin(), node.matrix.end(), matrix.begin());
+		return matrix == lg::identityMatrix ? trs : lg::multiply(matrix, trs);
+	}
+
+	template<typename Storage>
+	std::vector<lg::Matrix4> worldTransforms(lg::BasicGltf<Storage> const& gltf, lg::NodeHierarchy const& hierarchy)
+	{
+		std::vector<lg::Matrix4> result(gltf.nodes.size());
+		for (std::size_t i = 0; i < gltf.nodes.size(); ++i)
+		{
+			result[i] = nodeTransform(gltf.nodes[i]);
+		}
+		// Parents come first, so their world transforms are final when their children are reached
+		for (std::uint32_t const node: hierarchy.order)
+		{
+			std::uint32_t const parent = hierarchy.parents[node];
+			if (parent != lg::noIndex)
+			{
+				result[node] = lg::multiply(result[parent], result[node]);
+			}
+		}
+		return result;
+	}
+}
+
+lg::Matrix4 lg::multiply(lg::Matrix4 const& a, lg::Matrix4 const& b) noexcept
+{
+	lg::Matrix4 result = {};
+	for (std::size_t column = 0; column < 4; ++column)
+	{
+#ifdef LG_SSE2
+		// Every column of the result is a combination of the columns of a, two rows at a time
+		__m128d top = _mm_setzero_pd();
+		__m128d bottom = _mm_setzero_pd();
+		for (std::size_t k = 0; k < 4; ++k)
+		{
+			__m128d const factor = _mm_set1_pd(b[column * 4 + k]);
+			top = _mm_add_pd(top, _mm_mul_pd(_mm_loadu_pd(a.data() + k * 4), factor));
+			bottom = _mm_add_pd(bottom, _mm_mul_pd(_mm_loadu_pd(a.data() + k * 4 + 2), factor));
+		}
+		_mm_storeu_pd(result.data() + column * 4, top);
+		_mm_storeu_pd(result.data() + column * 4 + 2, bottom);
+#else
+		for (std::size_t k = 0; k < 4; ++k)
+		{
+			double const factor = b[column * 4 + k];
+			for (std::size_t row = 0; row < 4; ++row)
+			{
+				result[column * 4 + row] += a[k * 4 + row] * factor;
+			}
+		}
+#endif
+	}
+	return result;
+}
+
+lg::Matrix4 lg::localTransform(lg::Node const& node) noexcept
+{
+	return nodeTransform(node);
+}
+
+lg::Matrix4 lg::localTransform(lg::BasicNode<lg::BorrowingStorage> const& node) noexcept
+{
+	return nodeTransform(node);
+}
+
+lg::Matrix4 lg::localTransform(lg::BasicNode<lg::FloatStorage> const& node) noexcept
+{
+	return nodeTransform(node);
+}
+
+std::vector<lg::Matrix4> lg::computeWorldTransforms(lg::Gltf const& gltf, lg::NodeHierarchy const& hierarchy)
+{
+	return worldTransforms(gltf, hierarchy);
+}
+
+std::vector<lg::Matrix4> lg::computeWorldTransforms(lg::BorrowedGltf const& gltf, lg::NodeHierarchy const& hierarchy)
+{
+	return worldTransforms(gltf, hierarchy);
+}
+
+std::vector<lg::Matrix4> lg::computeWorldTransforms(lg::FloatGltf const& gltf, lg::NodeHierarchy const& hierarchy)
+{
+	return worldTransforms(gltf, hierarchy);
+}
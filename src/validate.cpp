@@ -0,0 +1,518 @@
+// SPDX-License-Identifier: MIT
+// Copyright © 2022 Sebastian Larsson
+
+#include <load-gltf/validate.hpp>
+
+#include <load-gltf/accessor.hpp>
+#include <load-gltf/hierarchy.hpp>
+#include <load-gltf/structs.hpp>
+
+#include "parallel.hpp"
+
+#include <array>
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+	using Errors = std::vector<lg::ValidationError>;
+
+	/**
+	 * Smallest number of top-level elements for which validating the sections concurrently pays for starting threads
+	 */
+	constexpr std::size_t minimumParallelElements = 4096;
+
+	// ************* Error helpers *************************
+
+	/**
+	 * Append a property name, escaped as a JSON pointer reference token (RFC 6901)
+	 */
+	void appendPathPart(std::string& path, std::string_view part)
+	{
+		for (char c: part)
+		{
+			if (c == '~')
+			{
+				path += "~0";
+			}
+			else if (c == '/')
+			{
+				path += "~1";
+			}
+			else
+			{
+				path += c;
+			}
+		}
+	}
+
+	void appendPathPart(std::string& path, std::size_t part)
+	{
+		path += std::to_string(part);
+	}
+
+	/**
+	 * Build a JSON pointer from its parts
+	 *
+	 * Only called when reporting an error, so that valid documents do not pay for building paths.
+	 */
+	template<typename...Parts>
+	std::string makePath(Parts const&... parts)
+	{
+		std::string path;
+		((path += '/', appendPathPart(path, parts)), ...);
+		return path;
+	}
+
+	template<typename MakePath>
+	void checkIndex(Errors& errors, std::uint32_t index, std::size_t count, std::string_view targetName,
+		MakePath const& makeErrorPath)
+	{
+		if (index >= count)
+		{
+			errors.push_back({makeErrorPath(),
+				"Index " + std::to_string(index) + " is out of range for " + std::to_string(count) + " "
+					+ std::string(targetName)});
+		}
+	}
+
+	template<typename MakePath>
+	void checkIndex(Errors& errors, std::optional<std::uint32_t> const& index, std::size_t count,
+		std::string_view targetName, MakePath const& makeErrorPath)
+	{
+		if (index)
+		{
+			checkIndex(errors, *index, count, targetName, makeErrorPath);
+		}
+	}
+
+	template<typename MakePath>
+	void checkRange(Errors& errors, std::uint64_t end, std::uint64_t available, std::string_view targetName,
+		MakePath const& makeErrorPath)
+	{
+		if (end > available)
+		{
+			errors.push_back({makeErrorPath(),
+				"Range ends at byte " + std::to_string(end) + ", past the " + std::to_string(available)
+					+ " bytes of the " + std::string(targetName)});
+		}
+	}
+
+	// ************* Section validators *************************
+
+	template<typename Storage>
+	void validateAccessors(Errors& errors, lg::BasicGltf<Storage> const& gltf, lg::ValidationOptions const& options)
+	{
+		for (std::size_t i = 0; i < gltf.accessors.size(); ++i)
+		{
+			auto const& accessor = gltf.accessors[i];
+			if (options.checkReferences)
+			{
+				checkIndex(errors, accessor.bufferView, gltf.bufferViews.size(), "buffer views",
+					[i] { return makePath("accessors", i, "bufferView"); });
+				if (accessor.sparse)
+				{
+					checkIndex(errors, accessor.sparse->indices.bufferView, gltf.bufferViews.size(), "buffer views",
+						[i] { return makePath("accessors", i, "sparse", "indices", "bufferView"); });
+					checkIndex(errors, accessor.sparse->values.bufferView, gltf.bufferViews.size(), "buffer views",
+						[i] { return makePath("accessors", i, "sparse", "values", "bufferView"); });
+				}
+			}
+
+			if (!options.checkRanges)
+			{
+				continue;
+			}
+
+			std::uint32_t const size = lg::elementSize(accessor.type, accessor.componentType);
+			if (size == 0)
+			{
+				errors.push_back({makePath("accessors", i),
+					"Unknown accessor layout: type " + std::string(accessor.type) + ", component type "
+						+ std::to_string(accessor.componentType)});
+				continue;
+			}
+
+			if (accessor.bufferView && *accessor.bufferView < gltf.bufferViews.size() && accessor.count > 0)
+			{
+				auto const& bufferView = gltf.bufferViews[*accessor.bufferView];
+				std::uint64_t const stride = bufferView.byteStride.value_or(size);
+				checkRange(errors, accessor.byteOffset + stride * (accessor.count - 1) + size, bufferView.byteLength,
+					"buffer view", [i] { return makePath("accessors", i); });
+			}
+
+			if (accessor.sparse)
+			{
+				auto const& sparse = *accessor.sparse;
+				std::uint32_t const componentType = sparse.indices.componentType;
+				if (componentType != 5121 && componentType != 5123 && componentType != 5125)
+				{
+					errors.push_back({makePath("accessors", i, "sparse", "indices", "componentType"),
+						"Unknown sparse index component type: " + std::to_string(componentType)});
+				}
+				else if (sparse.indices.bufferView < gltf.bufferViews.size())
+				{
+					std::uint64_t const indexSize = lg::componentSize(componentType);
+					checkRange(errors, sparse.indices.byteOffset + indexSize * sparse.count,
+						gltf.bufferViews[sparse.indices.bufferView].byteLength, "buffer view",
+						[i] { return makePath("accessors", i, "sparse", "indices"); });
+				}
+				if (sparse.values.bufferView < gltf.bufferViews.size())
+				{
+					checkRange(errors, sparse.values.byteOffset + std::uint64_t{size} * sparse.count,
+						gltf.bufferViews[sparse.values.bufferView].byteLength, "buffer view",
+						[i] { return makePath("accessors", i, "sparse", "values"); });
+				}
+			}
+		}
+	}
+
+	template<typename Storage>
+	void validateAnimations(Errors& errors, lg::BasicGltf<Storage> const& gltf, lg::ValidationOptions const& options)
+	{
+		if (!options.checkReferences)
+		{
+			return;
+		}
+
+		for (std::size_t i = 0; i < gltf.animations.size(); ++i)
+		{
+			auto const& animation = gltf.animations[i];
+			for (std::size_t j = 0; j < animation.channels.size(); ++j)
+			{
+				auto const& channel = animation.channels[j];
+				checkIndex(errors, channel.sampler, animation.samplers.size(), "samplers",
+					[i, j] { return makePath("animations", i, "channels", j, "sampler"); });
+				checkIndex(errors, channel.target.node, gltf.nodes.size(), "nodes",
+					[i, j] { return makePath("animations", i, "channels", j, "target", "node"); });
+			}
+			for (std::size_t j = 0; j < animation.samplers.size(); ++j)
+			{
+				auto const& sampler = animation.samplers[j];
+				checkIndex(errors, sampler.input, gltf.accessors.size(), "accessors",
+					[i, j] { return makePath("animations", i, "samplers", j, "input"); });
+				checkIndex(errors, sampler.output, gltf.accessors.size(), "accessors",
+					[i, j] { return makePath("animations", i, "samplers", j, "output"); });
+			}
+		}
+	}
+
+	template<typename Storage>
+	void validateBufferViews(Errors& errors, lg::BasicGltf<Storage> const& gltf, lg::ValidationOptions const& options)
+	{
+		for (std::size_t i = 0; i < gltf.bufferViews.size(); ++i)
+		{
+			auto const& bufferView = gltf.bufferViews[i];
+			if (options.checkReferences)
+			{
+				checkIndex(errors, bufferView.buffer, gltf.buffers.size(), "buffers",
+					[i] { return makePath("bufferViews", i, "buffer"); });
+			}
+			if (options.checkRanges && bufferView.buffer < gltf.buffers.size())
+			{
+				checkRange(errors, std::uint64_t{bufferView.byteOffset} + bufferView.byteLength,
+					gltf.buffers[bufferView.buffer].byteLength, "buffer",
+					[i] { return makePath("bufferViews", i); });
+			}
+			if (!bufferView.meshoptCompression)
+			{
+				continue;
+			}
+			auto const& compression = *bufferView.meshoptCompression;
+			if (options.checkReferences)
+			{
+				checkIndex(errors, compression.buffer, gltf.buffers.size(), "buffers",
+					[i] { return makePath("bufferViews", i, "extensions", "EXT_meshopt_compression", "buffer"); });
+			}
+			if (options.checkRanges)
+			{
+				auto const compressionPath = [i]
+				{
+					return makePath("bufferViews", i, "extensions", "EXT_meshopt_compression");
+				};
+				if (compression.buffer < gltf.buffers.size())
+				{
+					checkRange(errors, std::uint64_t{compression.byteOffset} + compression.byteLength,
+						gltf.buffers[compression.buffer].byteLength, "buffer", compressionPath);
+				}
+				// The decoded data fills the buffer view
+				checkRange(errors, std::uint64_t{compression.count} * compression.byteStride, bufferView.byteLength,
+					"buffer view", compressionPath);
+			}
+		}
+	}
+
+	template<typename Storage>
+	void validateImages(Errors& errors, lg::BasicGltf<Storage> const& gltf, lg::ValidationOptions const& options)
+	{
+		if (!options.checkReferences)
+		{
+			return;
+		}
+
+		for (std::size_t i = 0; i < gltf.images.size(); ++i)
+		{
+			checkIndex(errors, gltf.images[i].bufferView, gltf.bufferViews.size(), "buffer views",
+				[i] { return makePath("images", i, "bufferView"); });
+		}
+	}
+
+	template<typename Storage>
+	void validateMaterials(Errors& errors, lg::BasicGltf<Storage> const& gltf, lg::ValidationOptions const& options)
+	{
+		if (!options.checkReferences)
+		{
+			return;
+		}
+
+		auto checkTexture = [&errors, &gltf]<typename TextureInfo>(std::optional<TextureInfo> const& textureInfo,
+			auto const& makeErrorPath)
+		{
+			if (textureInfo)
+			{
+				checkIndex(errors, textureInfo->index, gltf.textures.size(), "textures", makeErrorPath);
+			}
+		};
+
+		for (std::size_t i = 0; i < gltf.materials.size(); ++i)
+		{
+			auto const& material = gltf.materials[i];
+			if (material.pbrMetallicRoughness)
+			{
+				checkTexture(material.pbrMetallicRoughness->baseColorTexture,
+					[i] { return makePath("materials", i, "pbrMetallicRoughness", "baseColorTexture", "index"); });
+				checkTexture(material.pbrMetallicRoughness->metallicRoughnessTexture,
+					[i]
+					{
+						return makePath("materials", i, "pbrMetallicRoughness", "metallicRoughnessTexture", "index");
+					});
+			}
+			checkTexture(material.normalTexture,
+				[i] { return makePath("materials", i, "normalTexture", "index"); });
+			checkTexture(material.occlusionTexture,
+				[i] { return makePath("materials", i, "occlusionTexture", "index"); });
+			checkTexture(material.emissiveTexture,
+				[i] { return makePath("materials", i, "emissiveTexture", "index"); });
+		}
+	}
+
+	template<typename Storage>
+	void validateMeshes(Errors& errors, lg::BasicGltf<Storage> const& gltf, lg::ValidationOptions const& options)
+	{
+		if (!options.checkReferences)
+		{
+			return;
+		}
+
+		for (std::size_t i = 0; i < gltf.meshes.size(); ++i)
+		{
+			auto const& mesh = gltf.meshes[i];
+			for (std::size_t j = 0; j < mesh.primitives.size(); ++j)
+			{
+				auto const& primitive = mesh.primitives[j];
+				for (auto const& [attribute, accessor]: primitive.attributes)
+				{
+					checkIndex(errors, accessor, gltf.accessors.size(), "accessors",
+						[i, j, &attribute] { return makePath("meshes", i, "primitives", j, "attributes", attribute); });
+				}
+				for (std::size_t t = 0; t < primitive.targets.size(); ++t)
+				{
+					for (auto const& [attribute, accessor]: primitive.targets[t])
+					{
+						checkIndex(errors, accessor, gltf.accessors.size(), "accessors", [i, j, t, &attribute]
+						{
+							return makePath("meshes", i, "primitives", j, "targets", t, attribute);
+						});
+					}
+				}
+				checkIndex(errors, primitive.indices, gltf.accessors.size(), "accessors",
+					[i, j] { return makePath("meshes", i, "primitives", j, "indices"); });
+				checkIndex(errors, primitive.material, gltf.materials.size(), "materials",
+					[i, j] { return makePath("meshes", i, "primitives", j, "material"); });
+			}
+		}
+	}
+
+	template<typename Storage>
+	void validateNodes(Errors& errors, lg::BasicGltf<Storage> const& gltf, lg::ValidationOptions const& options)
+	{
+		if (!options.checkReferences)
+		{
+			return;
+		}
+
+		for (std::size_t i = 0; i < gltf.nodes.size(); ++i)
+		{
+			auto const& node = gltf.nodes[i];
+			checkIndex(errors, node.camera, gltf.cameras.size(), "cameras",
+				[i] { return makePath("nodes", i, "camera"); });
+			for (std::size_t j = 0; j < node.children.size(); ++j)
+			{
+				checkIndex(errors, node.children[j], gltf.nodes.size(), "nodes",
+					[i, j] { return makePath("nodes", i, "children", j); });
+			}
+			checkIndex(errors, node.skin, gltf.skins.size(), "skins",
+				[i] { return makePath("nodes", i, "skin"); });
+			checkIndex(errors, node.mesh, gltf.meshes.size(), "meshes",
+				[i] { return makePath("nodes", i, "mesh"); });
+		}
+	}
+
+	template<typename Storage>
+	void validateScenes(Errors& errors, lg::BasicGltf<Storage> const& gltf, lg::ValidationOptions const& options)
+	{
+		if (!options.checkReferences)
+		{
+			return;
+		}
+
+		checkIndex(errors, gltf.scene, gltf.scenes.size(), "scenes", [] { return makePath("scene"); });
+		for (std::size_t i = 0; i < gltf.scenes.size(); ++i)
+		{
+			auto const& scene = gltf.scenes[i];
+			for (std::size_t j = 0; j < scene.nodes.size(); ++j)
+			{
+				checkIndex(errors, scene.nodes[j], gltf.nodes.size(), "nodes",
+					[i, j] { return makePath("scenes", i, "nodes", j); });
+			}
+		}
+	}
+
+	template<typename Storage>
+	void validateSkins(Errors& errors, lg::BasicGltf<Storage> const& gltf, lg::ValidationOptions const& options)
+	{
+		if (!options.checkReferences)
+		{
+			return;
+		}
+
+		for (std::size_t i = 0; i < gltf.skins.size(); ++i)
+		{
+			auto const& skin = gltf.skins[i];
+			checkIndex(errors, skin.inverseBindMatrices, gltf.accessors.size(), "accessors",
+				[i] { return makePath("skins", i, "inverseBindMatrices"); });
+			checkIndex(errors, skin.skeleton, gltf.nodes.size(), "nodes",
+				[i] { return makePath("skins", i, "skeleton"); });
+			for (std::size_t j = 0; j < skin.joints.size(); ++j)
+			{
+				checkIndex(errors, skin.joints[j], gltf.nodes.size(), "nodes",
+					[i, j] { return makePath("skins", i, "joints", j); });
+			}
+		}
+	}
+
+	template<typename Storage>
+	void validateTextures(Errors& errors, lg::BasicGltf<Storage> const& gltf, lg::ValidationOptions const& options)
+	{
+		if (!options.checkReferences)
+		{
+			return;
+		}
+
+		for (std::size_t i = 0; i < gltf.textures.size(); ++i)
+		{
+			auto const& texture = gltf.textures[i];
+			checkIndex(errors, texture.sampler, gltf.samplers.size(), "samplers",
+				[i] { return makePath("textures", i, "sampler"); });
+			checkIndex(errors, texture.source, gltf.images.size(), "images",
+				[i] { return makePath("textures", i, "source"); });
+		}
+	}
+
+	/**
+	 * Check that every node has at most one parent, that there are no cycles, and that scenes only list root nodes
+	 *
+	 * Out of range indices are skipped, they are reported by the reference checks.
+	 */
+	template<typename Storage>
+	void validateNodeHierarchy(Errors& errors, lg::BasicGltf<Storage> const& gltf,
+		lg::ValidationOptions const& options)
+	{
+		if (!options.checkNodeHierarchy)
+		{
+			return;
+		}
+
+		lg::NodeHierarchy const hierarchy = lg::analyzeNodeHierarchy(gltf);
+		for (lg::NodeEdge const& edge: hierarchy.sharedChildren)
+		{
+			errors.push_back({makePath("nodes", edge.parent, "children", edge.position),
+				"Node " + std::to_string(edge.child) + " is already a child of node "
+					+ std::to_string(hierarchy.parents[edge.child])});
+		}
+		for (std::uint32_t const node: hierarchy.cycles)
+		{
+			errors.push_back({makePath("nodes", node), "Node " + std::to_string(node) + " is its own ancestor"});
+		}
+
+		for (std::size_t i = 0; i < gltf.scenes.size(); ++i)
+		{
+			auto const& sceneNodes = gltf.scenes[i].nodes;
+			for (std::size_t j = 0; j < sceneNodes.size(); ++j)
+			{
+				std::uint32_t const node = sceneNodes[j];
+				if (node < hierarchy.parents.size() && hierarchy.parents[node] != lg::noIndex)
+				{
+					errors.push_back({makePath("scenes", i, "nodes", j),
+						"Node " + std::to_string(node) + " is not a root node"});
+				}
+			}
+		}
+	}
+
+	template<typename Storage>
+	std::vector<lg::ValidationError> validateGltf(lg::BasicGltf<Storage> const& gltf,
+		lg::ValidationOptions const& options)
+	{
+		using SectionValidator = void (*)(Errors&, lg::BasicGltf<Storage> const&, lg::ValidationOptions const&);
+		std::array const sectionValidators = {
+			SectionValidator{validateAccessors<Storage>},
+			SectionValidator{validateAnimations<Storage>},
+			SectionValidator{validateBufferViews<Storage>},
+			SectionValidator{validateImages<Storage>},
+			SectionValidator{validateMaterials<Storage>},
+			SectionValidator{validateMeshes<Storage>},
+			SectionValidator{validateNodes<Storage>},
+			SectionValidator{validateScenes<Storage>},
+			SectionValidator{validateSkins<Storage>},
+			SectionValidator{validateTextures<Storage>},
+			SectionValidator{validateNodeHierarchy<Storage>},
+		};
+
+		std::size_t const elementCount = gltf.accessors.size() + gltf.animations.size() + gltf.bufferViews.size()
+			+ gltf.images.size() + gltf.materials.size() + gltf.meshes.size() + gltf.nodes.size() + gltf.scenes.size()
+			+ gltf.skins.size() + gltf.textures.size();
+		std::array<Errors, sectionValidators.size()> sectionErrors;
+		lg::detail::forEachIndex(sectionValidators.size(), options.parallel && elementCount >= minimumParallelElements,
+			[&sectionValidators, &sectionErrors, &gltf, &options](std::size_t i)
+		{
+			sectionValidators[i](sectionErrors[i], gltf, options);
+		});
+
+		Errors errors;
+		for (auto& section: sectionErrors)
+		{
+			errors.insert(errors.end(), std::make_move_iterator(section.begin()),
+				std::make_move_iterator(section.end()));
+		}
+		return errors;
+	}
+}
+
+std::vector<lg::ValidationError> lg::validate(lg::Gltf const& gltf, lg::ValidationOptions const& options)
+{
+	return validateGltf(gltf, options);
+}
+
+std::vector<lg::ValidationError> lg::validate(lg::BorrowedGltf const& gltf, lg::ValidationOptions const& options)
+{
+	return validateGltf(gltf, options);
+}
+
+std::vector<lg::ValidationError> lg::validate(lg::FloatGltf const& gltf, lg::ValidationOptions const& options)
+{
+	return validateGltf(gltf, options);
+}
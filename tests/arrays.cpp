@@ -0,0 +1,51 @@
+// SPDX-License-Identifier: MIT
+// Copyright © 2022 Sebastian Larsson
+
+#include <load-gltf/load-gltf.hpp>
+
+#include "check.hpp"
+
+#include <array>
+#include <stdexcept>
+#include <string>
+
+namespace {
+	std::string nodeDocument(std::string const& node)
+	{
+		return R"({"asset": {"version": "2.0"}, "nodes": [)" + node + "]}";
+	}
+
+	void testFixedArrays()
+	{
+		lg::Gltf const gltf = lg::loadGltf(nodeDocument(R"({"translation": [1, 2.5, -3],
+			"rotation": [0, 0.5, 0, 0.5], "scale": [4, 5, 6]},
+			{"matrix": [1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16]})"));
+		LG_CHECK((gltf.nodes[0].translation == std::array{1.0, 2.5, -3.0}));
+		LG_CHECK((gltf.nodes[0].rotation == std::array{0.0, 0.5, 0.0, 0.5}));
+		LG_CHECK((gltf.nodes[0].scale == std::array{4.0, 5.0, 6.0}));
+		for (std::size_t i = 0; i < 16; ++i)
+		{
+			LG_CHECK(gltf.nodes[1].matrix[i] == i + 1.0);
+		}
+		// Absent arrays keep their defaults
+		LG_CHECK((gltf.nodes[1].scale == std::array{1.0, 1.0, 1.0}));
+
+		lg::FloatGltf const floatGltf = lg::loadGltfFloat(nodeDocument(R"({"translation": [0.1, 2, 3]})"));
+		LG_CHECK((floatGltf.nodes[0].translation == std::array{0.1f, 2.0f, 3.0f}));
+	}
+
+	void testWrongElementCount()
+	{
+		LG_CHECK_THROWS(lg::loadGltf(nodeDocument(R"({"translation": [1, 2]})")), std::invalid_argument);
+		LG_CHECK_THROWS(lg::loadGltf(nodeDocument(R"({"translation": [1, 2, 3, 4]})")), std::invalid_argument);
+		LG_CHECK_THROWS(lg::loadGltf(nodeDocument(R"({"rotation": []})")), std::invalid_argument);
+		LG_CHECK_THROWS(lg::loadGltf(nodeDocument(R"({"matrix": [1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0]})")),
+			std::invalid_argument);
+	}
+}
+
+int main()
+{
+	testFixedArrays();
+	testWrongElementCount();
+}
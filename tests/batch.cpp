@@ -0,0 +1,177 @@
+// SPDX-License-Identifier: MIT
+// Copyright © 2022 Sebastian Larsson
+
+#include <load-gltf/load-gltf.hpp>
+
+#include "check.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+	constexpr std::string_view document = R"({
+		"asset": {"version": "2.0"},
+		"materials": [{}, {}],
+		"meshes": [
+			{"primitives": [{"attributes": {}, "material": 1}, {"attributes": {}}, {"attributes": {}, "material": 0}]},
+			{"primitives": [{"attributes": {}, "material": 0}]},
+			{"primitives": [{"attributes": {}, "material": 1}]},
+			{"primitives": []}
+		],
+		"nodes": [
+			{"mesh": 1, "translation": [1, 0, 0], "children": [1, 2]},
+			{"mesh": 0, "translation": [0, 2, 0]},
+			{"mesh": 1},
+			{"mesh": 0},
+			{"mesh": 2},
+			{"mesh": 7},
+			{"mesh": 3},
+			{"mesh": 0, "children": [8]},
+			{"mesh": 0, "children": [7]}
+		],
+		"scenes": [{"nodes": [0, 3, 5, 6, 7]}, {"nodes": [4]}]
+	})";
+
+	void checkBatch(lg::DrawBatch const& batch, std::uint32_t material, std::uint32_t mesh, std::uint32_t primitive,
+		std::uint32_t firstInstance, std::uint32_t instanceCount)
+	{
+		LG_CHECK(batch.material == material);
+		LG_CHECK(batch.mesh == mesh);
+		LG_CHECK(batch.primitive == primitive);
+		LG_CHECK(batch.firstInstance == firstInstance);
+		LG_CHECK(batch.instanceCount == instanceCount);
+	}
+
+	void testOrdering()
+	{
+		lg::Gltf const gltf = lg::loadGltf(document);
+		lg::NodeHierarchy const hierarchy = lg::analyzeNodeHierarchy(gltf);
+		std::vector<lg::Matrix4> const worldTransforms = lg::computeWorldTransforms(gltf, hierarchy);
+		lg::DrawBatches const batches = lg::buildDrawBatches(gltf, hierarchy, worldTransforms, 0);
+
+		// Sorted by material, with the default material last, then by mesh and primitive. Mesh 3 has instances but
+		// no primitives, and mesh 2 is not in the scene.
+		LG_CHECK(batches.batches.size() == 4);
+		checkBatch(batches.batches[0], 0, 0, 2, 0, 2);
+		checkBatch(batches.batches[1], 0, 1, 0, 2, 2);
+		checkBatch(batches.batches[2], 1, 0, 0, 0, 2);
+		checkBatch(batches.batches[3], lg::noIndex, 0, 1, 0, 2);
+
+		// Instances grouped by ascending mesh, in node order within a mesh. Out of range meshes and nodes in a cycle
+		// are left out.
+		LG_CHECK((batches.instanceNodes == std::vector<std::uint32_t>{1, 3, 0, 2, 6}));
+		std::vector<std::uint32_t> const expectedInstances = {2, 0, 3, 1, lg::noIndex, lg::noIndex, 4, lg::noIndex,
+			lg::noIndex};
+		LG_CHECK(batches.nodeInstances == expectedInstances);
+
+		LG_CHECK(batches.instanceTransforms.size() == batches.instanceNodes.size());
+		for (std::size_t instance = 0; instance < batches.instanceNodes.size(); ++instance)
+		{
+			for (std::size_t k = 0; k < 16; ++k)
+			{
+				LG_CHECK(batches.instanceTransforms[instance][k]
+					== static_cast<float>(worldTransforms[batches.instanceNodes[instance]][k]));
+			}
+		}
+		LG_CHECK(batches.instanceTransforms[0][12] == 1.0f && batches.instanceTransforms[0][13] == 2.0f);
+
+		lg::DrawBatches const other = lg::buildDrawBatches(gltf, hierarchy, worldTransforms, 1);
+		LG_CHECK(other.batches.size() == 1);
+		checkBatch(other.batches[0], 1, 2, 0, 0, 1);
+		LG_CHECK((other.instanceNodes == std::vector<std::uint32_t>{4}));
+
+		LG_CHECK_THROWS(lg::buildDrawBatches(gltf, hierarchy, worldTransforms, 2), std::out_of_range);
+		LG_CHECK_THROWS(lg::buildDrawBatches(gltf, hierarchy, std::span(worldTransforms).first(3), 0),
+			std::invalid_argument);
+	}
+
+	void testUpdate()
+	{
+		lg::Gltf const gltf = lg::loadGltf(document);
+		lg::NodeHierarchy const hierarchy = lg::analyzeNodeHierarchy(gltf);
+		std::vector<lg::Matrix4> worldTransforms = lg::computeWorldTransforms(gltf, hierarchy);
+		lg::DrawBatches batches = lg::buildDrawBatches(gltf, hierarchy, worldTransforms, 0);
+
+		// Only the changed nodes are gathered again, ignoring those that are not drawn
+		worldTransforms[1][12] = 5;
+		worldTransforms[3][12] = 6;
+		std::array<std::uint32_t, 2> const changedNodes = {1, 4};
+		lg::updateDrawBatches(batches, worldTransforms, changedNodes);
+		LG_CHECK(batches.instanceTransforms[0][12] == 5.0f);
+		LG_CHECK(batches.instanceTransforms[1][12] == 0.0f);
+
+		lg::DrawBatchOptions options;
+		options.parallel = false;
+		lg::updateDrawBatches(batches, worldTransforms, options);
+		LG_CHECK(batches.instanceTransforms[1][12] == 6.0f);
+
+		// Nothing is updated if any of the nodes is out of range
+		worldTransforms[1][12] = 7;
+		std::array<std::uint32_t, 2> const outOfRange = {1, 9};
+		LG_CHECK_THROWS(lg::updateDrawBatches(batches, worldTransforms, outOfRange), std::out_of_range);
+		LG_CHECK(batches.instanceTransforms[0][12] == 5.0f);
+		LG_CHECK_THROWS(lg::updateDrawBatches(batches, std::span(worldTransforms).first(3)), std::invalid_argument);
+	}
+
+	void testSerialMatchesParallel()
+	{
+		// Enough nodes to gather the transforms in several tasks, with the meshes of the nodes interleaved
+		std::uint32_t const nodeCount = 50000;
+		std::uint32_t const meshCount = 7;
+		std::string nodes;
+		std::string roots;
+		for (std::uint32_t node = 0; node < nodeCount; ++node)
+		{
+			std::string const separator = node == 0 ? "" : ",";
+			nodes += separator + R"({"mesh": )" + std::to_string(node * 3 % meshCount) + R"(, "translation": [)"
+				+ std::to_string(node) + ", 0, 0]}";
+			roots += separator + std::to_string(node);
+		}
+		std::string meshes;
+		for (std::uint32_t mesh = 0; mesh < meshCount; ++mesh)
+		{
+			meshes += std::string(mesh == 0 ? "" : ",") + R"({"primitives": [{"attributes": {}, "material": )"
+				+ std::to_string(meshCount - 1 - mesh) + "}]}";
+		}
+		lg::Gltf const gltf = lg::loadGltf(R"({"asset": {"version": "2.0"}, "meshes": [)" + meshes
+			+ R"(], "nodes": [)" + nodes + R"(], "scenes": [{"nodes": [)" + roots + "]}]}");
+		lg::NodeHierarchy const hierarchy = lg::analyzeNodeHierarchy(gltf);
+		std::vector<lg::Matrix4> const worldTransforms = lg::computeWorldTransforms(gltf, hierarchy);
+
+		lg::DrawBatchOptions serial;
+		serial.parallel = false;
+		lg::DrawBatches const expected = lg::buildDrawBatches(gltf, hierarchy, worldTransforms, 0, serial);
+		lg::DrawBatches const batches = lg::buildDrawBatches(gltf, hierarchy, worldTransforms, 0);
+		LG_CHECK(batches.instanceNodes == expected.instanceNodes);
+		LG_CHECK(batches.instanceTransforms == expected.instanceTransforms);
+
+		// Materials in reverse mesh order put the batches in reverse order too
+		LG_CHECK(batches.batches.size() == meshCount);
+		for (std::uint32_t i = 0; i < meshCount; ++i)
+		{
+			LG_CHECK(batches.batches[i].material == i && batches.batches[i].mesh == meshCount - 1 - i);
+		}
+		for (std::size_t instance = 1; instance < batches.instanceNodes.size(); ++instance)
+		{
+			std::uint32_t const previous = batches.instanceNodes[instance - 1];
+			std::uint32_t const node = batches.instanceNodes[instance];
+			std::uint32_t const previousMesh = *gltf.nodes[previous].mesh;
+			std::uint32_t const mesh = *gltf.nodes[node].mesh;
+			LG_CHECK(previousMesh < mesh || (previousMesh == mesh && previous < node));
+			LG_CHECK(batches.instanceTransforms[instance][12] == static_cast<float>(node));
+		}
+	}
+}
+
+int main()
+{
+	testOrdering();
+	testUpdate();
+	testSerialMatchesParallel();
+}
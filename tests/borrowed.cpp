@@ -0,0 +1,94 @@
+// SPDX-License-Identifier: MIT
+// Copyright © 2022 Sebastian Larsson
+
+#include <load-gltf/load-gltf.hpp>
+
+#include "check.hpp"
+
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace {
+	constexpr std::string_view document = R"({
+		"asset": {"version": "2.0", "generator": "plain"},
+		"nodes": [{"name": "root"}, {"name": "quote \" and \\ backslash"}, {"name": "caf\u00e9"}],
+		"meshes": [{"primitives": [{"attributes": {"POSITION": 0, "TEXCOORD\u005f0": 1}}]}],
+		"accessors": [{"count": 3, "type": "VEC3", "componentType": 5126},
+			{"count": 3, "type": "VEC2", "componentType": 5126}]
+	})";
+
+	/**
+	 * Copy of the document followed by padding, which must outlive documents borrowing from it
+	 */
+	std::string const padded = std::string(document) + std::string(lg::paddingSize, ' ');
+	std::string_view const json(padded.data(), document.size());
+
+	bool referencesInput(std::string_view text)
+	{
+		return text.data() >= json.data() && text.data() + text.size() <= json.data() + json.size();
+	}
+
+	void testPlainStrings()
+	{
+		lg::BorrowedGltf const gltf = lg::loadGltfBorrowed(json);
+
+		LG_CHECK(gltf.asset.generator == "plain");
+		LG_CHECK(gltf.nodes[0].name == "root");
+		LG_CHECK(gltf.accessors[0].type == "VEC3");
+		// Strings without escape sequences reference the input
+		LG_CHECK(referencesInput(*gltf.asset.generator));
+		LG_CHECK(referencesInput(*gltf.nodes[0].name));
+		LG_CHECK(referencesInput(gltf.accessors[1].type));
+		LG_CHECK(referencesInput(gltf.meshes[0].primitives[0].attributes.find("POSITION")->first));
+	}
+
+	void testEscapedStrings()
+	{
+		lg::BorrowedGltf const gltf = lg::loadGltfBorrowed(json);
+
+		// Strings with escape sequences are unescaped into the arena of the document
+		LG_CHECK(gltf.nodes[1].name == "quote \" and \\ backslash");
+		LG_CHECK(gltf.nodes[2].name == "caf\xc3\xa9");
+		LG_CHECK(!referencesInput(*gltf.nodes[1].name));
+		LG_CHECK(!referencesInput(*gltf.nodes[2].name));
+
+		auto const& attributes = gltf.meshes[0].primitives[0].attributes;
+		auto const texCoord = attributes.find("TEXCOORD_0");
+		LG_CHECK(texCoord != attributes.end());
+		LG_CHECK(texCoord->second == 1);
+		LG_CHECK(!referencesInput(texCoord->first));
+	}
+
+	void testMatchesOwned()
+	{
+		lg::BorrowedGltf const borrowed = lg::loadGltfBorrowed(json);
+		lg::Gltf const owned = lg::loadGltf(document);
+
+		LG_CHECK(borrowed.nodes.size() == owned.nodes.size());
+		for (std::size_t i = 0; i < owned.nodes.size(); ++i)
+		{
+			LG_CHECK(*borrowed.nodes[i].name == *owned.nodes[i].name);
+		}
+		LG_CHECK(borrowed.meshes[0].primitives[0].attributes.size() == owned.meshes[0].primitives[0].attributes.size());
+		for (auto const& [name, accessor]: owned.meshes[0].primitives[0].attributes)
+		{
+			LG_CHECK(borrowed.meshes[0].primitives[0].attributes.at(name) == accessor);
+		}
+	}
+
+	void testMoveKeepsStrings()
+	{
+		lg::BorrowedGltf gltf = lg::loadGltfBorrowed(json);
+		lg::BorrowedGltf const moved = std::move(gltf);
+		LG_CHECK(moved.nodes[1].name == "quote \" and \\ backslash");
+	}
+}
+
+int main()
+{
+	testPlainStrings();
+	testEscapedStrings();
+	testMatchesOwned();
+	testMoveKeepsStrings();
+}
@@ -0,0 +1,153 @@
+// SPDX-License-Identifier: MIT
+// Copyright © 2022 Sebastian Larsson
+
+#include <load-gltf/load-gltf.hpp>
+
+#include "check.hpp"
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+namespace {
+	/// Four positions without accessor bounds: (0, 0, 0), (2, 0, 0), (0, 4, 0) and (1, 1, -2)
+	std::array<float, 12> const positions = {0, 0, 0, 2, 0, 0, 0, 4, 0, 1, 1, -2};
+
+	constexpr std::string_view document = R"({
+		"asset": {"version": "2.0"},
+		"buffers": [{"byteLength": 48}],
+		"bufferViews": [{"buffer": 0, "byteLength": 48}],
+		"accessors": [
+			{"bufferView": 0, "componentType": 5126, "count": 4, "type": "VEC3"},
+			{"componentType": 5126, "count": 8, "type": "VEC3", "min": [-1, -1, -1], "max": [1, 1, 1]},
+			{"componentType": 5121, "normalized": true, "count": 8, "type": "VEC3", "min": [0, 0, 0],
+				"max": [255, 51, 0]}
+		],
+		"meshes": [
+			{"primitives": [{"attributes": {"POSITION": 0}}]},
+			{"primitives": [{"attributes": {"POSITION": 1}}]},
+			{"primitives": [{"attributes": {"POSITION": 2}}]},
+			{"primitives": [{"attributes": {"NORMAL": 1}}]}
+		],
+		"nodes": [
+			{"mesh": 1, "translation": [10, 0, 0], "children": [1]},
+			{"mesh": 0, "translation": [0, 0, 5]},
+			{"mesh": 3}
+		],
+		"scenes": [{"nodes": [0]}, {"nodes": [2]}]
+	})";
+
+	std::array<lg::BufferData, 1> const buffers = {std::as_bytes(std::span(positions))};
+
+	bool near(double a, double b)
+	{
+		return std::abs(a - b) < 1e-9;
+	}
+
+	void checkBox(lg::Aabb const& box, std::array<double, 3> const& min, std::array<double, 3> const& max)
+	{
+		for (std::size_t k = 0; k < 3; ++k)
+		{
+			LG_CHECK(near(box.min[k], min[k]));
+			LG_CHECK(near(box.max[k], max[k]));
+		}
+	}
+
+	void testMeshBounds()
+	{
+		lg::Gltf const gltf = lg::loadGltf(document);
+		lg::DocumentBounds const bounds = lg::computeBounds(gltf, buffers);
+		LG_CHECK(bounds.meshes.size() == 4);
+
+		// Read from the position data, with the sphere reaching the farthest position from the center of the box
+		checkBox(bounds.meshes[0].box, {0, 0, -2}, {2, 4, 0});
+		LG_CHECK((bounds.meshes[0].sphere.center == std::array<double, 3>{1, 2, -1}));
+		LG_CHECK(near(bounds.meshes[0].sphere.radius, std::sqrt(6.0)));
+
+		// Taken from the accessor bounds, without reading any data
+		checkBox(bounds.meshes[1].box, {-1, -1, -1}, {1, 1, 1});
+		LG_CHECK(near(bounds.meshes[1].sphere.radius, std::sqrt(3.0)));
+
+		// Normalized accessor bounds are mapped to the values the components are read as
+		checkBox(bounds.meshes[2].box, {0, 0, 0}, {1, 0.2, 0});
+
+		LG_CHECK(bounds.meshes[3].box.isEmpty());
+		LG_CHECK(bounds.meshes[3].sphere.radius < 0.0);
+	}
+
+	void testNodeAndSceneBounds()
+	{
+		lg::Gltf const gltf = lg::loadGltf(document);
+		lg::DocumentBounds const bounds = lg::computeBounds(gltf, buffers);
+
+		checkBox(bounds.nodes[1].box, {10, 0, 3}, {12, 4, 5});
+		// The parent encloses its own mesh and that of its child
+		checkBox(bounds.nodes[0].box, {9, -1, -1}, {12, 4, 5});
+		LG_CHECK(bounds.nodes[2].box.isEmpty());
+
+		checkBox(bounds.scenes[0].box, {9, -1, -1}, {12, 4, 5});
+		LG_CHECK(bounds.scenes[0].sphere.radius >= bounds.nodes[1].sphere.radius);
+		LG_CHECK(bounds.scenes[1].box.isEmpty());
+	}
+
+	void testSerialMatchesParallel()
+	{
+		lg::Gltf const gltf = lg::loadGltf(document);
+		lg::BoundsOptions serial;
+		serial.parallel = false;
+		lg::DocumentBounds const expected = lg::computeBounds(gltf, buffers, serial);
+		lg::DocumentBounds const bounds = lg::computeBounds(gltf, buffers);
+		for (std::size_t i = 0; i < bounds.nodes.size(); ++i)
+		{
+			LG_CHECK(bounds.nodes[i].box.min == expected.nodes[i].box.min);
+			LG_CHECK(bounds.nodes[i].box.max == expected.nodes[i].box.max);
+			LG_CHECK(bounds.nodes[i].sphere.radius == expected.nodes[i].sphere.radius);
+		}
+
+		// Only mesh 0 reads data, so without buffers it fails whichever way it runs
+		LG_CHECK_THROWS(lg::computeBounds(gltf, {}, serial), std::out_of_range);
+		LG_CHECK_THROWS(lg::computeBounds(gltf, {}), std::out_of_range);
+	}
+
+	void testTransformAndMerge()
+	{
+		lg::Bounds bounds;
+		bounds.box.min = {0, 0, -2};
+		bounds.box.max = {2, 4, 0};
+		bounds.sphere.center = {1, 2, -1};
+		bounds.sphere.radius = 3;
+
+		// A quarter turn around z maps x to y and y to -x
+		lg::Matrix4 const rotation = {0, 1, 0, 0, -1, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1};
+		lg::Bounds const rotated = lg::transformBounds(bounds, rotation);
+		checkBox(rotated.box, {-4, 0, -2}, {0, 2, 0});
+		LG_CHECK(near(rotated.sphere.center[0], -2) && near(rotated.sphere.center[1], 1));
+		LG_CHECK(near(rotated.sphere.radius, 3));
+
+		lg::Bounds const merged = lg::mergeBounds(lg::Bounds{}, bounds);
+		checkBox(merged.box, bounds.box.min, bounds.box.max);
+		LG_CHECK(merged.sphere.radius == 3);
+
+		lg::Bounds other;
+		other.box.min = {10, 2, -1};
+		other.box.max = {10, 2, -1};
+		other.sphere.center = {10, 2, -1};
+		other.sphere.radius = 0;
+		lg::Bounds const both = lg::mergeBounds(bounds, other);
+		checkBox(both.box, {0, 0, -2}, {10, 4, 0});
+		LG_CHECK(near(both.sphere.radius, 6));
+		LG_CHECK(near(both.sphere.center[0], 4));
+	}
+}
+
+int main()
+{
+	testMeshBounds();
+	testNodeAndSceneBounds();
+	testSerialMatchesParallel();
+	testTransformAndMerge();
+}
@@ -0,0 +1,274 @@
+// SPDX-License-Identifier: MIT
+// Copyright © 2022 Sebastian Larsson
+
+#include <load-gltf/load-gltf.hpp>
+
+#include "check.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+	/// Enough nodes for the build to split into several tasks
+	constexpr std::uint32_t gridSize = 17;
+	constexpr std::uint32_t gridNodeCount = gridSize * gridSize * gridSize;
+
+	/**
+	 * Grid of nodes with unit boxes from 2 * (x, y, z) to 2 * (x, y, z) + 1, followed by a node whose mesh has
+	 * empty bounds and a node without a mesh
+	 */
+	std::string makeDocument()
+	{
+		std::string nodes;
+		for (std::uint32_t i = 0; i < gridNodeCount; ++i)
+		{
+			nodes += R"({"mesh": 0, "translation": [)" + std::to_string(i % gridSize * 2) + ".5, "
+				+ std::to_string(i / gridSize % gridSize * 2) + ".5, " + std::to_string(i / gridSize / gridSize * 2)
+				+ ".5]},";
+		}
+		return R"({"asset": {"version": "2.0"}, "meshes": [{"primitives": []}, {"primitives": []}], "nodes": [)"
+			+ nodes + R"({"mesh": 1}, {}]})";
+	}
+
+	std::vector<lg::Bounds> makeMeshBounds()
+	{
+		std::vector<lg::Bounds> meshBounds(2);
+		meshBounds[0].box.min = {-0.5, -0.5, -0.5};
+		meshBounds[0].box.max = {0.5, 0.5, 0.5};
+		meshBounds[0].sphere.radius = 1;
+		return meshBounds;
+	}
+
+	lg::Aabb worldBox(std::vector<lg::Matrix4> const& worldTransforms, std::uint32_t node)
+	{
+		lg::Aabb box;
+		for (std::size_t k = 0; k < 3; ++k)
+		{
+			box.min[k] = worldTransforms[node][12 + k] - 0.5;
+			box.max[k] = worldTransforms[node][12 + k] + 0.5;
+		}
+		return box;
+	}
+
+	/**
+	 * Nodes of the grid whose boxes pass a test, in ascending order
+	 */
+	template<typename Test>
+	std::vector<std::uint32_t> findAll(std::vector<lg::Matrix4> const& worldTransforms, Test const& test)
+	{
+		std::vector<std::uint32_t> result;
+		for (std::uint32_t node = 0; node < gridNodeCount; ++node)
+		{
+			if (test(worldBox(worldTransforms, node)))
+			{
+				result.push_back(node);
+			}
+		}
+		return result;
+	}
+
+	std::vector<std::uint32_t> sorted(std::vector<std::uint32_t> nodes)
+	{
+		std::sort(nodes.begin(), nodes.end());
+		return nodes;
+	}
+
+	bool overlaps(lg::Aabb const& a, lg::Aabb const& b)
+	{
+		for (std::size_t k = 0; k < 3; ++k)
+		{
+			if (a.min[k] > b.max[k] || b.min[k] > a.max[k])
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	void checkOverlapping(lg::SceneBvh const& bvh, std::vector<lg::Matrix4> const& worldTransforms)
+	{
+		std::mt19937 random(42);
+		std::uniform_real_distribution<double> coordinate(-2.0, gridSize * 2.0 + 2.0);
+		for (int query = 0; query < 20; ++query)
+		{
+			lg::Aabb box;
+			for (std::size_t k = 0; k < 3; ++k)
+			{
+				double const a = coordinate(random);
+				double const b = coordinate(random);
+				box.min[k] = std::min(a, b);
+				box.max[k] = std::max(a, b);
+			}
+			LG_CHECK(sorted(lg::findOverlapping(bvh, box)) == findAll(worldTransforms, [&box](lg::Aabb const& other)
+			{
+				return overlaps(box, other);
+			}));
+		}
+		LG_CHECK(lg::findOverlapping(bvh, lg::Aabb{}).empty());
+	}
+
+	void testBuild()
+	{
+		lg::Gltf const gltf = lg::loadGltf(makeDocument());
+		std::vector<lg::Bounds> const meshBounds = makeMeshBounds();
+		std::vector<lg::Matrix4> const worldTransforms = lg::computeWorldTransforms(gltf,
+			lg::analyzeNodeHierarchy(gltf));
+
+		for (bool const parallel: {false, true})
+		{
+			lg::BvhOptions options;
+			options.parallel = parallel;
+			lg::SceneBvh const bvh = lg::buildSceneBvh(gltf, meshBounds, worldTransforms, options);
+
+			// Every node of the grid once, leaving out the one with empty bounds
+			LG_CHECK(bvh.items.size() == gridNodeCount);
+			std::vector<std::uint32_t> items = sorted(bvh.items);
+			for (std::uint32_t i = 0; i < gridNodeCount; ++i)
+			{
+				LG_CHECK(items[i] == i);
+			}
+
+			// Children come after their parents and lie within their boxes, and leaves are small
+			for (std::size_t i = 0; i < bvh.nodes.size(); ++i)
+			{
+				lg::BvhNode const& node = bvh.nodes[i];
+				std::vector<lg::BvhBox> contents;
+				if (node.count == 0)
+				{
+					LG_CHECK(node.index > i && node.index + 1 < bvh.nodes.size());
+					contents = {bvh.nodes[node.index].box, bvh.nodes[node.index + 1].box};
+				}
+				else
+				{
+					LG_CHECK(node.count <= options.maxLeafSize);
+					auto const first = bvh.itemBoxes.begin() + node.index;
+					contents.assign(first, first + node.count);
+				}
+				for (lg::BvhBox const& box: contents)
+				{
+					for (std::size_t k = 0; k < 3; ++k)
+					{
+						LG_CHECK(node.box.min[k] <= box.min[k] && box.max[k] <= node.box.max[k]);
+					}
+				}
+			}
+			checkOverlapping(bvh, worldTransforms);
+		}
+
+		LG_CHECK_THROWS(lg::buildSceneBvh(gltf, meshBounds, std::span(worldTransforms).first(3)),
+			std::invalid_argument);
+		LG_CHECK_THROWS(lg::buildSceneBvh(gltf, std::span(meshBounds).first(1), worldTransforms), std::out_of_range);
+	}
+
+	void testFrustum()
+	{
+		lg::Gltf const gltf = lg::loadGltf(makeDocument());
+		std::vector<lg::Matrix4> const worldTransforms = lg::computeWorldTransforms(gltf,
+			lg::analyzeNodeHierarchy(gltf));
+		lg::SceneBvh const bvh = lg::buildSceneBvh(gltf, makeMeshBounds(), worldTransforms);
+
+		// A slanted slab between two planes, and a plane 0.9 * x - 2.7 >= 0 that the boxes ending at x = 3 touch. The
+		// second plane rounded to float excludes those boxes.
+		lg::Frustum frustum;
+		frustum.planes = {{{1, 1, 0, -6.5}, {-1, -1, 0, 11}, {0.9, 0, 0, -2.7}, {0, 0, 1, 0}, {0, 0, -1, 20},
+			{0, 0, 0, 1}}};
+		std::vector<std::uint32_t> const expected = findAll(worldTransforms, [&frustum](lg::Aabb const& box)
+		{
+			for (auto const& plane: frustum.planes)
+			{
+				double distance = plane[3];
+				for (std::size_t k = 0; k < 3; ++k)
+				{
+					distance += plane[k] * (plane[k] >= 0.0 ? box.max[k] : box.min[k]);
+				}
+				if (distance < 0.0)
+				{
+					return false;
+				}
+			}
+			return true;
+		});
+		std::vector<std::uint32_t> const found = sorted(lg::findInFrustum(bvh, frustum));
+		LG_CHECK(found == expected);
+		LG_CHECK(std::find(found.begin(), found.end(), 1 + 2 * gridSize) != found.end());
+
+		// Everything is inside a frustum without constraints
+		LG_CHECK(lg::findInFrustum(bvh, lg::Frustum{}).size() == gridNodeCount);
+	}
+
+	void testRay()
+	{
+		lg::Gltf const gltf = lg::loadGltf(makeDocument());
+		std::vector<lg::Matrix4> const worldTransforms = lg::computeWorldTransforms(gltf,
+			lg::analyzeNodeHierarchy(gltf));
+		lg::SceneBvh const bvh = lg::buildSceneBvh(gltf, makeMeshBounds(), worldTransforms);
+
+		// Along the first row of the grid, entering box x at (2 * x + 0.3) / 3
+		lg::Ray ray;
+		ray.origin = {-0.3, 0.5, 0.5};
+		ray.direction = {3, 0, 0};
+		std::vector<lg::RayHit> hits = lg::intersectRay(bvh, ray);
+		LG_CHECK(hits.size() == gridSize);
+		for (std::uint32_t x = 0; x < hits.size(); ++x)
+		{
+			LG_CHECK(hits[x].node == x);
+			LG_CHECK(hits[x].distance == (2.0 * x - ray.origin[0]) * (1.0 / 3.0));
+		}
+
+		// Ending exactly where it enters the first box, which rounding to float would put beyond its end
+		ray.maxDistance = hits[0].distance;
+		hits = lg::intersectRay(bvh, ray);
+		LG_CHECK(hits.size() == 1 && hits[0].node == 0);
+
+		// Starting inside a box, and parallel to the boxes without entering them
+		ray.origin = {2.5, 0.5, 0.5};
+		ray.maxDistance = 0.1;
+		hits = lg::intersectRay(bvh, ray);
+		LG_CHECK(hits.size() == 1 && hits[0].node == 1 && hits[0].distance == 0.0);
+		ray.origin = {-0.3, 1.5, 0.5};
+		ray.maxDistance = 100;
+		LG_CHECK(lg::intersectRay(bvh, ray).empty());
+	}
+
+	void testRefit()
+	{
+		lg::Gltf const gltf = lg::loadGltf(makeDocument());
+		std::vector<lg::Bounds> meshBounds = makeMeshBounds();
+		std::vector<lg::Matrix4> worldTransforms = lg::computeWorldTransforms(gltf, lg::analyzeNodeHierarchy(gltf));
+		lg::SceneBvh bvh = lg::buildSceneBvh(gltf, meshBounds, worldTransforms);
+
+		// Mirror the grid along x, so that every box moves
+		for (std::uint32_t node = 0; node < gridNodeCount; ++node)
+		{
+			worldTransforms[node][12] = gridSize * 2.0 - worldTransforms[node][12];
+		}
+		lg::refitSceneBvh(bvh, gltf, meshBounds, worldTransforms);
+		checkOverlapping(bvh, worldTransforms);
+		for (std::size_t k = 0; k < 3; ++k)
+		{
+			LG_CHECK(bvh.nodes[0].box.min[k] == (k == 0 ? 1.0f : 0.0f));
+			LG_CHECK(bvh.nodes[0].box.max[k] == (k == 0 ? gridSize * 2.0f : gridSize * 2.0f - 1.0f));
+		}
+
+		// Meshes whose bounds become empty drop out of every query
+		meshBounds[0] = {};
+		lg::refitSceneBvh(bvh, gltf, meshBounds, worldTransforms);
+		LG_CHECK(lg::findInFrustum(bvh, lg::Frustum{}).empty());
+		LG_CHECK(lg::findOverlapping(bvh, worldBox(worldTransforms, 0)).empty());
+	}
+}
+
+int main()
+{
+	testBuild();
+	testFrustum();
+	testRay();
+	testRefit();
+}
@@ -0,0 +1,42 @@
+// SPDX-License-Identifier: MIT
+// Copyright © 2022 Sebastian Larsson
+
+#pragma once
+
+#include <cstdlib>
+#include <iostream>
+
+/**
+ * Fail the test, reporting the location, if a condition does not hold
+ */
+#define LG_CHECK(condition) \
+	do \
+	{ \
+		if (!(condition)) \
+		{ \
+			std::cerr << __FILE__ << ":" << __LINE__ << ": Check failed: " #condition "\n"; \
+			std::exit(EXIT_FAILURE); \
+		} \
+	} while (false)
+
+/**
+ * Fail the test, reporting the location, if an expression does not throw an exception of the given type
+ */
+#define LG_CHECK_THROWS(expression, exceptionType) \
+	do \
+	{ \
+		bool threw = false; \
+		try \
+		{ \
+			expression; \
+		} \
+		catch (exceptionType const&) \
+		{ \
+			threw = true; \
+		} \
+		if (!threw) \
+		{ \
+			std::cerr << __FILE__ << ":" << __LINE__ << ": Expected " #exceptionType " from " #expression "\n"; \
+			std::exit(EXIT_FAILURE); \
+		} \
+	} while (false)
@@ -0,0 +1,236 @@
+// SPDX-License-Identifier: MIT
+// Copyright © 2022 Sebastian Larsson
+
+#include <load-gltf/load-gltf.hpp>
+
+#include "check.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+namespace {
+	constexpr std::array<float, 9> positions = {1, 2, 3, 1, 2, 3, 1, 2, 3};
+	constexpr std::array<float, 9> normals = {0, 0, 1, 0.6f, 0.8f, 0, 1, 0, 0};
+	constexpr std::array<std::uint8_t, 12> joints = {0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0};
+	constexpr std::array<float, 12> weights = {1, 0, 0, 0, 1, 0, 0, 0, 0.5f, 0.5f, 0, 0};
+	constexpr std::array<float, 9> displacements0 = {1, 0, 0, 0, 2, 0, 0, 0, 4};
+	constexpr std::array<float, 9> displacements1 = {9, 9, 9, 9, 9, 9, 9, 9, 9};
+	/// Undoes the translation of joint 0, and leaves joint 1 as it is
+	constexpr std::array<float, 32> inverseBindMatrices = {1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, -1, 0, 0, 1,
+		1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1};
+
+	/// Joint 0 is translated by 1 along x, joint 1 scaled by 2 along x, and node 2 is the skinned mesh
+	constexpr std::string_view document = R"({
+		"asset": {"version": "2.0"},
+		"buffers": [{"byteLength": 332}],
+		"bufferViews": [
+			{"buffer": 0, "byteOffset": 0, "byteLength": 36},
+			{"buffer": 0, "byteOffset": 36, "byteLength": 36},
+			{"buffer": 0, "byteOffset": 72, "byteLength": 12},
+			{"buffer": 0, "byteOffset": 84, "byteLength": 48},
+			{"buffer": 0, "byteOffset": 132, "byteLength": 36},
+			{"buffer": 0, "byteOffset": 168, "byteLength": 36},
+			{"buffer": 0, "byteOffset": 204, "byteLength": 128}
+		],
+		"accessors": [
+			{"bufferView": 0, "componentType": 5126, "count": 3, "type": "VEC3"},
+			{"bufferView": 1, "componentType": 5126, "count": 3, "type": "VEC3"},
+			{"bufferView": 2, "componentType": 5121, "count": 3, "type": "VEC4"},
+			{"bufferView": 3, "componentType": 5126, "count": 3, "type": "VEC4"},
+			{"bufferView": 4, "componentType": 5126, "count": 3, "type": "VEC3"},
+			{"bufferView": 5, "componentType": 5126, "count": 3, "type": "VEC3"},
+			{"bufferView": 6, "componentType": 5126, "count": 2, "type": "MAT4"}
+		],
+		"meshes": [{"primitives": [{"attributes": {"POSITION": 0, "NORMAL": 1, "JOINTS_0": 2, "WEIGHTS_0": 3},
+			"targets": [{"POSITION": 4}, {"POSITION": 5}]}]}],
+		"skins": [{"joints": [0, 1], "inverseBindMatrices": 6}],
+		"nodes": [{"translation": [1, 0, 0]}, {"scale": [2, 1, 1]}, {"mesh": 0, "skin": 0}]
+	})";
+
+	std::vector<std::byte> makeBuffer()
+	{
+		std::vector<std::byte> buffer;
+		auto append = [&buffer](auto const& values)
+		{
+			auto const bytes = std::as_bytes(std::span(values));
+			buffer.insert(buffer.end(), bytes.begin(), bytes.end());
+		};
+		append(positions);
+		append(normals);
+		append(joints);
+		append(weights);
+		append(displacements0);
+		append(displacements1);
+		append(inverseBindMatrices);
+		return buffer;
+	}
+
+	bool near(float a, float b)
+	{
+		return std::abs(a - b) < 1e-5f;
+	}
+
+	bool near(std::span<float const> values, std::array<float, 3> const& expected)
+	{
+		return near(values[0], expected[0]) && near(values[1], expected[1]) && near(values[2], expected[2]);
+	}
+
+	lg::Matrix4 scaleMatrix(double x, double y, double z)
+	{
+		return {x, 0, 0, 0, 0, y, 0, 0, 0, 0, z, 0, 0, 0, 0, 1};
+	}
+
+	void testBlending()
+	{
+		std::array<lg::Matrix4, 2> const matrices = {lg::identityMatrix, scaleMatrix(3, 1, 1)};
+		std::array<std::uint32_t, 8> const vertexJoints = {0, 1, 0, 0, 1, 0, 0, 0};
+		std::array<float, 8> const vertexWeights = {0.5f, 0.5f, 0, 0, 1, 0, 0, 0};
+		std::array<float, 6> const vertexPositions = {1, 1, 1, 1, 1, 1};
+
+		lg::SkinnedVertices const skinned = lg::skinVertices(vertexPositions, {}, vertexJoints, vertexWeights,
+			matrices);
+		LG_CHECK(skinned.normals.empty());
+		LG_CHECK(near(std::span(skinned.positions).first(3), {2, 1, 1}));
+		LG_CHECK(near(std::span(skinned.positions).last(3), {3, 1, 1}));
+	}
+
+	void testNormals()
+	{
+		// The plane x + y = 1 scaled by 2 along x becomes x / 2 + y = 1, with normal (1, 2, 0) / sqrt(5)
+		float const half = std::sqrt(0.5f);
+		std::array<float, 3> const position = {0, 0, 0};
+		std::array<float, 3> const normal = {half, half, 0};
+		std::array<std::uint32_t, 4> const vertexJoints = {0, 0, 0, 0};
+		std::array<float, 4> const vertexWeights = {1, 0, 0, 0};
+		std::array<lg::Matrix4, 1> const scale = {scaleMatrix(2, 1, 1)};
+		lg::SkinnedVertices skinned = lg::skinVertices(position, normal, vertexJoints, vertexWeights, scale);
+		float const fifth = std::sqrt(0.2f);
+		LG_CHECK(near(skinned.normals, {fifth, 2 * fifth, 0}));
+
+		// Mirroring flips the normal along with the surface
+		std::array<float, 3> const xAxis = {1, 0, 0};
+		std::array<lg::Matrix4, 1> const mirror = {scaleMatrix(-1, 1, 1)};
+		skinned = lg::skinVertices(position, xAxis, vertexJoints, vertexWeights, mirror);
+		LG_CHECK(near(skinned.normals, {-1, 0, 0}));
+
+		// Uniform scale and rotation only renormalize
+		lg::Matrix4 rotation = scaleMatrix(5, 5, 5);
+		rotation[0] = 0;
+		rotation[1] = 5;
+		rotation[4] = -5;
+		rotation[5] = 0;
+		std::array<lg::Matrix4, 1> const rotations = {rotation};
+		skinned = lg::skinVertices(position, xAxis, vertexJoints, vertexWeights, rotations);
+		LG_CHECK(near(skinned.normals, {0, 1, 0}));
+	}
+
+	void testInvalidInput()
+	{
+		std::array<lg::Matrix4, 1> const matrices = {lg::identityMatrix};
+		std::array<float, 3> const position = {0, 0, 0};
+		std::array<std::uint32_t, 4> const outOfRange = {0, 1, 0, 0};
+		std::array<float, 4> const vertexWeights = {1, 0, 0, 0};
+		LG_CHECK_THROWS(lg::skinVertices(position, {}, outOfRange, vertexWeights, matrices), std::out_of_range);
+		LG_CHECK_THROWS(lg::skinVertices(position, {}, outOfRange, std::span(vertexWeights).first(3), matrices),
+			std::invalid_argument);
+	}
+
+	void testSerialMatchesParallel()
+	{
+		// Enough vertices to be split into several tasks
+		std::size_t const vertexCount = 300000;
+		std::vector<float> vertexPositions(vertexCount * 3);
+		std::vector<float> vertexNormals(vertexCount * 3);
+		std::vector<std::uint32_t> vertexJoints(vertexCount * 4);
+		std::vector<float> vertexWeights(vertexCount * 4);
+		for (std::size_t i = 0; i < vertexCount; ++i)
+		{
+			vertexPositions[i * 3] = static_cast<float>(i);
+			vertexNormals[i * 3 + 1] = 1;
+			vertexJoints[i * 4] = static_cast<std::uint32_t>(i % 2);
+			vertexJoints[i * 4 + 1] = static_cast<std::uint32_t>((i + 1) % 2);
+			vertexWeights[i * 4] = 0.75f;
+			vertexWeights[i * 4 + 1] = 0.25f;
+		}
+		std::array<lg::Matrix4, 2> const matrices = {scaleMatrix(1, 2, 3), scaleMatrix(3, 2, 1)};
+
+		lg::DeformOptions serial;
+		serial.parallel = false;
+		lg::SkinnedVertices const expected = lg::skinVertices(vertexPositions, vertexNormals, vertexJoints,
+			vertexWeights, matrices, serial);
+		lg::SkinnedVertices const skinned = lg::skinVertices(vertexPositions, vertexNormals, vertexJoints,
+			vertexWeights, matrices);
+		LG_CHECK(skinned.positions == expected.positions);
+		LG_CHECK(skinned.normals == expected.normals);
+	}
+
+	void testPrimitive()
+	{
+		lg::Gltf const gltf = lg::loadGltf(document);
+		std::vector<std::byte> const buffer = makeBuffer();
+		std::array<lg::BufferData, 1> const buffers = {buffer};
+		auto const& primitive = gltf.meshes[0].primitives[0];
+
+		std::vector<lg::Matrix4> const worldTransforms = lg::computeWorldTransforms(gltf,
+			lg::analyzeNodeHierarchy(gltf));
+		std::vector<lg::Matrix4> const jointMatrices = lg::computeJointMatrices(gltf, buffers, 0, worldTransforms);
+		LG_CHECK(jointMatrices.size() == 2);
+		LG_CHECK(jointMatrices[0] == lg::identityMatrix);
+		LG_CHECK(jointMatrices[1] == scaleMatrix(2, 1, 1));
+		LG_CHECK_THROWS(lg::computeJointMatrices(gltf, buffers, 1, worldTransforms), std::out_of_range);
+
+		lg::SkinnedVertices const skinned = lg::skinVertices(gltf, buffers, primitive, jointMatrices);
+		std::span<float const> const skinnedPositions = skinned.positions;
+		LG_CHECK(near(skinnedPositions.subspan(0, 3), {1, 2, 3}));
+		LG_CHECK(near(skinnedPositions.subspan(3, 3), {2, 2, 3}));
+		LG_CHECK(near(skinnedPositions.subspan(6, 3), {1.5f, 2, 3}));
+		std::span<float const> const skinnedNormals = skinned.normals;
+		LG_CHECK(near(skinnedNormals.subspan(0, 3), {0, 0, 1}));
+		// (0.6, 0.8, 0) through the inverse transpose of a scale by 2 along x
+		float const length = std::sqrt(0.3f * 0.3f + 0.8f * 0.8f);
+		LG_CHECK(near(skinnedNormals.subspan(3, 3), {0.3f / length, 0.8f / length, 0}));
+		LG_CHECK(near(skinnedNormals.subspan(6, 3), {1, 0, 0}));
+	}
+
+	void testMorphTargets()
+	{
+		lg::Gltf const gltf = lg::loadGltf(document);
+		std::vector<std::byte> const buffer = makeBuffer();
+		std::array<lg::BufferData, 1> const buffers = {buffer};
+		auto const& primitive = gltf.meshes[0].primitives[0];
+
+		// The second target has a zero weight, so its large displacements are skipped
+		std::array<float, 2> const targetWeights = {0.5f, 0};
+		std::vector<float> const morphed = lg::applyMorphTargets(gltf, buffers, primitive, "POSITION", targetWeights);
+		LG_CHECK(near(std::span(morphed).subspan(0, 3), {1.5f, 2, 3}));
+		LG_CHECK(near(std::span(morphed).subspan(3, 3), {1, 3, 3}));
+		LG_CHECK(near(std::span(morphed).subspan(6, 3), {1, 2, 5}));
+
+		// Weights beyond the targets, and targets beyond the weights, are ignored
+		std::array<float, 1> const fewerWeights = {1};
+		std::vector<float> const first = lg::applyMorphTargets(gltf, buffers, primitive, "POSITION", fewerWeights);
+		LG_CHECK(near(std::span(first).subspan(6, 3), {1, 2, 7}));
+
+		// Targets without the attribute leave it unchanged
+		std::vector<float> const normalsOnly = lg::applyMorphTargets(gltf, buffers, primitive, "NORMAL", targetWeights);
+		LG_CHECK(std::equal(normalsOnly.begin(), normalsOnly.end(), normals.begin()));
+		LG_CHECK_THROWS(lg::applyMorphTargets(gltf, buffers, primitive, "TANGENT", targetWeights), std::out_of_range);
+	}
+}
+
+int main()
+{
+	testBlending();
+	testNormals();
+	testInvalidInput();
+	testSerialMatchesParallel();
+	testPrimitive();
+	testMorphTargets();
+}
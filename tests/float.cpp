@@ -0,0 +1,147 @@
+// SPDX-License-Identifier: MIT
+// Copyright © 2022 Sebastian Larsson
+
+#include <load-gltf/load-gltf.hpp>
+
+#include "check.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace {
+	constexpr std::string_view document = R"({
+		"asset": {"version": "2.0"},
+		"nodes": [
+			{"translation": [0.1, -2.5e3, 1e-7], "rotation": [0, 0.7071067811865476, 0, 0.7071067811865476],
+				"scale": [3, 3, 3], "weights": [0.3333333333333333, 0.6666666666666666], "children": [1]},
+			{"matrix": [1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 123456.789, 0.2, -0.3, 1]}
+		],
+		"meshes": [{"primitives": [{"attributes": {"POSITION": 0}}], "weights": [0.1, 0.9]}],
+		"accessors": [{"count": 3, "type": "VEC3", "componentType": 5126, "min": [-0.1, -1, 16777217],
+			"max": [0.1, 1, 1e30]}],
+		"materials": [{"pbrMetallicRoughness": {"baseColorFactor": [0.8, 0.6, 0.4, 1], "metallicFactor": 0.2},
+			"emissiveFactor": [0.1, 0.2, 0.3], "alphaCutoff": 0.25}]
+	})";
+
+	static_assert(std::is_same_v<decltype(lg::FloatGltf{}.nodes[0].translation)::value_type, float>);
+	static_assert(std::is_same_v<decltype(lg::FloatGltf{}.accessors[0].min)::value_type, float>);
+	static_assert(sizeof(lg::BasicNode<lg::FloatStorage>) < sizeof(lg::Node));
+
+	/**
+	 * Check that a float field holds the double field rounded to the nearest float
+	 */
+	template<typename FloatRange, typename DoubleRange>
+	bool isRounded(FloatRange const& floats, DoubleRange const& doubles)
+	{
+		if (floats.size() != doubles.size())
+		{
+			return false;
+		}
+		for (std::size_t i = 0; i < floats.size(); ++i)
+		{
+			if (floats[i] != static_cast<float>(doubles[i]))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	void testMatchesDouble()
+	{
+		lg::FloatGltf const gltf = lg::loadGltfFloat(document);
+		lg::Gltf const reference = lg::loadGltf(document);
+
+		for (std::size_t i = 0; i < gltf.nodes.size(); ++i)
+		{
+			LG_CHECK(isRounded(gltf.nodes[i].translation, reference.nodes[i].translation));
+			LG_CHECK(isRounded(gltf.nodes[i].rotation, reference.nodes[i].rotation));
+			LG_CHECK(isRounded(gltf.nodes[i].scale, reference.nodes[i].scale));
+			LG_CHECK(isRounded(gltf.nodes[i].matrix, reference.nodes[i].matrix));
+			LG_CHECK(isRounded(gltf.nodes[i].weights, reference.nodes[i].weights));
+		}
+		LG_CHECK(isRounded(gltf.meshes[0].weights, reference.meshes[0].weights));
+		LG_CHECK(isRounded(gltf.accessors[0].min, reference.accessors[0].min));
+		LG_CHECK(isRounded(gltf.accessors[0].max, reference.accessors[0].max));
+
+		auto const& material = gltf.materials[0];
+		auto const& referenceMaterial = reference.materials[0];
+		LG_CHECK(isRounded(material.pbrMetallicRoughness->baseColorFactor,
+			referenceMaterial.pbrMetallicRoughness->baseColorFactor));
+		LG_CHECK(material.pbrMetallicRoughness->metallicFactor == 0.2f);
+		LG_CHECK(material.pbrMetallicRoughness->roughnessFactor == 1.0f);
+		LG_CHECK(isRounded(material.emissiveFactor, referenceMaterial.emissiveFactor));
+		LG_CHECK(material.alphaCutoff == 0.25f);
+	}
+
+	void testRounding()
+	{
+		lg::FloatGltf const gltf = lg::loadGltfFloat(document);
+
+		LG_CHECK(gltf.nodes[0].translation[0] == 0.1f);
+		LG_CHECK(gltf.nodes[0].translation[2] == 1e-7f);
+		LG_CHECK(gltf.nodes[1].matrix[12] == 123456.789f);
+		// 2^24 + 1 is the first integer a float can not hold
+		LG_CHECK(gltf.accessors[0].min[2] == 16777216.0f);
+		LG_CHECK(gltf.accessors[0].max[2] == 1e30f);
+	}
+
+	void testPrePadded()
+	{
+		std::string const padded = std::string(document) + std::string(lg::paddingSize, ' ');
+		lg::FloatGltf const gltf = lg::loadGltfFloatPrePadded(std::string_view(padded.data(), document.size()));
+		LG_CHECK(gltf.nodes.size() == 2);
+		LG_CHECK(gltf.nodes[0].children.size() == 1);
+		LG_CHECK(gltf.nodes[0].scale[1] == 3.0f);
+	}
+
+	void testWriteRoundTrip()
+	{
+		lg::FloatGltf const gltf = lg::loadGltfFloat(document);
+		lg::FloatGltf const reloaded = lg::loadGltfFloat(lg::writeGltf(gltf));
+
+		// Written floats parse back to the same floats
+		LG_CHECK(reloaded.nodes[0].translation == gltf.nodes[0].translation);
+		LG_CHECK(reloaded.nodes[0].rotation == gltf.nodes[0].rotation);
+		LG_CHECK(reloaded.nodes[1].matrix == gltf.nodes[1].matrix);
+		LG_CHECK(reloaded.nodes[0].weights == gltf.nodes[0].weights);
+		LG_CHECK(reloaded.accessors[0].max == gltf.accessors[0].max);
+		LG_CHECK(reloaded.materials[0].emissiveFactor == gltf.materials[0].emissiveFactor);
+	}
+
+	void testWorldTransforms()
+	{
+		lg::FloatGltf const gltf = lg::loadGltfFloat(document);
+		lg::Gltf const reference = lg::loadGltf(document);
+		std::vector<lg::Matrix4> const transforms = lg::computeWorldTransforms(gltf, lg::analyzeNodeHierarchy(gltf));
+		std::vector<lg::Matrix4> const referenceTransforms = lg::computeWorldTransforms(reference,
+			lg::analyzeNodeHierarchy(reference));
+		for (std::size_t i = 0; i < transforms.size(); ++i)
+		{
+			// Single precision inputs give errors relative to the largest element, as elements cancel out
+			double scale = 1.0;
+			for (double const element: referenceTransforms[i])
+			{
+				scale = std::max(scale, std::abs(element));
+			}
+			for (std::size_t k = 0; k < 16; ++k)
+			{
+				LG_CHECK(std::abs(transforms[i][k] - referenceTransforms[i][k]) < 1e-6 * scale);
+			}
+		}
+	}
+}
+
+int main()
+{
+	testMatchesDouble();
+	testRounding();
+	testPrePadded();
+	testWriteRoundTrip();
+	testWorldTransforms();
+}
@@ -0,0 +1,98 @@
+// SPDX-License-Identifier: MIT
+// Copyright © 2022 Sebastian Larsson
+
+#include <load-gltf/load-gltf.hpp>
+
+#include "check.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace {
+	void testForest()
+	{
+		lg::Gltf const gltf = lg::loadGltf(R"({
+			"asset": {"version": "2.0"},
+			"nodes": [{"children": [3]}, {"children": [2, 4]}, {}, {"children": [9]}, {}],
+			"scenes": [{"nodes": [1, 0, 1, 3, 7]}, {"nodes": [1]}]
+		})");
+		lg::NodeHierarchy const hierarchy = lg::analyzeNodeHierarchy(gltf);
+
+		LG_CHECK(hierarchy.isForest());
+		LG_CHECK((hierarchy.parents == std::vector<std::uint32_t>{lg::noIndex, lg::noIndex, 1, 0, 1}));
+		LG_CHECK((hierarchy.roots == std::vector<std::uint32_t>{0, 1}));
+		LG_CHECK((hierarchy.order == std::vector<std::uint32_t>{0, 1, 3, 2, 4}));
+		// Duplicates, non-root nodes and out of range nodes are left out
+		LG_CHECK(hierarchy.sceneRoots.size() == 2);
+		LG_CHECK((hierarchy.sceneRoots[0] == std::vector<std::uint32_t>{1, 0}));
+		LG_CHECK((hierarchy.sceneRoots[1] == std::vector<std::uint32_t>{1}));
+	}
+
+	void testSharedChild()
+	{
+		lg::Gltf const gltf = lg::loadGltf(R"({
+			"asset": {"version": "2.0"},
+			"nodes": [{"children": [2]}, {"children": [3, 2]}, {}, {}]
+		})");
+		lg::NodeHierarchy const hierarchy = lg::analyzeNodeHierarchy(gltf);
+
+		LG_CHECK(!hierarchy.isForest());
+		LG_CHECK(hierarchy.cycles.empty());
+		// The first reference wins, later ones are reported with their position among the children
+		LG_CHECK(hierarchy.parents[2] == 0);
+		LG_CHECK(hierarchy.sharedChildren.size() == 1);
+		LG_CHECK(hierarchy.sharedChildren[0].parent == 1);
+		LG_CHECK(hierarchy.sharedChildren[0].position == 1);
+		LG_CHECK(hierarchy.sharedChildren[0].child == 2);
+		LG_CHECK(hierarchy.order.size() == 4);
+	}
+
+	void testCycles()
+	{
+		lg::Gltf const gltf = lg::loadGltf(R"({
+			"asset": {"version": "2.0"},
+			"nodes": [{}, {"children": [2]}, {"children": [1, 3]}, {}, {"children": [4]}],
+			"scenes": [{"nodes": [0, 1]}]
+		})");
+		lg::NodeHierarchy const hierarchy = lg::analyzeNodeHierarchy(gltf);
+
+		LG_CHECK(!hierarchy.isForest());
+		LG_CHECK(hierarchy.sharedChildren.empty());
+		// One node of the two-node cycle and the node that is its own child, but not the node below the cycle
+		LG_CHECK((hierarchy.cycles == std::vector<std::uint32_t>{1, 4}));
+		LG_CHECK((hierarchy.roots == std::vector<std::uint32_t>{0}));
+		LG_CHECK((hierarchy.order == std::vector<std::uint32_t>{0}));
+		// Nodes in a cycle have a parent, so they are not scene roots
+		LG_CHECK((hierarchy.sceneRoots[0] == std::vector<std::uint32_t>{0}));
+	}
+
+	void testDeepHierarchy()
+	{
+		lg::Gltf gltf;
+		gltf.nodes.resize(200000);
+		for (std::uint32_t i = 1; i < gltf.nodes.size(); ++i)
+		{
+			gltf.nodes[i - 1].children.push_back(i);
+		}
+		lg::NodeHierarchy hierarchy = lg::analyzeNodeHierarchy(gltf);
+		LG_CHECK(hierarchy.isForest());
+		LG_CHECK(hierarchy.order.size() == gltf.nodes.size());
+		LG_CHECK(hierarchy.order.back() == gltf.nodes.size() - 1);
+
+		// Closing the chain into a cycle leaves no root
+		gltf.nodes.back().children.push_back(0);
+		hierarchy = lg::analyzeNodeHierarchy(gltf);
+		LG_CHECK(hierarchy.roots.empty());
+		LG_CHECK(hierarchy.order.empty());
+		LG_CHECK(hierarchy.cycles.size() == 1);
+	}
+}
+
+int main()
+{
+	testForest();
+	testSharedChild();
+	testCycles();
+	testDeepHierarchy();
+}
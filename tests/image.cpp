@@ -0,0 +1,329 @@
+// SPDX-License-Identifier: MIT
+// Copyright © 2022 Sebastian Larsson
+
+#include <load-gltf/load-gltf.hpp>
+
+#include "check.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <initializer_list>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+	using Bytes = std::vector<std::byte>;
+
+	void append(Bytes& data, std::string_view text)
+	{
+		for (char const c: text)
+		{
+			data.push_back(static_cast<std::byte>(c));
+		}
+	}
+
+	void append(Bytes& data, std::initializer_list<std::uint8_t> values)
+	{
+		for (std::uint8_t const value: values)
+		{
+			data.push_back(std::byte{value});
+		}
+	}
+
+	void appendBigEndian(Bytes& data, std::uint32_t value, std::size_t size)
+	{
+		for (std::size_t i = size; i-- > 0;)
+		{
+			data.push_back(static_cast<std::byte>(value >> (i * 8) & 0xff));
+		}
+	}
+
+	void appendLittleEndian(Bytes& data, std::uint32_t value, std::size_t size)
+	{
+		for (std::size_t i = 0; i < size; ++i)
+		{
+			data.push_back(static_cast<std::byte>(value >> (i * 8) & 0xff));
+		}
+	}
+
+	/**
+	 * PNG signature and header, followed by the given chunks without contents, with CRCs left as zero
+	 */
+	Bytes makePng(std::uint32_t width, std::uint32_t height, std::uint8_t bitDepth, std::uint8_t colorType,
+		std::initializer_list<std::string_view> chunks)
+	{
+		Bytes data;
+		append(data, "\x89PNG\r\n\x1a\n");
+		appendBigEndian(data, 13, 4);
+		append(data, "IHDR");
+		appendBigEndian(data, width, 4);
+		appendBigEndian(data, height, 4);
+		append(data, {bitDepth, colorType, 0, 0, 0, 0, 0, 0, 0});
+		for (std::string_view const chunk: chunks)
+		{
+			appendBigEndian(data, 0, 4);
+			append(data, chunk);
+			appendBigEndian(data, 0, 4);
+		}
+		return data;
+	}
+
+	/**
+	 * JPEG with an APP1 segment of metadataSize bytes and fill bytes before a progressive frame header
+	 */
+	Bytes makeJpeg(std::uint16_t width, std::uint16_t height, std::size_t metadataSize)
+	{
+		Bytes data;
+		append(data, {0xff, 0xd8, 0xff, 0xe1});
+		appendBigEndian(data, static_cast<std::uint32_t>(metadataSize + 2), 2);
+		data.resize(data.size() + metadataSize);
+		append(data, {0xff, 0xff, 0xff, 0xc2});
+		appendBigEndian(data, 17, 2);
+		append(data, {8});
+		appendBigEndian(data, height, 2);
+		appendBigEndian(data, width, 2);
+		append(data, {3, 1, 0x22, 0, 2, 0x11, 1, 3, 0x11, 1});
+		append(data, {0xff, 0xd9});
+		return data;
+	}
+
+	/**
+	 * KTX2 header and a basic data format descriptor with a sample for each channel id
+	 */
+	Bytes makeKtx2(std::uint32_t vkFormat, std::uint32_t width, std::uint32_t height, std::uint32_t levels,
+		std::uint8_t colorModel, std::uint8_t blockSize, std::initializer_list<std::uint8_t> channelIds)
+	{
+		std::uint32_t const blockLength = 24 + 16 * static_cast<std::uint32_t>(channelIds.size());
+		Bytes data;
+		append(data, "\xabKTX 20\xbb\r\n\x1a\n");
+		for (std::uint32_t const value: {vkFormat, 1u, width, height, 0u, 0u, 1u, levels, 0u, 80u, 4 + blockLength})
+		{
+			appendLittleEndian(data, value, 4);
+		}
+		data.resize(80);
+
+		appendLittleEndian(data, 4 + blockLength, 4);
+		appendLittleEndian(data, 0, 4);
+		appendLittleEndian(data, 2, 2);
+		appendLittleEndian(data, blockLength, 2);
+		append(data, {colorModel, 1, 2, 0});
+		// Texel block dimensions minus one, then bytes per plane
+		append(data, {blockSize, blockSize, 0, 0});
+		data.resize(data.size() + 8);
+		std::uint32_t bitOffset = 0;
+		for (std::uint8_t const channelId: channelIds)
+		{
+			appendLittleEndian(data, bitOffset, 2);
+			append(data, {7, channelId});
+			data.resize(data.size() + 12);
+			bitOffset += 8;
+		}
+		return data;
+	}
+
+	/**
+	 * RIFF header and the start of a WebP chunk, padded to the 30 bytes probed
+	 */
+	Bytes makeWebp(std::string_view chunk, std::initializer_list<std::uint8_t> contents)
+	{
+		Bytes data;
+		append(data, "RIFF");
+		appendLittleEndian(data, 22, 4);
+		append(data, "WEBP");
+		append(data, chunk);
+		appendLittleEndian(data, 10, 4);
+		append(data, contents);
+		data.resize(30);
+		return data;
+	}
+
+	void checkInfo(lg::ImageInfo const& info, std::string_view mimeType, std::uint32_t width, std::uint32_t height,
+		std::uint32_t channels, std::uint32_t bitDepth)
+	{
+		LG_CHECK(info.mimeType == mimeType);
+		LG_CHECK(info.width == width);
+		LG_CHECK(info.height == height);
+		LG_CHECK(info.channels == channels);
+		LG_CHECK(info.bitDepth == bitDepth);
+	}
+
+	/**
+	 * Document with every image in a buffer view of one buffer, and the images in that buffer
+	 */
+	std::string makeDocument(std::vector<Bytes> const& images, Bytes& buffer)
+	{
+		std::string bufferViews;
+		std::string imageList;
+		for (std::size_t i = 0; i < images.size(); ++i)
+		{
+			std::string const separator = i == 0 ? "" : ",";
+			bufferViews += separator + R"({"buffer": 0, "byteOffset": )" + std::to_string(buffer.size())
+				+ R"(, "byteLength": )" + std::to_string(images[i].size()) + "}";
+			imageList += separator + R"({"bufferView": )" + std::to_string(i) + R"(, "mimeType": "image/png"})";
+			buffer.insert(buffer.end(), images[i].begin(), images[i].end());
+		}
+		return R"({"asset": {"version": "2.0"}, "buffers": [{"byteLength": )" + std::to_string(buffer.size())
+			+ R"(}], "bufferViews": [)" + bufferViews + R"(], "images": [)" + imageList + "]}";
+	}
+
+	void testFormats()
+	{
+		std::vector<Bytes> const images = {
+			makePng(8, 4, 16, 6, {"IDAT"}),
+			makePng(300, 200, 8, 3, {"PLTE", "tRNS", "IDAT"}),
+			makePng(1, 1, 1, 0, {"IDAT", "tRNS"}),
+			makeJpeg(640, 480, 16),
+			makeKtx2(43, 256, 128, 9, 1, 0, {0, 1, 2, 15}),
+			makeKtx2(0, 64, 0, 1, 166, 3, {3}),
+			makeKtx2(0, 64, 64, 7, 163, 3, {0, 15}),
+			makeWebp("VP8 ", {0, 0, 0, 0x9d, 0x01, 0x2a, 0x80, 0x02, 0xe0, 0x01}),
+			makeWebp("VP8L", {0x2f, 0x3f, 0x40, 0x1f, 0x10}),
+			makeWebp("VP8X", {0x10, 0, 0, 0, 0xff, 0x0f, 0, 0x0f, 0, 0}),
+			Bytes(64, std::byte{0x42}),
+		};
+		Bytes buffer;
+		lg::Gltf const gltf = lg::loadGltf(makeDocument(images, buffer));
+		std::array<lg::BufferData, 1> const buffers = {buffer};
+
+		for (bool const parallel: {false, true})
+		{
+			lg::ImageProbeOptions options;
+			options.parallel = parallel;
+			std::vector<lg::ImageInfo> const infos = lg::probeImages(gltf, {buffers, {}}, options);
+			LG_CHECK(infos.size() == images.size());
+
+			checkInfo(infos[0], "image/png", 8, 4, 4, 16);
+			// Palette and grayscale images get an alpha channel from a tRNS chunk only before the image data
+			checkInfo(infos[1], "image/png", 300, 200, 4, 8);
+			checkInfo(infos[2], "image/png", 1, 1, 1, 1);
+			checkInfo(infos[3], "image/jpeg", 640, 480, 3, 8);
+
+			checkInfo(infos[4], "image/ktx2", 256, 128, 4, 8);
+			LG_CHECK(infos[4].vkFormat == 43);
+			LG_CHECK(infos[4].levels == 9);
+			// UASTC with an RGBA sample, and a zero height for one-dimensional textures read as 1
+			checkInfo(infos[5], "image/ktx2", 64, 1, 4, 0);
+			LG_CHECK(infos[5].vkFormat == 0);
+			// ETC1S with RGB and alpha slices
+			checkInfo(infos[6], "image/ktx2", 64, 64, 4, 0);
+			LG_CHECK(infos[6].levels == 7);
+
+			checkInfo(infos[7], "image/webp", 640, 480, 3, 8);
+			checkInfo(infos[8], "image/webp", 64, 126, 4, 8);
+			checkInfo(infos[9], "image/webp", 4096, 16, 4, 8);
+
+			// The mime type of the document is not trusted
+			checkInfo(infos[10], "", 0, 0, 0, 0);
+			LG_CHECK(infos[10].levels == 1);
+			LG_CHECK(infos[10].bytesRead == images[10].size());
+		}
+
+		LG_CHECK_THROWS(lg::probeImages(gltf, {}), std::out_of_range);
+		std::array<lg::BufferData, 1> const truncated = {std::span(buffer).first(10)};
+		LG_CHECK_THROWS(lg::probeImages(gltf, {truncated, {}}), std::out_of_range);
+	}
+
+	void testTruncated()
+	{
+		// Headers cut short are not recognized rather than read past their end
+		Bytes png = makePng(8, 4, 8, 2, {});
+		png.resize(32);
+		Bytes jpeg = makeJpeg(640, 480, 16);
+		jpeg.resize(24);
+		Bytes ktx2 = makeKtx2(43, 4, 4, 1, 1, 0, {0});
+		ktx2.resize(79);
+		Bytes buffer;
+		lg::Gltf const gltf = lg::loadGltf(makeDocument({png, jpeg, ktx2}, buffer));
+		std::array<lg::BufferData, 1> const buffers = {buffer};
+		for (lg::ImageInfo const& info: lg::probeImages(gltf, {buffers, {}}))
+		{
+			LG_CHECK(info.mimeType.empty());
+		}
+	}
+
+	void testUris()
+	{
+		constexpr std::string_view document = R"({
+			"asset": {"version": "2.0"},
+			"images": [
+				{"uri": "data:image/png;base64,iVBORw0KGgoAAAANSUhEUgAAAAgAAAAECAYAAAAAAAAA"},
+				{"uri": "photo.jpg"},
+				{"uri": "missing.png"},
+				{"uri": "data:image/png,%89PNG"}
+			]
+		})";
+		lg::Gltf const gltf = lg::loadGltf(document);
+
+		// Only the headers of a large JPEG are read, skipping over its metadata
+		Bytes const jpeg = makeJpeg(1920, 1080, 60000);
+		std::vector<std::string> requested;
+		lg::ImageResources resources;
+		resources.readUri = [&jpeg, &requested](std::string_view uri, std::uint64_t offset, std::size_t size)
+		{
+			requested.emplace_back(uri);
+			if (uri != "photo.jpg" || offset >= jpeg.size())
+			{
+				return Bytes();
+			}
+			auto const first = jpeg.begin() + static_cast<std::ptrdiff_t>(offset);
+			return Bytes(first, first + static_cast<std::ptrdiff_t>(std::min(size, jpeg.size() - offset)));
+		};
+
+		lg::ImageProbeOptions options;
+		options.parallel = false;
+		std::vector<lg::ImageInfo> const infos = lg::probeImages(gltf, resources, options);
+		checkInfo(infos[0], "image/png", 8, 4, 4, 8);
+		checkInfo(infos[1], "image/jpeg", 1920, 1080, 3, 8);
+		LG_CHECK(infos[1].bytesRead < 10000);
+		checkInfo(infos[2], "", 0, 0, 0, 0);
+		checkInfo(infos[3], "", 0, 0, 0, 0);
+		LG_CHECK((requested == std::vector<std::string>{"photo.jpg", "photo.jpg", "missing.png"}));
+
+		// Without a reader, images outside the document are left alone
+		LG_CHECK(lg::probeImages(gltf, {}, options)[1].mimeType.empty());
+	}
+
+	void testFileUriReader()
+	{
+		std::filesystem::path const parent = std::filesystem::temp_directory_path();
+		std::filesystem::path const directory = parent / "load-gltf image test";
+		std::filesystem::create_directories(directory / "textures");
+		Bytes const png = makePng(16, 16, 8, 2, {"IDAT"});
+		for (std::filesystem::path const& path: {directory / "textures" / "a.png", parent / "load-gltf outside.png"})
+		{
+			std::ofstream file(path, std::ios::binary);
+			file.write(reinterpret_cast<char const*>(png.data()), static_cast<std::streamsize>(png.size()));
+		}
+
+		lg::UriReader const reader = lg::fileUriReader(directory);
+		LG_CHECK(reader("textures/a.png", 0, 4096) == png);
+		LG_CHECK((reader("textures/a.png", 16, 4) == Bytes(png.begin() + 16, png.begin() + 20)));
+		LG_CHECK(reader("textures/a.png", 4096, 4).empty());
+		LG_CHECK(reader("textures/missing.png", 0, 4).empty());
+		LG_CHECK(lg::fileUriReader(parent)("load-gltf%20image%20test/textures/a.png", 0, 4096) == png);
+
+		// Files outside of the directory are not read, even if they exist
+		LG_CHECK(reader("../load-gltf%20outside.png", 0, 4096).empty());
+		LG_CHECK(reader("textures/../../load-gltf%20outside.png", 0, 4096).empty());
+		LG_CHECK(reader("textures/..", 0, 4096).empty());
+		LG_CHECK(reader((parent / "load-gltf outside.png").string(), 0, 4096).empty());
+
+		std::filesystem::remove_all(directory);
+		std::filesystem::remove(parent / "load-gltf outside.png");
+	}
+}
+
+int main()
+{
+	testFormats();
+	testTruncated();
+	testUris();
+	testFileUriReader();
+}
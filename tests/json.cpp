@@ -0,0 +1,105 @@
+// SPDX-License-Identifier: MIT
+// Copyright © 2022 Sebastian Larsson
+
+#include <load-gltf/load-gltf.hpp>
+
+#include "check.hpp"
+
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <variant>
+
+namespace {
+	constexpr std::string_view document = R"({
+		"asset": {"version": "2.0"},
+		"extensionsUsed": ["EXT_unknown", "EXT_meshopt_compression"],
+		"nodes": [
+			{"extras": {"tag": "a", "values": [1, 2.5, true, null]}, "extensions": {"EXT_unknown": {"depth": [3]}}},
+			{"extras": 42  },
+			{"extras": "text" , "name": "after"},
+			{"extras": [ ]}
+		],
+		"buffers": [{"byteLength": 8}],
+		"bufferViews": [{"buffer": 0, "byteLength": 8, "extensions": {
+			"EXT_meshopt_compression": {"buffer": 0, "byteLength": 8, "count": 2, "byteStride": 4, "mode": "INDICES"}}}],
+		"extras": {"revision": 3, "revision": 4}
+	})";
+
+	std::string const padded = std::string(document) + std::string(lg::paddingSize, ' ');
+	std::string_view const json(padded.data(), document.size());
+
+	void testRawJson()
+	{
+		lg::Gltf const gltf = lg::loadGltf(document);
+
+		// Captured verbatim, without the whitespace following scalars
+		LG_CHECK(gltf.nodes[0].extras->json == R"({"tag": "a", "values": [1, 2.5, true, null]})");
+		LG_CHECK(gltf.nodes[1].extras->json == "42");
+		LG_CHECK(gltf.nodes[2].extras->json == R"("text")");
+		LG_CHECK(gltf.nodes[2].name == "after");
+		LG_CHECK(gltf.nodes[3].extras->json == "[ ]");
+		LG_CHECK(gltf.nodes[0].extensions.at("EXT_unknown").json == R"({"depth": [3]})");
+		LG_CHECK(gltf.extras->json == R"({"revision": 3, "revision": 4})");
+
+		// Extensions modeled by typed members are not captured
+		auto const& bufferView = gltf.bufferViews[0];
+		LG_CHECK(bufferView.meshoptCompression.has_value());
+		LG_CHECK(bufferView.extensions.at("EXT_meshopt_compression").json.empty());
+	}
+
+	void testBorrowedRawJson()
+	{
+		lg::BorrowedGltf const gltf = lg::loadGltfBorrowed(json);
+
+		// Raw JSON is a slice of the input rather than a copy
+		std::string_view const extras = gltf.nodes[0].extras->json;
+		LG_CHECK(extras.data() >= json.data() && extras.data() + extras.size() <= json.data() + json.size());
+		LG_CHECK(extras == lg::loadGltf(document).nodes[0].extras->json);
+	}
+
+	void testParseJson()
+	{
+		lg::Gltf const gltf = lg::loadGltf(document);
+
+		lg::JsonValue const extras = lg::parseJson(gltf.nodes[0].extras->json);
+		lg::JsonValue const* tag = extras.find("tag");
+		LG_CHECK(tag != nullptr && std::get<std::string>(tag->value) == "a");
+		auto const& values = std::get<lg::JsonValue::Array>(extras.find("values")->value);
+		LG_CHECK(values.size() == 4);
+		LG_CHECK(std::get<double>(values[0].value) == 1.0);
+		LG_CHECK(std::get<double>(values[1].value) == 2.5);
+		LG_CHECK(std::get<bool>(values[2].value));
+		LG_CHECK(std::holds_alternative<std::nullptr_t>(values[3].value));
+		LG_CHECK(extras.find("missing") == nullptr);
+
+		LG_CHECK(std::get<double>(lg::parseJson(gltf.nodes[1].extras->json).value) == 42.0);
+		LG_CHECK(std::get<std::string>(lg::parseJson(gltf.nodes[2].extras->json).value) == "text");
+		LG_CHECK(lg::parseJson(gltf.nodes[2].extras->json).find("text") == nullptr);
+
+		// Members keep their document order, and find returns the last of duplicates
+		lg::JsonValue const root = lg::parseJson(gltf.extras->json);
+		LG_CHECK(std::get<lg::JsonValue::Object>(root.value).size() == 2);
+		LG_CHECK(std::get<double>(root.find("revision")->value) == 4.0);
+
+		LG_CHECK_THROWS(lg::parseJson("{\"unterminated\": "), std::runtime_error);
+	}
+
+	void testWriteRawJson()
+	{
+		lg::Gltf const gltf = lg::loadGltf(document);
+		lg::Gltf const reloaded = lg::loadGltf(lg::writeGltf(gltf));
+
+		LG_CHECK(reloaded.nodes[0].extras->json == gltf.nodes[0].extras->json);
+		LG_CHECK(reloaded.nodes[0].extensions.at("EXT_unknown").json == gltf.nodes[0].extensions.at("EXT_unknown").json);
+		LG_CHECK(reloaded.nodes[1].extras->json == "42");
+	}
+}
+
+int main()
+{
+	testRawJson();
+	testBorrowedRawJson();
+	testParseJson();
+	testWriteRawJson();
+}
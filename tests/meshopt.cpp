@@ -0,0 +1,142 @@
+// SPDX-License-Identifier: MIT
+// Copyright © 2022 Sebastian Larsson
+
+#include <load-gltf/load-gltf.hpp>
+
+#include "check.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+	/// 20 vertices of 4 bytes, {i, 3 * i, 200 - 5 * i, 7}, compressed in ATTRIBUTES mode
+	constexpr std::array<std::uint8_t, 77> encodedVertices = {
+		0xa0, 0x05, 0x2a, 0xaa, 0xaa, 0xaa, 0xaa, 0x00, 0x00, 0x00, 0x06, 0x06, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66,
+		0x66, 0xff, 0x00, 0x00, 0x00, 0x06, 0x06, 0x06, 0x06, 0x06, 0x09, 0x99, 0x99, 0x99, 0x99, 0x99, 0x99, 0x99,
+		0xff, 0x00, 0x00, 0x00, 0x09, 0x09, 0x09, 0x09, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0x00, 0x00, 0x00, 0xc8, 0x07,
+	};
+
+	/// Indices {0, 1, 2, 2, 1, 3, 4, 5, 6, 19, 0, 7}, compressed in INDICES mode
+	constexpr std::array<std::uint8_t, 17> encodedIndices = {
+		0xd1, 0x00, 0x04, 0x09, 0x01, 0x00, 0x08, 0x04, 0x0d, 0x05, 0x35, 0x0e, 0x2f, 0x00, 0x00, 0x00, 0x00,
+	};
+
+	/// 26 triangles compressed in TRIANGLES mode by a port of meshopt_encodeIndexBuffer, version 1. The triangles
+	/// exercise every code: edge and vertex FIFO references, new and free vertices, last index plus one, and a
+	/// restart of the vertex numbering.
+	constexpr std::array<std::uint8_t, 62> encodedTriangles = {
+		0xe1, 0xf0, 0x00, 0xfe, 0x13, 0xfe, 0x12, 0xb0, 0x00, 0xa0, 0x02, 0x90, 0x01, 0x90, 0x00, 0x90, 0x02, 0x90,
+		0x01, 0xff, 0x1e, 0x0e, 0xff, 0xfe, 0x10, 0x1f, 0xff, 0x03, 0x02, 0xff, 0x28, 0x02, 0x02, 0xff, 0xa0, 0x0f,
+		0x9f, 0x06, 0xa5, 0x09, 0x00, 0x04, 0xff, 0x2e, 0x01, 0x01, 0x00, 0x76, 0x87, 0x56, 0x67, 0x78, 0xa9, 0x86,
+		0x65, 0x89, 0x68, 0x98, 0x01, 0x69, 0x00, 0x00,
+	};
+
+	/// The encoded triangles, each rotated the way the encoder rotates it
+	constexpr std::array<std::uint32_t, 78> decodedTriangles = {
+		0, 1, 2, 0, 2, 3, 4, 5, 1, 1, 5, 2, 6, 7, 4, 4, 7, 5, 3, 2, 8, 3, 8, 9, 2, 5, 10, 2, 10, 8, 5, 7, 11, 5, 11,
+		10, 9, 8, 12, 9, 12, 13, 8, 10, 14, 8, 14, 12, 10, 11, 15, 10, 15, 14, 20, 21, 22, 22, 21, 23, 22, 23, 24,
+		1000, 600, 5, 0, 1, 2, 2, 1, 3, 3, 1, 7, 30, 29, 28,
+	};
+
+	lg::BufferData asBufferData(std::span<std::uint8_t const> data)
+	{
+		return std::as_bytes(data);
+	}
+
+	std::vector<std::uint8_t> expectedVertices()
+	{
+		std::vector<std::uint8_t> result;
+		for (std::uint32_t i = 0; i < 20; ++i)
+		{
+			result.insert(result.end(), {static_cast<std::uint8_t>(i), static_cast<std::uint8_t>(3 * i),
+				static_cast<std::uint8_t>(200 - 5 * i), 7});
+		}
+		return result;
+	}
+
+	void testAttributes()
+	{
+		std::vector<std::uint8_t> decoded(20 * 4);
+		lg::decodeMeshopt(std::as_writable_bytes(std::span(decoded)), 20, 4, "ATTRIBUTES", "NONE",
+			asBufferData(encodedVertices));
+		LG_CHECK(decoded == expectedVertices());
+
+		LG_CHECK_THROWS(lg::decodeMeshopt(std::as_writable_bytes(std::span(decoded)), 20, 4, "ATTRIBUTES", "NONE",
+			asBufferData(std::span(encodedVertices).first(40))), std::invalid_argument);
+		LG_CHECK_THROWS(lg::decodeMeshopt(std::as_writable_bytes(std::span(decoded).first(79)), 20, 4, "ATTRIBUTES",
+			"NONE", asBufferData(encodedVertices)), std::out_of_range);
+	}
+
+	void testIndices()
+	{
+		std::vector<std::uint32_t> decoded(12);
+		lg::decodeMeshopt(std::as_writable_bytes(std::span(decoded)), 12, 4, "INDICES", "NONE",
+			asBufferData(encodedIndices));
+		LG_CHECK((decoded == std::vector<std::uint32_t>{0, 1, 2, 2, 1, 3, 4, 5, 6, 19, 0, 7}));
+	}
+
+	void testTriangles()
+	{
+		std::vector<std::uint32_t> decoded(decodedTriangles.size());
+		lg::decodeMeshopt(std::as_writable_bytes(std::span(decoded)), decoded.size(), 4, "TRIANGLES", "NONE",
+			asBufferData(encodedTriangles));
+		LG_CHECK(std::equal(decoded.begin(), decoded.end(), decodedTriangles.begin()));
+
+		std::vector<std::uint16_t> decoded16(decodedTriangles.size());
+		lg::decodeMeshopt(std::as_writable_bytes(std::span(decoded16)), decoded16.size(), 2, "TRIANGLES", "NONE",
+			asBufferData(encodedTriangles));
+		LG_CHECK(std::equal(decoded16.begin(), decoded16.end(), decodedTriangles.begin()));
+
+		LG_CHECK_THROWS(lg::decodeMeshopt(std::as_writable_bytes(std::span(decoded)), decoded.size(), 4, "TRIANGLES",
+			"NONE", asBufferData(std::span(encodedTriangles).first(50))), std::invalid_argument);
+	}
+
+	void testTriangleTableReference15()
+	{
+		// Six triangles of new vertices fill the vertex FIFO, then a table code of 0xf0 refers to the FIFO entry 15
+		// back, which holds vertex 3, rather than to a free index
+		std::vector<std::uint8_t> encoded = {0xe1, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf1, 0x00, 0xf0};
+		encoded.resize(encoded.size() + 14);
+		std::vector<std::uint32_t> decoded(21);
+		lg::decodeMeshopt(std::as_writable_bytes(std::span(decoded)), decoded.size(), 4, "TRIANGLES", "NONE",
+			asBufferData(encoded));
+		for (std::uint32_t i = 0; i < 18; ++i)
+		{
+			LG_CHECK(decoded[i] == i);
+		}
+		LG_CHECK(decoded[18] == 18);
+		LG_CHECK(decoded[19] == 3);
+		LG_CHECK(decoded[20] == 19);
+	}
+
+	void testBufferView()
+	{
+		lg::Gltf const gltf = lg::loadGltf(R"({
+			"asset": {"version": "2.0"},
+			"buffers": [{"byteLength": 77}, {"byteLength": 80}],
+			"bufferViews": [{"buffer": 1, "byteLength": 80, "byteStride": 4, "extensions": {
+				"EXT_meshopt_compression": {"buffer": 0, "byteLength": 77, "byteStride": 4, "count": 20,
+					"mode": "ATTRIBUTES"}}}]
+		})");
+		std::array<lg::BufferData, 2> const buffers = {asBufferData(encodedVertices), {}};
+		std::vector<std::byte> const decoded = lg::decodeMeshoptBufferView(gltf, buffers, 0);
+		std::vector<std::uint8_t> const expected = expectedVertices();
+		LG_CHECK(decoded.size() == expected.size());
+		LG_CHECK(std::equal(decoded.begin(), decoded.end(), std::as_bytes(std::span(expected)).begin()));
+	}
+}
+
+int main()
+{
+	testAttributes();
+	testIndices();
+	testTriangles();
+	testTriangleTableReference15();
+	testBufferView();
+}
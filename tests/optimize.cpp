@@ -0,0 +1,154 @@
+// SPDX-License-Identifier: MIT
+// Copyright © 2022 Sebastian Larsson
+
+#include <load-gltf/load-gltf.hpp>
+
+#include "check.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+	constexpr std::uint32_t gridSize = 32;
+	constexpr std::uint32_t gridVertexCount = (gridSize + 1) * (gridSize + 1);
+
+	/**
+	 * Triangle list of a grid of gridSize by gridSize quads, with its triangles in a scrambled order
+	 */
+	std::vector<std::uint32_t> scrambledGrid()
+	{
+		std::vector<std::array<std::uint32_t, 3>> triangles;
+		for (std::uint32_t y = 0; y < gridSize; ++y)
+		{
+			for (std::uint32_t x = 0; x < gridSize; ++x)
+			{
+				std::uint32_t const corner = y * (gridSize + 1) + x;
+				triangles.push_back({corner, corner + 1, corner + gridSize + 1});
+				triangles.push_back({corner + 1, corner + gridSize + 2, corner + gridSize + 1});
+			}
+		}
+		// Multiplying by a number coprime to the triangle count permutes the triangles
+		std::vector<std::uint32_t> indices;
+		for (std::size_t i = 0; i < triangles.size(); ++i)
+		{
+			auto const& triangle = triangles[i * 977 % triangles.size()];
+			indices.insert(indices.end(), triangle.begin(), triangle.end());
+		}
+		return indices;
+	}
+
+	/**
+	 * Triangles of a triangle list, each rotated to start at its smallest index so that winding is preserved, sorted
+	 */
+	std::vector<std::array<std::uint32_t, 3>> canonicalTriangles(std::span<std::uint32_t const> indices)
+	{
+		std::vector<std::array<std::uint32_t, 3>> triangles;
+		for (std::size_t i = 0; i + 2 < indices.size(); i += 3)
+		{
+			std::array<std::uint32_t, 3> triangle = {indices[i], indices[i + 1], indices[i + 2]};
+			std::rotate(triangle.begin(), std::min_element(triangle.begin(), triangle.end()), triangle.end());
+			triangles.push_back(triangle);
+		}
+		std::sort(triangles.begin(), triangles.end());
+		return triangles;
+	}
+
+	void testAcmr()
+	{
+		std::vector<std::uint32_t> const triangle = {0, 1, 2};
+		LG_CHECK(lg::computeAcmr(triangle, 3, 16) == 3.0);
+		std::vector<std::uint32_t> const repeated = {0, 1, 2, 2, 1, 0};
+		LG_CHECK(lg::computeAcmr(repeated, 3, 16) == 1.5);
+		// With a FIFO cache of three entries, vertex 3 evicts vertex 0, which then evicts 1, which evicts 2
+		std::vector<std::uint32_t> const evicting = {0, 1, 2, 1, 2, 3, 0, 1, 2};
+		LG_CHECK(lg::computeAcmr(evicting, 4, 3) == 7.0 / 3.0);
+	}
+
+	void testVertexCache()
+	{
+		std::vector<std::uint32_t> const indices = scrambledGrid();
+		std::vector<std::uint32_t> const optimized = lg::optimizeVertexCache(indices, gridVertexCount, 16);
+
+		LG_CHECK(canonicalTriangles(optimized) == canonicalTriangles(indices));
+		double const before = lg::computeAcmr(indices, gridVertexCount, 16);
+		double const after = lg::computeAcmr(optimized, gridVertexCount, 16);
+		LG_CHECK(before > 2.0);
+		// A grid can at best reach 0.5, Tipsify gets within a small factor of that
+		LG_CHECK(after < 0.8);
+
+		std::vector<std::uint32_t> outOfRange = indices;
+		outOfRange.back() = gridVertexCount;
+		LG_CHECK_THROWS(lg::optimizeVertexCache(outOfRange, gridVertexCount, 16), std::out_of_range);
+	}
+
+	void testVertexFetch()
+	{
+		std::vector<std::uint32_t> indices = {4, 2, 0, 0, 2, 5};
+		std::vector<std::uint32_t> const remap = lg::optimizeVertexFetch(indices, 6);
+
+		LG_CHECK((indices == std::vector<std::uint32_t>{0, 1, 2, 2, 1, 3}));
+		LG_CHECK((remap == std::vector<std::uint32_t>{2, lg::noIndex, 1, lg::noIndex, 0, 3}));
+	}
+
+	void testPrimitive()
+	{
+		std::vector<std::uint32_t> const indices = scrambledGrid();
+		std::vector<float> positions;
+		for (std::uint32_t i = 0; i < gridVertexCount; ++i)
+		{
+			positions.insert(positions.end(), {float(i % (gridSize + 1)), float(i / (gridSize + 1)), 0.0f});
+		}
+		std::uint32_t const indexBytes = static_cast<std::uint32_t>(indices.size() * sizeof(std::uint32_t));
+		std::uint32_t const positionBytes = static_cast<std::uint32_t>(positions.size() * sizeof(float));
+		std::string const json = R"({"asset": {"version": "2.0"},)"
+			R"("buffers": [{"byteLength": )" + std::to_string(indexBytes) + R"(}, {"byteLength": )"
+				+ std::to_string(positionBytes) + "}],"
+			R"("bufferViews": [{"buffer": 0, "byteLength": )" + std::to_string(indexBytes) + R"(},)"
+				R"({"buffer": 1, "byteLength": )" + std::to_string(positionBytes) + "}],"
+			R"("accessors": [{"bufferView": 0, "componentType": 5125, "type": "SCALAR", "count": )"
+				+ std::to_string(indices.size()) + R"(},)"
+				R"({"bufferView": 1, "componentType": 5126, "type": "VEC3", "count": )"
+				+ std::to_string(gridVertexCount) + "}],"
+			R"("meshes": [{"primitives": [{"attributes": {"POSITION": 1}, "indices": 0}]}]})";
+		lg::Gltf const gltf = lg::loadGltf(json);
+		std::array<lg::BufferData, 2> const buffers = {std::as_bytes(std::span(indices)),
+			std::as_bytes(std::span(positions))};
+
+		lg::OptimizedPrimitive const optimized = lg::optimizePrimitive(gltf, buffers, gltf.meshes[0].primitives[0]);
+		LG_CHECK(optimized.vertexCount == gridVertexCount);
+		LG_CHECK(optimized.indices.size() == indices.size());
+		LG_CHECK(optimized.acmrAfter < optimized.acmrBefore);
+		LG_CHECK(optimized.attributes.size() == 1);
+		LG_CHECK(optimized.attributes[0].name == "POSITION");
+		LG_CHECK(optimized.attributes[0].data.size() == positionBytes);
+
+		// The optimized triangles reference the same positions as the original ones
+		std::vector<float> optimizedPositions(positions.size());
+		std::memcpy(optimizedPositions.data(), optimized.attributes[0].data.data(), positionBytes);
+		auto const vertexIndex = [](std::vector<float> const& positions, std::uint32_t vertex)
+		{
+			return static_cast<std::uint32_t>(positions[3 * vertex] + positions[3 * vertex + 1] * (gridSize + 1));
+		};
+		std::vector<std::uint32_t> mapped;
+		for (std::uint32_t const index: optimized.indices)
+		{
+			mapped.push_back(vertexIndex(optimizedPositions, index));
+		}
+		LG_CHECK(canonicalTriangles(mapped) == canonicalTriangles(indices));
+	}
+}
+
+int main()
+{
+	testAcmr();
+	testVertexCache();
+	testVertexFetch();
+	testPrimitive();
+}
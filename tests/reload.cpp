@@ -0,0 +1,81 @@
+// SPDX-License-Identifier: MIT
+// Copyright © 2022 Sebastian Larsson
+
+#include <load-gltf/load-gltf.hpp>
+
+#include "check.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <exception>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+	constexpr std::string_view originalJson = R"({
+		"asset": {"version": "2.0"},
+		"scene": 0,
+		"scenes": [{"nodes": [0]}],
+		"nodes": [{"children": [1, 2]}, {"mesh": 0, "name": "a"}, {"mesh": 0, "name": "b"}],
+		"meshes": [{"primitives": [{"attributes": {"POSITION": 0}, "material": 0}]}],
+		"materials": [{"name": "red"}, {"name": "green"}],
+		"extras": {"revision": 1}
+	})";
+
+	/// The same document, with the second material and the last node changed, a node added and the extras removed
+	constexpr std::string_view changedJson = R"({
+		"asset": {"version": "2.0"},
+		"scene": 0,
+		"scenes": [{"nodes": [0]}],
+		"nodes": [{"children": [1, 2]}, {"mesh": 0, "name": "a"}, {"mesh": 0, "name": "c"}, {"name": "d"}],
+		"meshes": [{"primitives": [{"attributes": {"POSITION": 0}, "material": 0}]}],
+		"materials": [{"name": "red"}, {"name": "blue", "doubleSided": true}]
+	})";
+
+	void testChangeSet()
+	{
+		lg::Gltf gltf = lg::loadGltf(originalJson);
+		lg::DocumentHashes hashes = lg::hashGltf(originalJson);
+
+		lg::ChangeSet changes = lg::reload(gltf, hashes, changedJson);
+		std::sort(changes.properties.begin(), changes.properties.end());
+		LG_CHECK((changes.nodes == std::vector<std::uint32_t>{2, 3}));
+		LG_CHECK(changes.meshes.empty());
+		LG_CHECK((changes.materials == std::vector<std::uint32_t>{1}));
+		LG_CHECK((changes.properties == std::vector<std::string>{"extras", "materials", "nodes"}));
+
+		LG_CHECK(gltf.nodes.size() == 4);
+		LG_CHECK(gltf.nodes[2].name == "c");
+		LG_CHECK(gltf.nodes[3].name == "d");
+		LG_CHECK(gltf.materials[1].name == "blue");
+		LG_CHECK(gltf.materials[1].doubleSided);
+		LG_CHECK(!gltf.extras);
+
+		lg::ChangeSet const unchanged = lg::reload(gltf, hashes, changedJson);
+		LG_CHECK(unchanged.nodes.empty());
+		LG_CHECK(unchanged.materials.empty());
+		LG_CHECK(unchanged.properties.empty());
+	}
+
+	void testErrorLeavesDocumentUnchanged()
+	{
+		lg::Gltf gltf = lg::loadGltf(originalJson);
+		lg::DocumentHashes hashes = lg::hashGltf(originalJson);
+
+		std::string malformed(changedJson);
+		malformed.replace(malformed.find("\"blue\""), 6, "\"blue\" x");
+		LG_CHECK_THROWS(lg::reload(gltf, hashes, malformed), std::exception);
+		LG_CHECK(gltf.materials[1].name == "green");
+		LG_CHECK(gltf.nodes.size() == 3);
+
+		lg::ChangeSet const changes = lg::reload(gltf, hashes, changedJson);
+		LG_CHECK((changes.materials == std::vector<std::uint32_t>{1}));
+	}
+}
+
+int main()
+{
+	testChangeSet();
+	testErrorLeavesDocumentUnchanged();
+}
@@ -0,0 +1,195 @@
+// SPDX-License-Identifier: MIT
+// Copyright © 2022 Sebastian Larsson
+
+#include <load-gltf/load-gltf.hpp>
+
+#include "check.hpp"
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace {
+	constexpr std::string_view document = R"({
+		"asset": {"version": "2.0"},
+		"nodes": [
+			{"name": "root", "children": [1, 2], "translation": [1, 2, 3], "rotation": [0, 0.7071068, 0, 0.7071068],
+				"scale": [2, 2, 2], "extras": {"tag": 1}},
+			{"matrix": [2, 0, 0, 0, 0, 2, 0, 0, 0, 0, 2, 0, 4, 5, 6, 1], "mesh": 0, "skin": 0,
+				"weights": [0.25, 0.75], "extensions": {"EXT_example": {"value": true}}},
+			{"camera": 0, "children": [3]},
+			{"name": "leaf", "extras": [1, 2], "extensions": {"EXT_a": {}, "EXT_b": {"b": 2}}}
+		],
+		"accessors": [
+			{"bufferView": 0, "byteOffset": 4, "componentType": 5126, "count": 3, "type": "VEC3",
+				"max": [1, 2, 3], "min": [-1, -2, -3], "name": "positions"},
+			{"componentType": 5123, "normalized": true, "count": 8, "type": "VEC2", "extras": "note",
+				"sparse": {"count": 2, "indices": {"bufferView": 1, "componentType": 5125},
+					"values": {"bufferView": 2, "byteOffset": 8}, "extras": {"sparse": 1}}},
+			{"bufferView": 3, "componentType": 5121, "count": 1, "type": "SCALAR", "max": [255], "min": [0],
+				"extensions": {"EXT_example": {}}}
+		]
+	})";
+
+	std::string const padded = std::string(document) + std::string(lg::paddingSize, ' ');
+	std::string_view const json(padded.data(), document.size());
+
+	template<typename Storage>
+	void checkNodes(lg::BasicSoANodes<Storage> const& nodes, lg::BasicGltf<Storage> const& gltf)
+	{
+		using SoANodes = lg::BasicSoANodes<Storage>;
+
+		LG_CHECK(nodes.flags.size() == gltf.nodes.size());
+		LG_CHECK(nodes.childOffsets.size() == gltf.nodes.size() + 1);
+		LG_CHECK(nodes.weightOffsets.size() == gltf.nodes.size() + 1);
+		std::size_t extended = 0;
+		for (std::size_t i = 0; i < gltf.nodes.size(); ++i)
+		{
+			auto const& node = gltf.nodes[i];
+			LG_CHECK(nodes.translations[i] == node.translation);
+			LG_CHECK(nodes.rotations[i] == node.rotation);
+			LG_CHECK(nodes.scales[i] == node.scale);
+			LG_CHECK(nodes.matrices[i] == node.matrix);
+			LG_CHECK(nodes.meshes[i] == node.mesh.value_or(lg::noIndex));
+			LG_CHECK(nodes.skins[i] == node.skin.value_or(lg::noIndex));
+			LG_CHECK(nodes.cameras[i] == node.camera.value_or(lg::noIndex));
+			LG_CHECK(((nodes.flags[i] & SoANodes::hasMesh) != 0) == node.mesh.has_value());
+			LG_CHECK(((nodes.flags[i] & SoANodes::hasSkin) != 0) == node.skin.has_value());
+			LG_CHECK(((nodes.flags[i] & SoANodes::hasCamera) != 0) == node.camera.has_value());
+			LG_CHECK(nodes.names[i] == node.name);
+
+			LG_CHECK(nodes.childOffsets[i + 1] - nodes.childOffsets[i] == node.children.size());
+			for (std::size_t j = 0; j < node.children.size(); ++j)
+			{
+				LG_CHECK(nodes.children[nodes.childOffsets[i] + j] == node.children[j]);
+			}
+			LG_CHECK(nodes.weightOffsets[i + 1] - nodes.weightOffsets[i] == node.weights.size());
+			for (std::size_t j = 0; j < node.weights.size(); ++j)
+			{
+				LG_CHECK(nodes.weights[nodes.weightOffsets[i] + j] == node.weights[j]);
+			}
+
+			if (node.extensions.empty() && !node.extras)
+			{
+				continue;
+			}
+			LG_CHECK(extended < nodes.extendedNodes.size());
+			LG_CHECK(nodes.extendedNodes[extended] == i);
+			LG_CHECK(nodes.extensions[extended].size() == node.extensions.size());
+			for (auto const& [name, extension]: node.extensions)
+			{
+				LG_CHECK(nodes.extensions[extended].at(name).json == extension.json);
+			}
+			LG_CHECK(nodes.extras[extended].has_value() == node.extras.has_value());
+			LG_CHECK(!node.extras || nodes.extras[extended]->json == node.extras->json);
+			++extended;
+		}
+		LG_CHECK(extended == nodes.extendedNodes.size());
+		LG_CHECK(nodes.extensions.size() == extended);
+		LG_CHECK(nodes.extras.size() == extended);
+	}
+
+	template<typename Storage>
+	void checkAccessors(lg::BasicSoAAccessors<Storage> const& accessors, lg::BasicGltf<Storage> const& gltf)
+	{
+		using SoAAccessors = lg::BasicSoAAccessors<Storage>;
+
+		LG_CHECK(accessors.flags.size() == gltf.accessors.size());
+		std::size_t sparse = 0;
+		std::size_t extended = 0;
+		for (std::size_t i = 0; i < gltf.accessors.size(); ++i)
+		{
+			auto const& accessor = gltf.accessors[i];
+			LG_CHECK(accessors.bufferViews[i] == accessor.bufferView.value_or(lg::noIndex));
+			LG_CHECK(((accessors.flags[i] & SoAAccessors::hasBufferView) != 0) == accessor.bufferView.has_value());
+			LG_CHECK(((accessors.flags[i] & SoAAccessors::isNormalized) != 0) == accessor.normalized);
+			LG_CHECK(((accessors.flags[i] & SoAAccessors::isSparse) != 0) == accessor.sparse.has_value());
+			LG_CHECK(accessors.byteOffsets[i] == accessor.byteOffset);
+			LG_CHECK(accessors.componentTypes[i] == accessor.componentType);
+			LG_CHECK(accessors.counts[i] == accessor.count);
+			LG_CHECK(accessors.types[i] == accessor.type);
+			LG_CHECK(accessors.names[i] == accessor.name);
+
+			LG_CHECK(accessors.maxOffsets[i + 1] - accessors.maxOffsets[i] == accessor.max.size());
+			for (std::size_t j = 0; j < accessor.max.size(); ++j)
+			{
+				LG_CHECK(accessors.max[accessors.maxOffsets[i] + j] == accessor.max[j]);
+			}
+			LG_CHECK(accessors.minOffsets[i + 1] - accessors.minOffsets[i] == accessor.min.size());
+			for (std::size_t j = 0; j < accessor.min.size(); ++j)
+			{
+				LG_CHECK(accessors.min[accessors.minOffsets[i] + j] == accessor.min[j]);
+			}
+
+			if (accessor.sparse)
+			{
+				LG_CHECK(accessors.sparseAccessors[sparse] == i);
+				auto const& soaSparse = accessors.sparse[sparse];
+				LG_CHECK(soaSparse.count == accessor.sparse->count);
+				LG_CHECK(soaSparse.indices.bufferView == accessor.sparse->indices.bufferView);
+				LG_CHECK(soaSparse.indices.componentType == accessor.sparse->indices.componentType);
+				LG_CHECK(soaSparse.values.bufferView == accessor.sparse->values.bufferView);
+				LG_CHECK(soaSparse.values.byteOffset == accessor.sparse->values.byteOffset);
+				LG_CHECK(soaSparse.extras.has_value() && soaSparse.extras->json == accessor.sparse->extras->json);
+				++sparse;
+			}
+
+			if (accessor.extensions.empty() && !accessor.extras)
+			{
+				continue;
+			}
+			LG_CHECK(accessors.extendedAccessors[extended] == i);
+			LG_CHECK(accessors.extensions[extended].size() == accessor.extensions.size());
+			for (auto const& [name, extension]: accessor.extensions)
+			{
+				LG_CHECK(accessors.extensions[extended].at(name).json == extension.json);
+			}
+			LG_CHECK(accessors.extras[extended].has_value() == accessor.extras.has_value());
+			LG_CHECK(!accessor.extras || accessors.extras[extended]->json == accessor.extras->json);
+			++extended;
+		}
+		LG_CHECK(sparse == accessors.sparseAccessors.size());
+		LG_CHECK(extended == accessors.extendedAccessors.size());
+	}
+
+	void testMatchesArrayOfStructures()
+	{
+		lg::SoAScene const scene = lg::loadSoAScene(json);
+		lg::Gltf const gltf = lg::loadGltf(document);
+
+		LG_CHECK(scene.document.nodes.empty());
+		LG_CHECK(scene.document.accessors.empty());
+		checkNodes(scene.nodes, gltf);
+		checkAccessors(scene.accessors, gltf);
+		// Sanity check that the document exercises the sparse columns
+		LG_CHECK(scene.nodes.extendedNodes.size() == 3);
+		LG_CHECK(scene.accessors.extendedAccessors.size() == 2);
+		LG_CHECK(scene.accessors.sparseAccessors.size() == 1);
+	}
+
+	void testFloatMatchesArrayOfStructures()
+	{
+		lg::FloatSoAScene const scene = lg::loadSoASceneFloat(json);
+		lg::FloatGltf const gltf = lg::loadGltfFloat(document);
+
+		checkNodes(scene.nodes, gltf);
+		checkAccessors(scene.accessors, gltf);
+	}
+
+	void testMatrixFlag()
+	{
+		lg::SoAScene const scene = lg::loadSoAScene(json);
+
+		// The flag records whether the property is present, not whether the matrix differs from the identity
+		LG_CHECK((scene.nodes.flags[0] & lg::SoANodes::hasMatrix) == 0);
+		LG_CHECK((scene.nodes.flags[1] & lg::SoANodes::hasMatrix) != 0);
+		LG_CHECK(scene.nodes.matrices[1][12] == 4);
+	}
+}
+
+int main()
+{
+	testMatchesArrayOfStructures();
+	testFloatMatchesArrayOfStructures();
+	testMatrixFlag();
+}
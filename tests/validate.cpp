@@ -0,0 +1,125 @@
+// SPDX-License-Identifier: MIT
+// Copyright © 2022 Sebastian Larsson
+
+#include <load-gltf/load-gltf.hpp>
+
+#include "check.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+	bool hasError(std::vector<lg::ValidationError> const& errors, std::string_view path)
+	{
+		return std::any_of(errors.begin(), errors.end(), [path](lg::ValidationError const& error)
+		{
+			return error.path == path;
+		});
+	}
+
+	void testInvalidDocument()
+	{
+		lg::Gltf const gltf = lg::loadGltf(R"({
+			"asset": {"version": "2.0"},
+			"scene": 3,
+			"buffers": [{"byteLength": 100}],
+			"bufferViews": [{"buffer": 0, "byteOffset": 50, "byteLength": 60}, {"buffer": 1, "byteLength": 4}],
+			"accessors": [{"bufferView": 0, "count": 5, "type": "VEC3", "componentType": 5126}],
+			"meshes": [{"primitives": [{"attributes": {"POSITION": 7}, "material": 0,
+				"targets": [{"POSITION": 0}, {"NORMAL": 4}]}]}],
+			"nodes": [{"children": [1]}, {"children": [2]}, {"children": [1]}, {"children": [9]}],
+			"scenes": [{"nodes": [0, 3]}]
+		})");
+
+		for (bool parallel: {true, false})
+		{
+			lg::ValidationOptions options;
+			options.parallel = parallel;
+			std::vector<lg::ValidationError> const errors = lg::validate(gltf, options);
+			LG_CHECK(errors.size() == 8);
+			LG_CHECK(hasError(errors, "/scene"));
+			LG_CHECK(hasError(errors, "/bufferViews/0"));
+			LG_CHECK(hasError(errors, "/bufferViews/1/buffer"));
+			LG_CHECK(hasError(errors, "/meshes/0/primitives/0/attributes/POSITION"));
+			LG_CHECK(hasError(errors, "/meshes/0/primitives/0/material"));
+			LG_CHECK(hasError(errors, "/meshes/0/primitives/0/targets/1/NORMAL"));
+			LG_CHECK(hasError(errors, "/nodes/3/children/0"));
+			LG_CHECK(hasError(errors, "/nodes/2/children/0"));
+		}
+	}
+
+	void testEscapedPath()
+	{
+		lg::Gltf gltf;
+		gltf.meshes.resize(1);
+		gltf.meshes[0].primitives.resize(1);
+		gltf.meshes[0].primitives[0].attributes["A/B~C"] = 0;
+		std::vector<lg::ValidationError> const errors = lg::validate(gltf);
+		LG_CHECK(errors.size() == 1);
+		LG_CHECK(errors[0].path == "/meshes/0/primitives/0/attributes/A~1B~0C");
+	}
+
+	void testSparseIndexComponentType()
+	{
+		lg::Gltf const gltf = lg::loadGltf(R"({
+			"asset": {"version": "2.0"},
+			"buffers": [{"byteLength": 64}],
+			"bufferViews": [{"buffer": 0, "byteLength": 64}],
+			"accessors": [{"count": 4, "type": "SCALAR", "componentType": 5126,
+				"sparse": {"count": 2, "indices": {"bufferView": 0, "componentType": 5126},
+					"values": {"bufferView": 0}}}]
+		})");
+		std::vector<lg::ValidationError> const errors = lg::validate(gltf);
+		LG_CHECK(errors.size() == 1);
+		LG_CHECK(errors[0].path == "/accessors/0/sparse/indices/componentType");
+	}
+
+	void testLargeDocument()
+	{
+		// Large enough to be validated concurrently, which must report the same errors in the same order
+		lg::Gltf gltf;
+		gltf.nodes.resize(10000);
+		for (std::uint32_t i = 1; i < gltf.nodes.size(); ++i)
+		{
+			gltf.nodes[i - 1].children.push_back(i);
+		}
+		gltf.nodes.back().children.push_back(20000);
+		gltf.nodes.back().mesh = 0;
+
+		lg::ValidationOptions serial;
+		serial.parallel = false;
+		std::vector<lg::ValidationError> const expected = lg::validate(gltf, serial);
+		std::vector<lg::ValidationError> const errors = lg::validate(gltf);
+		LG_CHECK(expected.size() == 2);
+		LG_CHECK(errors.size() == expected.size());
+		for (std::size_t i = 0; i < errors.size(); ++i)
+		{
+			LG_CHECK(errors[i].path == expected[i].path);
+			LG_CHECK(errors[i].message == expected[i].message);
+		}
+	}
+
+	void testValidDocument()
+	{
+		lg::Gltf const gltf = lg::loadGltf(R"({
+			"asset": {"version": "2.0"},
+			"scene": 0,
+			"scenes": [{"nodes": [0]}],
+			"nodes": [{"children": [1, 2]}, {}, {}]
+		})");
+		LG_CHECK(lg::validate(gltf).empty());
+	}
+}
+
+int main()
+{
+	testInvalidDocument();
+	testEscapedPath();
+	testSparseIndexComponentType();
+	testLargeDocument();
+	testValidDocument();
+}
@@ -0,0 +1,160 @@
+// SPDX-License-Identifier: MIT
+// Copyright © 2022 Sebastian Larsson
+
+#include <load-gltf/load-gltf.hpp>
+
+#include "check.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+	/// Document using escaped strings, extras, unknown extensions, EXT_meshopt_compression, morph targets and
+	/// required fields that are zero
+	constexpr std::string_view documentJson = R"({
+		"asset": {"version": "2.0", "generator": "gen \"q\" \\ \n\t\u0001 ü", "minVersion": "2.0"},
+		"scene": 0,
+		"extensionsUsed": ["EXT_meshopt_compression", "KHR_x"],
+		"extensions": {"KHR_x": {"a": [1, 2, {"b": null}]}},
+		"extras": [1, "two"],
+		"accessors": [
+			{"bufferView": 0, "componentType": 5126, "count": 3, "type": "VEC3", "min": [0.1, -1e-7, 3],
+				"max": [1e21, 2.5, 3], "normalized": false, "byteOffset": 0},
+			{"componentType": 5123, "count": 2, "type": "SCALAR", "sparse": {"count": 1,
+				"indices": {"bufferView": 0, "componentType": 5125}, "values": {"bufferView": 0, "byteOffset": 4}}}
+		],
+		"animations": [{"channels": [{"sampler": 0, "target": {"node": 0, "path": "translation"}}],
+			"samplers": [{"input": 0, "output": 0, "interpolation": "STEP"}, {"input": 0, "output": 0}]}],
+		"buffers": [{"byteLength": 36}],
+		"bufferViews": [{"buffer": 0, "byteLength": 36, "byteStride": 12, "target": 34962, "extensions": {
+			"EXT_meshopt_compression": {"buffer": 0, "byteLength": 10, "byteStride": 12, "count": 3,
+				"mode": "ATTRIBUTES"},
+			"KHR_y": {}}}],
+		"cameras": [{"type": "perspective", "perspective": {"yfov": 0.7, "znear": 0.01}},
+			{"type": "orthographic", "orthographic": {"xmag": 0, "ymag": 0, "zfar": 0, "znear": 0}}],
+		"images": [{"uri": "a b.png"}],
+		"samplers": [{"wrapS": 33071}],
+		"textures": [{"source": 0, "sampler": 0}],
+		"materials": [{"name": "m", "pbrMetallicRoughness": {"baseColorTexture": {"index": 0}, "metallicFactor": 0},
+			"alphaMode": "MASK", "alphaCutoff": 0.5, "doubleSided": true,
+			"normalTexture": {"index": 0, "scale": 2}}, {}],
+		"meshes": [{"primitives": [{"attributes": {"POSITION": 0}, "mode": 4, "targets": [{"POSITION": 0}]}],
+			"weights": [0.5]}],
+		"nodes": [{"mesh": 0, "translation": [1, 0, 0], "scale": [1, 1, 1], "children": [1], "extras": {"k": 1}},
+			{"matrix": [1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 5, 0, 0, 1], "name": "n1"}],
+		"scenes": [{"nodes": [0]}],
+		"skins": [{"joints": [0, 1]}]
+	})";
+
+	std::uint32_t readUint32(std::vector<std::byte> const& data, std::size_t offset)
+	{
+		std::uint32_t value;
+		std::memcpy(&value, data.data() + offset, sizeof(value));
+		return value;
+	}
+
+	void testRoundTrip()
+	{
+		lg::Gltf const gltf = lg::loadGltf(documentJson);
+		std::string const json = lg::writeGltf(gltf);
+		lg::Gltf const reloaded = lg::loadGltf(json);
+		LG_CHECK(lg::writeGltf(reloaded) == json);
+
+		// Spec defaults are left out, while required fields and non-default values that are zero are kept
+		for (std::string_view const omitted: {R"("scale":[)", R"("normalized")", R"("byteOffset":0)", R"("wrapT")",
+			R"("magFilter")", R"("mode":4)", R"("interpolation":"LINEAR")", R"("alphaMode":"OPAQUE")"})
+		{
+			LG_CHECK(json.find(omitted) == std::string::npos);
+		}
+		for (std::string_view const kept: {R"("sampler":0)", R"("source":0)", R"("index":0)", R"("buffer":0)",
+			R"("xmag":0)", R"("metallicFactor":0)", R"("wrapS":33071)", R"("interpolation":"STEP")"})
+		{
+			LG_CHECK(json.find(kept) != std::string::npos);
+		}
+
+		LG_CHECK(reloaded.asset.generator == gltf.asset.generator);
+		LG_CHECK(reloaded.accessors[0].max[0] == 1e21);
+		LG_CHECK(reloaded.accessors[0].min[1] == -1e-7);
+		LG_CHECK(reloaded.bufferViews[0].meshoptCompression->count == 3);
+		LG_CHECK(reloaded.bufferViews[0].extensions.contains("KHR_y"));
+		LG_CHECK(reloaded.cameras[1].orthographic->xmag == 0.0);
+		LG_CHECK(reloaded.animations[0].channels[0].sampler == 0);
+		LG_CHECK(reloaded.meshes[0].primitives[0].targets.size() == 1);
+		LG_CHECK(reloaded.nodes[1].matrix[12] == 5.0);
+		LG_CHECK(reloaded.nodes[0].extras->json == R"({"k": 1})");
+
+		std::string const padded = json + std::string(lg::paddingSize, ' ');
+		lg::BorrowedGltf const borrowed = lg::loadGltfBorrowed(std::string_view(padded.data(), json.size()));
+		LG_CHECK(lg::writeGltf(borrowed) == json);
+
+		std::string const floatJson = lg::writeGltf(lg::loadGltfFloat(json));
+		LG_CHECK(lg::writeGltf(lg::loadGltfFloat(floatJson)) == floatJson);
+	}
+
+	void testSink()
+	{
+		lg::Gltf const gltf = lg::loadGltf(documentJson);
+		std::string streamed;
+		lg::writeGltf(gltf, [&streamed](std::span<std::byte const> data)
+		{
+			streamed.append(reinterpret_cast<char const*>(data.data()), data.size());
+		});
+		LG_CHECK(streamed == lg::writeGltf(gltf));
+	}
+
+	void testGlb()
+	{
+		lg::Gltf gltf = lg::loadGltf(documentJson);
+		std::vector<std::byte> const binChunk(33, std::byte{7});
+		LG_CHECK_THROWS(lg::writeGlb(gltf, binChunk), std::invalid_argument);
+
+		// A first buffer without a URI must not be left without its binary chunk
+		LG_CHECK_THROWS(lg::writeGlb(gltf, {}), std::invalid_argument);
+		gltf.buffers[0].uri = "data.bin";
+		std::vector<std::byte> const jsonOnly = lg::writeGlb(gltf, {});
+		LG_CHECK(jsonOnly.size() == 20 + readUint32(jsonOnly, 12));
+		gltf.buffers[0].uri.reset();
+
+		gltf.buffers[0].byteLength = binChunk.size();
+		std::vector<std::byte> const glb = lg::writeGlb(gltf, binChunk);
+		std::uint32_t const jsonLength = readUint32(glb, 12);
+		LG_CHECK(readUint32(glb, 0) == 0x46546c67);
+		LG_CHECK(readUint32(glb, 4) == 2);
+		LG_CHECK(readUint32(glb, 8) == glb.size());
+		LG_CHECK(jsonLength % 4 == 0);
+		LG_CHECK(readUint32(glb, 16) == 0x4e4f534a);
+		LG_CHECK(readUint32(glb, 20 + jsonLength) == 36);
+		LG_CHECK(readUint32(glb, 24 + jsonLength) == 0x004e4942);
+		LG_CHECK(glb.size() == 20 + jsonLength + 8 + 36);
+		LG_CHECK(glb[28 + jsonLength + 32] == std::byte{7});
+		LG_CHECK(glb.back() == std::byte{0});
+
+		std::vector<std::byte> streamed;
+		lg::writeGlb(gltf, binChunk, [&streamed](std::span<std::byte const> data)
+		{
+			streamed.insert(streamed.end(), data.begin(), data.end());
+		});
+		LG_CHECK(streamed == glb);
+	}
+
+	void testNonFiniteNumber()
+	{
+		lg::Gltf gltf = lg::loadGltf(documentJson);
+		gltf.nodes[0].translation[0] = std::numeric_limits<double>::infinity();
+		LG_CHECK_THROWS(lg::writeGltf(gltf), std::invalid_argument);
+	}
+}
+
+int main()
+{
+	testRoundTrip();
+	testSink();
+	testGlb();
+	testNonFiniteNumber();
+}